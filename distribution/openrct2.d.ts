@@ -4077,6 +4077,11 @@ declare global {
          * The number of bytes sent for each category.
          */
         readonly bytesSent: number[];
+
+        /**
+         * The number of bytes waiting to be sent.
+         */
+        readonly bytesQueued: number;
     }
 
     type PermissionType =
@@ -4604,6 +4609,7 @@ declare global {
         enableChainLiftOnAllTrack: boolean;
         fastLiftHill: boolean;
         freezeWeather: boolean;
+        guestAStarPathfinding: boolean;
         ignoreResearchStatus: boolean;
         ignoreRideIntensity: boolean;
         neverendingMarketing: boolean;
@@ -10,16 +10,21 @@
 #include "DrawingEngineFactory.hpp"
 
 #include <SDL.h>
+#include <algorithm>
+#include <array>
 #include <cmath>
+#include <cstring>
 #include <memory>
 #include <openrct2/Diagnostic.h>
 #include <openrct2/Game.h>
 #include <openrct2/config/Config.h>
 #include <openrct2/core/Guard.hpp>
+#include <openrct2/drawing/Drawing.h>
 #include <openrct2/drawing/IDrawingEngine.h>
 #include <openrct2/drawing/LightFX.h>
 #include <openrct2/drawing/X8DrawingEngine.h>
 #include <openrct2/paint/Paint.h>
+#include <openrct2/scenes/intro/IntroScene.h>
 #include <openrct2/ui/UiContext.h>
 #include <vector>
 
@@ -32,6 +37,10 @@ class HardwareDisplayDrawingEngine final : public X8DrawingEngine
 private:
     constexpr static uint32_t kDirtyVisualTime = 40;
     constexpr static uint32_t kDirtyRegionAlpha = 100;
+    // Palette animations change a few dozen colours every tick, fades and flashes change most of them.
+    constexpr static size_t kMaxChangedPaletteIndices = 64;
+    constexpr static int32_t kColourTileWidth = 128;
+    constexpr static int32_t kColourTileHeight = 16;
 
     IUiContext& _uiContext;
     SDL_Window* _window = nullptr;
@@ -46,6 +55,21 @@ private:
 
     std::vector<uint32_t> _dirtyVisualsTime;
 
+    // Parts of the screen changed since the last present, used when only dirty regions are converted to the texture.
+    std::vector<SDL_Rect> _presentRects;
+    std::vector<uint32_t> _presentBuffer;
+    bool _presentAll = true;
+    // Colours changed since the last present, the pixels using them are converted again.
+    std::array<bool, 256> _changedPaletteIndices{};
+    size_t _numChangedPaletteIndices = 0;
+    // Colours used by each tile of the screen, valid only while every conversion has been recorded.
+    std::vector<std::array<bool, 256>> _tileColours;
+    int32_t _tileColumns = 0;
+    int32_t _tileRows = 0;
+    bool _tileColoursValid = false;
+    bool _windowsPainted = false;
+    bool _weatherDrawn = false;
+
     bool smoothNN = false;
 
 public:
@@ -172,6 +196,8 @@ public:
         uint32_t format;
         SDL_QueryTexture(_screenTexture, &format, nullptr, nullptr, nullptr);
         _screenTextureFormat = SDL_AllocFormat(format);
+        _presentAll = true;
+        _tileColoursValid = false;
 
         X8DrawingEngine::Resize(width, height);
     }
@@ -182,7 +208,20 @@ public:
         {
             for (int32_t i = 0; i < 256; i++)
             {
-                _paletteHWMapped[i] = SDL_MapRGB(_screenTextureFormat, palette[i].Red, palette[i].Green, palette[i].Blue);
+                const auto mapped = SDL_MapRGB(_screenTextureFormat, palette[i].Red, palette[i].Green, palette[i].Blue);
+                if (mapped != _paletteHWMapped[i])
+                {
+                    _paletteHWMapped[i] = mapped;
+                    if (!_changedPaletteIndices[i])
+                    {
+                        _changedPaletteIndices[i] = true;
+                        _numChangedPaletteIndices++;
+                    }
+                }
+            }
+            if (_numChangedPaletteIndices > kMaxChangedPaletteIndices)
+            {
+                _presentAll = true;
             }
 
             if (Config::Get().general.EnableLightFx)
@@ -197,11 +236,43 @@ public:
         }
     }
 
+    void Invalidate(int32_t left, int32_t top, int32_t right, int32_t bottom) override
+    {
+        X8DrawingEngine::Invalidate(left, top, right, bottom);
+
+        // Overlays such as the console and FPS counter are drawn over the windows and only invalidated afterwards.
+        if (_windowsPainted)
+        {
+            AddPresentRect(left, top, right, bottom);
+        }
+    }
+
     void BeginDraw() override
     {
+        // Restoring the pixels behind the weather changes the screen outside of the dirty regions.
+        _weatherDrawn = _weatherDrawer.HasPixels();
+        _windowsPainted = false;
         X8DrawingEngine::BeginDraw();
     }
 
+    void PaintWindows() override
+    {
+        X8DrawingEngine::PaintWindows();
+        _windowsPainted = true;
+    }
+
+    void PaintWeather() override
+    {
+        X8DrawingEngine::PaintWeather();
+        _weatherDrawn |= _weatherDrawer.HasPixels();
+    }
+
+    void CopyRect(int32_t x, int32_t y, int32_t width, int32_t height, int32_t dx, int32_t dy) override
+    {
+        X8DrawingEngine::CopyRect(x, y, width, height, dx, dy);
+        AddPresentRect(x, y, x + width, y + height);
+    }
+
     void EndDraw() override
     {
         X8DrawingEngine::EndDraw();
@@ -212,6 +283,8 @@ public:
 protected:
     void OnDrawDirtyBlock(int32_t left, int32_t top, int32_t right, int32_t bottom) override
     {
+        AddPresentRect(left, top, right, bottom);
+
         if (gShowDirtyVisuals)
         {
             const auto columns = ((right - left) + (_invalidationGrid.getBlockWidth() - 1)) / _invalidationGrid.getBlockWidth();
@@ -241,12 +314,45 @@ private:
                 LightFx::RenderToTexture(pixels, pitch, _bits, _width, _height, _paletteHWMapped, _lightPaletteHWMapped);
                 SDL_UnlockTexture(_screenTexture);
             }
+            _tileColoursValid = false;
         }
-        else
+        else if (!Config::Get().general.PresentDirtyRegionsOnly || _presentAll || _weatherDrawn || IntroIsPlaying())
         {
             CopyBitsToTexture(
                 _screenTexture, _bits, static_cast<int32_t>(_width), static_cast<int32_t>(_height), _paletteHWMapped);
+            _tileColoursValid = false;
         }
+        else
+        {
+            // The tile colours are only recorded once palette animation needs them after a run of full conversions,
+            // as weather and fades convert the whole screen every frame.
+            if (_numChangedPaletteIndices > 0 && !_tileColoursValid)
+            {
+                ResetTileColours();
+                UpdateTileColours({ 0, 0, static_cast<int32_t>(_width), static_cast<int32_t>(_height) });
+                _tileColoursValid = true;
+            }
+
+            // Only the drawn regions change the colours on screen, the palette changes recolour the same pixels.
+            const auto numDrawnRects = _presentRects.size();
+            if (_tileColoursValid)
+            {
+                AddPaletteChangeRects();
+            }
+            CopyDirtyRegionsToTexture();
+            if (_tileColoursValid)
+            {
+                for (size_t i = 0; i < numDrawnRects; i++)
+                {
+                    UpdateTileColours(_presentRects[i]);
+                }
+            }
+        }
+        _presentRects.clear();
+        _presentAll = false;
+        _changedPaletteIndices.fill(false);
+        _numChangedPaletteIndices = 0;
+
         if (smoothNN)
         {
             SDL_SetRenderTarget(_sdlRenderer, _scaledScreenTexture);
@@ -277,11 +383,7 @@ private:
             int32_t padding = pitch - (width * 4);
             if (pitch == width * 4)
             {
-                uint32_t* dst = static_cast<uint32_t*>(pixels);
-                for (int32_t i = width * height; i > 0; i--)
-                {
-                    *dst++ = palette[*src++];
-                }
+                PaletteToRgbaFn(src, static_cast<uint32_t*>(pixels), width * height, palette);
             }
             else
             {
@@ -316,6 +418,138 @@ private:
         }
     }
 
+    void CopyDirtyRegionsToTexture()
+    {
+        uint32_t format;
+        SDL_QueryTexture(_screenTexture, &format, nullptr, nullptr, nullptr);
+        if (SDL_BYTESPERPIXEL(format) != 4)
+        {
+            CopyBitsToTexture(
+                _screenTexture, _bits, static_cast<int32_t>(_width), static_cast<int32_t>(_height), _paletteHWMapped);
+            _tileColoursValid = false;
+            return;
+        }
+
+        for (const auto& rect : _presentRects)
+        {
+            _presentBuffer.resize(static_cast<size_t>(rect.w) * rect.h);
+            const uint8_t* src = _bits + rect.y * _pitch + rect.x;
+            uint32_t* dst = _presentBuffer.data();
+            for (int32_t y = 0; y < rect.h; y++)
+            {
+                PaletteToRgbaFn(src, dst, rect.w, _paletteHWMapped);
+                src += _pitch;
+                dst += rect.w;
+            }
+            SDL_UpdateTexture(_screenTexture, &rect, _presentBuffer.data(), rect.w * sizeof(uint32_t));
+        }
+    }
+
+    void ResetTileColours()
+    {
+        _tileColumns = (static_cast<int32_t>(_width) + kColourTileWidth - 1) / kColourTileWidth;
+        _tileRows = (static_cast<int32_t>(_height) + kColourTileHeight - 1) / kColourTileHeight;
+        _tileColours.assign(static_cast<size_t>(_tileColumns) * _tileRows, {});
+    }
+
+    // Records the colours used in the rectangle. Tiles only partly covered keep their previous colours as well, so a
+    // tile may list colours that are no longer on screen, which only costs converting it again when they change.
+    void UpdateTileColours(const SDL_Rect& rect)
+    {
+        const auto firstColumn = rect.x / kColourTileWidth;
+        const auto lastColumn = (rect.x + rect.w - 1) / kColourTileWidth;
+        const auto firstRow = rect.y / kColourTileHeight;
+        const auto lastRow = (rect.y + rect.h - 1) / kColourTileHeight;
+        for (int32_t row = firstRow; row <= lastRow; row++)
+        {
+            const auto top = std::max(rect.y, row * kColourTileHeight);
+            const auto bottom = std::min({ rect.y + rect.h, (row + 1) * kColourTileHeight, static_cast<int32_t>(_height) });
+            for (int32_t column = firstColumn; column <= lastColumn; column++)
+            {
+                const auto left = std::max(rect.x, column * kColourTileWidth);
+                const auto right = std::min(
+                    { rect.x + rect.w, (column + 1) * kColourTileWidth, static_cast<int32_t>(_width) });
+                auto& colours = _tileColours[row * _tileColumns + column];
+                if (left == column * kColourTileWidth && top == row * kColourTileHeight
+                    && right == std::min((column + 1) * kColourTileWidth, static_cast<int32_t>(_width))
+                    && bottom == std::min((row + 1) * kColourTileHeight, static_cast<int32_t>(_height)))
+                {
+                    colours.fill(false);
+                }
+                for (int32_t y = top; y < bottom; y++)
+                {
+                    const uint8_t* src = _bits + y * _pitch;
+                    for (int32_t x = left; x < right; x++)
+                    {
+                        colours[src[x]] = true;
+                    }
+                }
+            }
+        }
+    }
+
+    // Adds the tiles using colours that changed since the last present, joining neighbouring tiles in a row.
+    void AddPaletteChangeRects()
+    {
+        if (_numChangedPaletteIndices == 0)
+            return;
+
+        std::array<uint8_t, 256> changedIndices;
+        size_t numChangedIndices = 0;
+        for (int32_t i = 0; i < 256; i++)
+        {
+            if (_changedPaletteIndices[i])
+            {
+                changedIndices[numChangedIndices++] = static_cast<uint8_t>(i);
+            }
+        }
+
+        for (int32_t row = 0; row < _tileRows; row++)
+        {
+            int32_t runStart = -1;
+            for (int32_t column = 0; column <= _tileColumns; column++)
+            {
+                bool usesChangedColour = false;
+                if (column < _tileColumns)
+                {
+                    const auto& colours = _tileColours[row * _tileColumns + column];
+                    usesChangedColour = std::any_of(
+                        changedIndices.begin(), changedIndices.begin() + numChangedIndices,
+                        [&colours](uint8_t index) { return colours[index]; });
+                }
+                if (usesChangedColour && runStart == -1)
+                {
+                    runStart = column;
+                }
+                else if (!usesChangedColour && runStart != -1)
+                {
+                    AddPresentRect(
+                        runStart * kColourTileWidth, row * kColourTileHeight, column * kColourTileWidth,
+                        (row + 1) * kColourTileHeight);
+                    runStart = -1;
+                }
+            }
+        }
+    }
+
+    void AddPresentRect(int32_t left, int32_t top, int32_t right, int32_t bottom)
+    {
+        left = std::max(left, 0);
+        top = std::max(top, 0);
+        right = std::min(right, static_cast<int32_t>(_width));
+        bottom = std::min(bottom, static_cast<int32_t>(_height));
+        if (left >= right || top >= bottom)
+            return;
+
+        // Overlays are usually invalidated with the same rectangle every frame.
+        for (const auto& rect : _presentRects)
+        {
+            if (left >= rect.x && top >= rect.y && right <= rect.x + rect.w && bottom <= rect.y + rect.h)
+                return;
+        }
+        _presentRects.push_back({ left, top, right - left, bottom - top });
+    }
+
     uint32_t GetDirtyVisualTime(uint32_t x, uint32_t y)
     {
         uint32_t result = 0;
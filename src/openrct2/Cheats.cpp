@@ -57,6 +57,7 @@ void CheatsReset()
     gameState.cheats.makeAllDestructible = false;
     gameState.cheats.allowIncompleteRides = false;
     gameState.cheats.normalizeRideCrashes = false;
+    gameState.cheats.guestAStarPathfinding = false;
     gameState.cheats.selectedStaffSpeed = StaffSpeedCheat::None;
     gameState.cheats.forcedParkRating = kForcedParkRatingDisabled;
 }
@@ -120,6 +121,7 @@ void CheatsSerialise(DataSerialiser& ds)
         CheatEntrySerialise(ds, CheatType::SetStaffSpeed, gameState.cheats.selectedStaffSpeed, count);
         CheatEntrySerialise(ds, CheatType::IgnorePrice, gameState.cheats.ignorePrice, count);
         CheatEntrySerialise(ds, CheatType::SetForcedParkRating, gameState.cheats.forcedParkRating, count);
+        CheatEntrySerialise(ds, CheatType::GuestAStarPathfinding, gameState.cheats.guestAStarPathfinding, count);
 
         // Remember current position and update count.
         uint64_t endOffset = stream.GetPosition();
@@ -236,6 +238,9 @@ void CheatsSerialise(DataSerialiser& ds)
                 case CheatType::SetForcedParkRating:
                     ds << gameState.cheats.forcedParkRating;
                     break;
+                case CheatType::GuestAStarPathfinding:
+                    ds << gameState.cheats.guestAStarPathfinding;
+                    break;
                 default:
                     break;
             }
@@ -351,6 +356,8 @@ const char* CheatsGetName(CheatType cheatType)
             return "Normalize ride crashes";
         case CheatType::RemoveParkFences:
             return LanguageGetString(STR_CHEAT_REMOVE_PARK_FENCES);
+        case CheatType::GuestAStarPathfinding:
+            return LanguageGetString(STR_CHEAT_GUEST_ASTAR_PATHFINDING);
         default:
             return "Unknown Cheat";
     }
@@ -48,6 +48,7 @@ struct CheatsState
     bool makeAllDestructible;
     bool allowIncompleteRides;
     bool normalizeRideCrashes;
+    bool guestAStarPathfinding;
     StaffSpeedCheat selectedStaffSpeed;
     int32_t forcedParkRating;
 };
@@ -110,6 +111,7 @@ enum class CheatType : int32_t
     NormalizeRideCrashes,
     RemoveParkFences,
     IgnorePrice,
+    GuestAStarPathfinding,
     Count,
 };
 
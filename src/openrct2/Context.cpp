@@ -313,6 +313,10 @@ namespace OpenRCT2
             if (Initialise())
             {
                 Launch();
+                if (!gProfileTracePath.empty() && !Profiling::ExportChromeTrace(gProfileTracePath))
+                {
+                    LOG_ERROR("Unable to write profiler trace to %s", gProfileTracePath.c_str());
+                }
                 return EXIT_SUCCESS;
             }
             return EXIT_FAILURE;
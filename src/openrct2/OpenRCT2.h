@@ -48,6 +48,7 @@ extern bool gOpenRCT2NoGraphics;
 extern bool gOpenRCT2ShowChangelog;
 extern bool gOpenRCT2SilentBreakpad;
 extern u8string gSilentRecordingName;
+extern u8string gProfileTracePath;
 extern bool gSilentReplays;
 
 #ifndef DISABLE_NETWORK
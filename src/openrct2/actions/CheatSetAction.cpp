@@ -37,6 +37,7 @@
 #include "../world/Map.h"
 #include "../world/Park.h"
 #include "../world/Scenery.h"
+#include "../world/SurroundingsIndex.h"
 #include "../world/tile_element/PathElement.h"
 #include "../world/tile_element/SmallSceneryElement.h"
 #include "../world/tile_element/SurfaceElement.h"
@@ -276,6 +277,9 @@ GameActions::Result CheatSetAction::Execute() const
         case CheatType::NormalizeRideCrashes:
             gameState.cheats.normalizeRideCrashes = _param1 != 0;
             break;
+        case CheatType::GuestAStarPathfinding:
+            gameState.cheats.guestAStarPathfinding = _param1 != 0;
+            break;
         case CheatType::RemoveParkFences:
             RemoveParkFences();
             break;
@@ -360,6 +364,8 @@ ParametersRange CheatSetAction::GetParameterRange(CheatType cheatType) const
             [[fallthrough]];
         case CheatType::NormalizeRideCrashes:
             [[fallthrough]];
+        case CheatType::GuestAStarPathfinding:
+            [[fallthrough]];
         case CheatType::OpenClosePark:
             return { { 0, 1 }, { 0, 0 } };
         case CheatType::AddMoney:
@@ -499,6 +505,8 @@ void CheatSetAction::FixVandalism() const
         it.element->AsPath()->SetIsBroken(false);
     } while (TileElementIteratorNext(&it));
 
+    SurroundingsIndex::InvalidateAll();
+
     GfxInvalidateScreen();
 }
 
@@ -22,6 +22,7 @@
 #include "../world/Location.hpp"
 #include "../world/Park.h"
 #include "../world/Scenery.h"
+#include "../world/SurroundingsIndex.h"
 #include "../world/tile_element/PathElement.h"
 
 using namespace OpenRCT2;
@@ -195,6 +196,7 @@ GameActions::Result FootpathAdditionPlaceAction::Execute() const
     {
         pathElement->SetAdditionStatus(255);
     }
+    SurroundingsIndex::InvalidateTile(TileCoordsXY(_loc));
     MapInvalidateTileFull(_loc);
     return res;
 }
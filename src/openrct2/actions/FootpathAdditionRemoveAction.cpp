@@ -19,6 +19,7 @@
 #include "../world/Footpath.h"
 #include "../world/Location.hpp"
 #include "../world/Park.h"
+#include "../world/SurroundingsIndex.h"
 #include "../world/tile_element/PathElement.h"
 
 using namespace OpenRCT2;
@@ -110,6 +111,7 @@ GameActions::Result FootpathAdditionRemoveAction::Execute() const
     }
 
     pathElement->SetAddition(0);
+    SurroundingsIndex::InvalidateTile(TileCoordsXY(_loc));
     MapInvalidateTileFull(_loc);
 
     auto res = GameActions::Result();
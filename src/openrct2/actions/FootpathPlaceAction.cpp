@@ -26,6 +26,7 @@
 #include "../world/Park.h"
 #include "../world/QuarterTile.h"
 #include "../world/Scenery.h"
+#include "../world/SurroundingsIndex.h"
 #include "../world/TileElementsView.h"
 #include "../world/Wall.h"
 #include "../world/tile_element/EntranceElement.h"
@@ -276,6 +277,7 @@ GameActions::Result FootpathPlaceAction::ElementUpdateExecute(PathElement* pathE
                 pathElement->SetAddition(0);
             }
         }
+        SurroundingsIndex::InvalidateTile(TileCoordsXY(_loc));
     }
 
     RemoveIntersectingWalls(pathElement);
@@ -19,12 +19,14 @@
 #include "../entity/MoneyEffect.h"
 #include "../localisation/Formatter.h"
 #include "../network/Network.h"
+#include "../paint/PaintCache.h"
 #include "../platform/Platform.h"
 #include "../profiling/Profiling.h"
 #include "../scripting/Duktape.hpp"
 #include "../scripting/HookEngine.h"
 #include "../scripting/ScriptEngine.h"
 #include "../ui/WindowManager.h"
+#include "../world/FootpathGraph.h"
 #include "../world/Park.h"
 #include "../world/Scenery.h"
 
@@ -355,6 +357,13 @@ namespace OpenRCT2::GameActions
 
             // Execute the action, changing the game state
             result = action->Execute();
+            // Anything an action changes may show up in the paint of any tile.
+            PaintCache::InvalidateAll();
+            // Actions change path edges, banners and the like in place, so let the graph look for the tiles that changed.
+            if (result.Error == GameActions::Status::Ok && !(flags & GAME_COMMAND_FLAG_GHOST))
+            {
+                FootpathGraph::InvalidateUnknownTiles();
+            }
 #ifdef ENABLE_SCRIPTING
             if (result.Error == GameActions::Status::Ok)
             {
@@ -12,6 +12,7 @@
 #include "../Context.h"
 #include "../Diagnostic.h"
 #include "../windows/Intent.h"
+#include "../world/FootpathGraph.h"
 #include "../world/TileInspector.h"
 
 using namespace OpenRCT2;
@@ -250,6 +251,8 @@ GameActions::Result TileModifyAction::QueryExecute(bool isExecuting) const
     if (isExecuting)
     {
         MapInvalidateTileFull(_loc);
+        // Heights and directions can be changed in place, which the element setters do not see.
+        FootpathGraph::InvalidateTile(TileCoordsXY(_loc));
         auto intent = Intent(INTENT_ACTION_TILE_MODIFY);
         ContextBroadcastIntent(&intent);
     }
@@ -22,6 +22,7 @@
 #include "../world/Footpath.h"
 #include "../world/MapAnimation.h"
 #include "../world/QuarterTile.h"
+#include "../world/SurroundingsIndex.h"
 #include "../world/Wall.h"
 #include "../world/tile_element/PathElement.h"
 #include "../world/tile_element/Slope.h"
@@ -501,6 +502,7 @@ GameActions::Result TrackPlaceAction::Execute() const
             if (footpathElement != nullptr && footpathElement->HasAddition())
             {
                 footpathElement->SetAddition(0);
+                SurroundingsIndex::InvalidateTile(TileCoordsXY(mapLoc));
             }
         }
 
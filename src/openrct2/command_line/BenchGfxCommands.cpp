@@ -0,0 +1,377 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2025 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "../Context.h"
+#include "../Game.h"
+#include "../GameState.h"
+#include "../OpenRCT2.h"
+#include "../config/Config.h"
+#include "../core/Console.hpp"
+#include "../core/Json.hpp"
+#include "../core/Path.hpp"
+#include "../drawing/Drawing.h"
+#include "../drawing/NewDrawing.h"
+#include "../drawing/X8DrawingEngine.h"
+#include "../interface/Viewport.h"
+#include "../paint/PaintCache.h"
+#include "../profiling/Profiling.h"
+#include "../world/Map.h"
+#include "Benchmark.hpp"
+#include "CommandLine.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+using namespace OpenRCT2;
+using namespace OpenRCT2::Drawing;
+
+static int32_t _width = 1920;
+static int32_t _height = 1080;
+static int32_t _warmupFrames = 5;
+static u8string _outputPath;
+
+// clang-format off
+static constexpr CommandLineOptionDefinition kBenchGfxOptions[]
+{
+    { CMDLINE_TYPE_INTEGER, &_width,        kNAC, "width",  "width of the rendered viewports (default 1920)"                },
+    { CMDLINE_TYPE_INTEGER, &_height,       kNAC, "height", "height of the rendered viewports (default 1080)"               },
+    { CMDLINE_TYPE_INTEGER, &_warmupFrames, kNAC, "warmup", "number of frames to render before measuring each view (default 5)" },
+    { CMDLINE_TYPE_STRING,  &_outputPath,   kNAC, "output", "write the JSON report to this file instead of stdout"          },
+    kOptionTableEnd
+};
+
+static exitcode_t HandleBenchGfx(CommandLineArgEnumerator* argEnumerator);
+
+const CommandLineCommand CommandLine::kBenchGfxCommands[]
+{
+    // Main commands
+    DefineCommand("", "<file> [<frames>]", kBenchGfxOptions, HandleBenchGfx),
+    kCommandTableEnd
+};
+// clang-format on
+
+// The paint phases reported separately, these are called once per viewport column.
+static constexpr std::string_view kPaintPhases[] = {
+    "PaintSessionGenerate",
+    "PaintSessionArrange",
+    "PaintDrawStructs",
+};
+
+// How far the scrolling views move each frame, in screen pixels at the view's zoom level.
+static constexpr int32_t kScrollStep = 8;
+
+/**
+ * A view of the benchmark script. Scrolling views move along the x axis of the screen every frame, so every frame has
+ * to be painted from scratch rather than from the same view. Cached views retain their paint between frames like the
+ * viewports of windows do.
+ */
+struct BenchView
+{
+    uint8_t rotation;
+    ZoomLevel zoom;
+    bool scroll;
+    bool cached;
+};
+
+static std::vector<BenchView> GetBenchViews()
+{
+    std::vector<BenchView> views;
+    for (uint8_t rotation = 0; rotation < kNumOrthogonalDirections; rotation++)
+    {
+        for (auto zoom = ZoomLevel{ 0 }; zoom <= ZoomLevel::max(); zoom++)
+        {
+            views.push_back({ rotation, zoom, false, false });
+        }
+        views.push_back({ rotation, ZoomLevel{ 0 }, true, false });
+        views.push_back({ rotation, ZoomLevel{ 0 }, false, true });
+        views.push_back({ rotation, ZoomLevel{ 0 }, true, true });
+    }
+    return views;
+}
+
+static std::string GetViewName(const BenchView& view)
+{
+    return std::string(view.cached ? "cached-" : "") + (view.scroll ? "scroll" : "static") + "-r"
+        + std::to_string(view.rotation) + "-z" + std::to_string(static_cast<int8_t>(view.zoom));
+}
+
+static const Profiling::Function* FindProfiledFunction(std::string_view name)
+{
+    for (const auto* func : Profiling::GetData())
+    {
+        // Names are full prototypes, e.g. "void PaintDrawStructs(PaintSession&)".
+        std::string_view prototype = func->GetName();
+        auto pos = prototype.find(name);
+        if (pos == std::string_view::npos || pos == 0 || prototype.size() <= pos + name.size())
+            continue;
+        if (prototype[pos - 1] == ' ' && prototype[pos + name.size()] == '(')
+            return func;
+    }
+    return nullptr;
+}
+
+static json_t GetPhaseBreakdown(uint32_t frames)
+{
+    json_t phases = json_t::array();
+    for (auto name : kPaintPhases)
+    {
+        json_t phase;
+        phase["name"] = name;
+
+        const auto* func = FindProfiledFunction(name);
+        const auto totalUs = func != nullptr ? func->getTotalTime() : 0.0;
+        phase["calls"] = func != nullptr ? func->GetCallCount() : 0;
+        phase["totalUs"] = totalUs;
+        phase["meanPerFrameUs"] = frames > 0 ? totalUs / frames : 0.0;
+        phases.push_back(phase);
+    }
+    return phases;
+}
+
+static json_t GetCounters()
+{
+    json_t counters = json_t::object();
+    for (const auto* counter : Profiling::GetCounters())
+    {
+        counters[counter->GetName()] = counter->GetValue();
+    }
+    return counters;
+}
+
+static Viewport GetCentredViewport(const BenchView& view, const CoordsXYZ& centre)
+{
+    Viewport viewport{};
+    viewport.width = _width;
+    viewport.height = _height;
+    viewport.zoom = view.zoom;
+    viewport.rotation = view.rotation;
+
+    auto centre2d = Translate3DTo2DWithZ(view.rotation, centre);
+    viewport.viewPos = { centre2d.x - viewport.ViewWidth() / 2, centre2d.y - viewport.ViewHeight() / 2 };
+    return viewport;
+}
+
+static json_t BenchmarkView(
+    X8DrawingEngine& drawingEngine, RenderTarget& rt, const BenchView& view, const CoordsXYZ& centre, uint32_t frames)
+{
+    using Clock = std::chrono::high_resolution_clock;
+
+    // Ensure sprites appear regardless of rotation
+    ResetAllSpriteQuadrantPlacements();
+    // Cached views start from what their warmup frames retained only.
+    PaintCache::InvalidateAll();
+
+    const auto startViewport = GetCentredViewport(view, centre);
+    // Scrolling views pass the centre half way through, so they cover the same area as the static views.
+    const auto scrollStart = view.zoom.ApplyTo(kScrollStep) * static_cast<int32_t>(frames) / 2;
+
+    auto renderFrame = [&](uint32_t frame) {
+        auto viewport = startViewport;
+        if (view.scroll)
+        {
+            viewport.viewPos.x += view.zoom.ApplyTo(kScrollStep) * static_cast<int32_t>(frame) - scrollStart;
+        }
+
+        drawingEngine.BeginDraw();
+        ViewportRender(rt, &viewport, view.cached);
+        drawingEngine.EndDraw();
+    };
+
+    for (int32_t i = 0; i < _warmupFrames; i++)
+    {
+        renderFrame(0);
+    }
+
+    // Warmup frames are left out of the paint phase timings as well.
+    Profiling::Enable();
+
+    std::vector<double> frameTimesUs;
+    frameTimesUs.reserve(frames);
+    for (uint32_t i = 0; i < frames; i++)
+    {
+        const auto frameStart = Clock::now();
+        renderFrame(i);
+        frameTimesUs.push_back(std::chrono::duration<double, std::micro>(Clock::now() - frameStart).count());
+    }
+
+    Profiling::Disable();
+
+    std::sort(frameTimesUs.begin(), frameTimesUs.end());
+
+    double sumUs = 0.0;
+    for (auto sample : frameTimesUs)
+        sumUs += sample;
+
+    json_t result;
+    result["name"] = GetViewName(view);
+    result["rotation"] = view.rotation;
+    result["zoom"] = static_cast<int8_t>(view.zoom);
+    result["scroll"] = view.scroll;
+    result["cached"] = view.cached;
+    result["frames"] = frames;
+    result["framesPerSecond"] = sumUs > 0.0 ? frames / (sumUs / 1000000.0) : 0.0;
+    result["frameTimeUs"] = {
+        { "mean", frames > 0 ? sumUs / frames : 0.0 },
+        { "p50", CommandLine::GetPercentile(frameTimesUs, 0.50) },
+        { "p99", CommandLine::GetPercentile(frameTimesUs, 0.99) },
+        { "max", frameTimesUs.empty() ? 0.0 : frameTimesUs.back() },
+    };
+    return result;
+}
+
+/**
+ * Times converting the last rendered frame to 32 bit pixels the way the software display engines present it, with the
+ * plain loop and with the function picked for this CPU.
+ */
+static json_t BenchmarkPaletteExpansion(const std::vector<uint8_t>& pixels, uint32_t frames)
+{
+    using Clock = std::chrono::high_resolution_clock;
+
+    uint32_t palette[256];
+    for (size_t i = 0; i < std::size(palette); i++)
+    {
+        const auto& colour = gGamePalette[i];
+        palette[i] = (colour.Red << 16) | (colour.Green << 8) | colour.Blue;
+    }
+
+    std::vector<uint32_t> converted(pixels.size());
+    const auto count = static_cast<int32_t>(pixels.size());
+    auto measure = [&](auto&& convert) {
+        const auto start = Clock::now();
+        for (uint32_t i = 0; i < frames; i++)
+        {
+            convert(pixels.data(), converted.data(), count, palette);
+        }
+        return std::chrono::duration<double, std::micro>(Clock::now() - start).count() / frames;
+    };
+
+    const auto scalarUs = measure(PaletteToRgbaScalar);
+    const auto dispatchedUs = measure(PaletteToRgbaFn);
+
+    json_t result;
+    result["scalarUs"] = scalarUs;
+    result["dispatchedUs"] = dispatchedUs;
+    result["speedup"] = dispatchedUs > 0.0 ? scalarUs / dispatchedUs : 0.0;
+    return result;
+}
+
+static json_t BenchmarkPark(IContext& context, const u8string& path, uint32_t frames)
+{
+    using Clock = std::chrono::high_resolution_clock;
+
+    json_t result;
+    result["file"] = path;
+
+    if (!context.LoadParkFromFile(path))
+    {
+        result["error"] = "Unable to load park.";
+        return result;
+    }
+
+    gLegacyScene = LegacyScene::playing;
+
+    const auto& mapSize = getGameState().mapSize;
+    CoordsXY centreXY = { (mapSize.x / 2) * kCoordsXYStep + kCoordsXYHalfTile,
+                          (mapSize.y / 2) * kCoordsXYStep + kCoordsXYHalfTile };
+    const CoordsXYZ centre = { centreXY, TileElementHeight(centreXY) };
+
+    std::vector<uint8_t> pixels(static_cast<size_t>(_width) * _height);
+    RenderTarget rt;
+    rt.bits = pixels.data();
+    rt.width = _width;
+    rt.height = _height;
+
+    X8DrawingEngine drawingEngine(context.GetUiContext());
+    rt.DrawingEngine = &drawingEngine;
+
+    Profiling::ResetData();
+
+    uint32_t totalFrames = 0;
+    json_t views = json_t::array();
+    const auto startTime = Clock::now();
+    for (const auto& view : GetBenchViews())
+    {
+        views.push_back(BenchmarkView(drawingEngine, rt, view, centre, frames));
+        totalFrames += frames;
+    }
+    const auto totalSeconds = std::chrono::duration<double>(Clock::now() - startTime).count();
+
+    result["engine"] = "X8";
+    result["width"] = _width;
+    result["height"] = _height;
+    result["multithreaded"] = static_cast<bool>(Config::Get().general.MultiThreading);
+    result["frames"] = totalFrames;
+    result["totalSeconds"] = totalSeconds;
+    result["views"] = views;
+    result["phases"] = GetPhaseBreakdown(totalFrames);
+    result["counters"] = GetCounters();
+    result["paletteExpansion"] = BenchmarkPaletteExpansion(pixels, frames);
+    return result;
+}
+
+static exitcode_t HandleBenchGfx(CommandLineArgEnumerator* argEnumerator)
+{
+    const char* rawPath;
+    if (!argEnumerator->TryPopString(&rawPath))
+    {
+        Console::Error::WriteLine("Expected a park file.");
+        return EXITCODE_FAIL;
+    }
+    const auto parkPath = Path::GetAbsolute(rawPath);
+
+    uint32_t frames = 40;
+    const char* rawFrames;
+    if (argEnumerator->TryPopString(&rawFrames) && rawFrames[0] != '-')
+    {
+        frames = static_cast<uint32_t>(atol(rawFrames));
+        if (frames == 0)
+        {
+            Console::Error::WriteLine("Number of frames must be greater than zero.");
+            return EXITCODE_FAIL;
+        }
+    }
+
+    if (_width <= 0 || _height <= 0)
+    {
+        Console::Error::WriteLine("Width and height must be greater than zero.");
+        return EXITCODE_FAIL;
+    }
+
+    gOpenRCT2Headless = true;
+
+    std::unique_ptr<IContext> context(CreateContext());
+    if (!context->Initialise())
+    {
+        Console::Error::WriteLine("Context initialization failed.");
+        return EXITCODE_FAIL;
+    }
+
+    DrawingEngineInit();
+
+    auto report = BenchmarkPark(*context, parkPath, frames);
+    const bool failed = report.contains("error");
+
+    DrawingEngineDispose();
+
+    if (_outputPath.empty())
+    {
+        Console::WriteLine("%s", report.dump(4).c_str());
+    }
+    else
+    {
+        Json::WriteToFile(_outputPath, report);
+        Console::WriteLine("Benchmark report written to %s", _outputPath.c_str());
+    }
+
+    return failed ? EXITCODE_FAIL : EXITCODE_OK;
+}
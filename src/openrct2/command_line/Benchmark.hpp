@@ -0,0 +1,30 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2025 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace OpenRCT2::CommandLine
+{
+    /**
+     * Returns the sample nearest to the given percentile, from 0 to 1, of samples sorted in ascending order. Picking a
+     * sample rather than interpolating between two keeps the reported times ones that were actually measured.
+     */
+    inline double GetPercentile(const std::vector<double>& sortedSamples, double percentile)
+    {
+        if (sortedSamples.empty())
+            return 0.0;
+
+        auto index = static_cast<size_t>(percentile * static_cast<double>(sortedSamples.size() - 1) + 0.5);
+        return sortedSamples[std::min(index, sortedSamples.size() - 1)];
+    }
+} // namespace OpenRCT2::CommandLine
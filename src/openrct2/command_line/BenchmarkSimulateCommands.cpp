@@ -0,0 +1,226 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2025 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "../Context.h"
+#include "../Game.h"
+#include "../GameState.h"
+#include "../OpenRCT2.h"
+#include "../core/Console.hpp"
+#include "../core/Json.hpp"
+#include "../core/Path.hpp"
+#include "../core/String.hpp"
+#include "../entity/EntityList.h"
+#include "../entity/EntityRegistry.h"
+#include "../network/Network.h"
+#include "../profiling/Profiling.h"
+#include "Benchmark.hpp"
+#include "CommandLine.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+using namespace OpenRCT2;
+
+static int32_t _warmupTicks = 100;
+static u8string _outputPath;
+
+// clang-format off
+static constexpr CommandLineOptionDefinition kBenchmarkSimulateOptions[]
+{
+    { CMDLINE_TYPE_INTEGER, &_warmupTicks, kNAC, "warmup", "number of ticks to run before measuring (default 100)" },
+    { CMDLINE_TYPE_STRING,  &_outputPath,  kNAC, "output", "write the JSON report to this file instead of stdout" },
+    kOptionTableEnd
+};
+
+static exitcode_t HandleBenchmarkSimulate(CommandLineArgEnumerator* argEnumerator);
+
+const CommandLineCommand CommandLine::kBenchmarkSimulateCommands[]
+{
+    // Main commands
+    DefineCommand("", "<ticks> <file> [<file> ...]", kBenchmarkSimulateOptions, HandleBenchmarkSimulate),
+    kCommandTableEnd
+};
+// clang-format on
+
+/**
+ * Strips the return type and parameter list from a profiled function prototype,
+ * e.g. "void OpenRCT2::Park::Update(...)" becomes "OpenRCT2::Park::Update".
+ */
+static std::string GetPhaseName(const char* prototype)
+{
+    std::string_view name = prototype;
+    auto paramsStart = name.find('(');
+    if (paramsStart != std::string_view::npos)
+        name = name.substr(0, paramsStart);
+    auto nameStart = name.rfind(' ');
+    if (nameStart != std::string_view::npos)
+        name = name.substr(nameStart + 1);
+    return std::string(name);
+}
+
+static json_t GetPhaseBreakdown(uint32_t ticks)
+{
+    json_t phases = json_t::array();
+
+    const auto& functions = Profiling::GetData();
+    auto it = std::find_if(functions.begin(), functions.end(), [](const Profiling::Function* func) {
+        return GetPhaseName(func->GetName()) == "OpenRCT2::gameStateUpdateLogic";
+    });
+    if (it == functions.end())
+        return phases;
+
+    auto children = (*it)->GetChildren();
+    std::sort(children.begin(), children.end(), [](const Profiling::Function* a, const Profiling::Function* b) {
+        return a->getTotalTime() > b->getTotalTime();
+    });
+
+    for (const auto* func : children)
+    {
+        json_t phase;
+        phase["name"] = GetPhaseName(func->GetName());
+        phase["calls"] = func->GetCallCount();
+        phase["totalUs"] = func->getTotalTime();
+        phase["meanPerTickUs"] = ticks > 0 ? func->getTotalTime() / ticks : 0.0;
+        phase["maxUs"] = func->GetMaxTime();
+        phases.push_back(phase);
+    }
+    return phases;
+}
+
+static json_t BenchmarkPark(IContext& context, const u8string& path, uint32_t ticks, uint32_t warmupTicks)
+{
+    using Clock = std::chrono::high_resolution_clock;
+
+    json_t result;
+    result["file"] = path;
+
+    if (!context.LoadParkFromFile(path))
+    {
+        result["error"] = "Unable to load park.";
+        return result;
+    }
+
+    for (uint32_t i = 0; i < warmupTicks; i++)
+    {
+        gameStateUpdateLogic();
+    }
+
+    // Measure with the profiler enabled so the per-phase breakdown covers exactly the timed ticks.
+    Profiling::ResetData();
+    Profiling::Enable();
+
+    std::vector<double> tickTimesUs;
+    tickTimesUs.reserve(ticks);
+
+    const auto startTime = Clock::now();
+    for (uint32_t i = 0; i < ticks; i++)
+    {
+        const auto tickStart = Clock::now();
+        gameStateUpdateLogic();
+        const auto tickEnd = Clock::now();
+        tickTimesUs.push_back(std::chrono::duration<double, std::micro>(tickEnd - tickStart).count());
+    }
+    const auto totalSeconds = std::chrono::duration<double>(Clock::now() - startTime).count();
+
+    Profiling::Disable();
+
+    std::sort(tickTimesUs.begin(), tickTimesUs.end());
+
+    double sumUs = 0.0;
+    for (auto sample : tickTimesUs)
+        sumUs += sample;
+
+    result["guests"] = GetEntityListCount(EntityType::Guest);
+    result["staff"] = GetEntityListCount(EntityType::Staff);
+    result["vehicles"] = GetEntityListCount(EntityType::Vehicle);
+    result["warmupTicks"] = warmupTicks;
+    result["ticks"] = ticks;
+    result["totalSeconds"] = totalSeconds;
+    result["ticksPerSecond"] = totalSeconds > 0.0 ? ticks / totalSeconds : 0.0;
+    result["tickTimeUs"] = {
+        { "mean", ticks > 0 ? sumUs / ticks : 0.0 },
+        { "p50", CommandLine::GetPercentile(tickTimesUs, 0.50) },
+        { "p99", CommandLine::GetPercentile(tickTimesUs, 0.99) },
+        { "max", tickTimesUs.empty() ? 0.0 : tickTimesUs.back() },
+    };
+    result["phases"] = GetPhaseBreakdown(ticks);
+    result["checksum"] = GetAllEntitiesChecksum().ToString();
+    return result;
+}
+
+static exitcode_t HandleBenchmarkSimulate(CommandLineArgEnumerator* argEnumerator)
+{
+    const char* rawTicks;
+    if (!argEnumerator->TryPopString(&rawTicks))
+    {
+        Console::Error::WriteLine("Expected number of ticks to measure.");
+        return EXITCODE_FAIL;
+    }
+    const auto ticks = static_cast<uint32_t>(atol(rawTicks));
+    if (ticks == 0)
+    {
+        Console::Error::WriteLine("Number of ticks must be greater than zero.");
+        return EXITCODE_FAIL;
+    }
+
+    // Options are always passed at the end, so any leading arguments are park files.
+    std::vector<u8string> parkPaths;
+    const char* rawPath;
+    while (argEnumerator->TryPopString(&rawPath))
+    {
+        if (rawPath[0] == '-')
+            break;
+        parkPaths.push_back(Path::GetAbsolute(rawPath));
+    }
+    if (parkPaths.empty())
+    {
+        Console::Error::WriteLine("Expected at least one park file.");
+        return EXITCODE_FAIL;
+    }
+
+    gOpenRCT2Headless = true;
+
+#ifndef DISABLE_NETWORK
+    gNetworkStart = NETWORK_MODE_SERVER;
+#endif
+
+    std::unique_ptr<IContext> context(CreateContext());
+    if (!context->Initialise())
+    {
+        Console::Error::WriteLine("Context initialization failed.");
+        return EXITCODE_FAIL;
+    }
+
+    const auto warmupTicks = static_cast<uint32_t>(std::max(_warmupTicks, 0));
+
+    json_t report;
+    report["parks"] = json_t::array();
+    bool anyFailed = false;
+    for (const auto& path : parkPaths)
+    {
+        auto result = BenchmarkPark(*context, path, ticks, warmupTicks);
+        anyFailed |= result.contains("error");
+        report["parks"].push_back(std::move(result));
+    }
+
+    if (_outputPath.empty())
+    {
+        Console::WriteLine("%s", report.dump(4).c_str());
+    }
+    else
+    {
+        Json::WriteToFile(_outputPath, report);
+        Console::WriteLine("Benchmark report written to %s", _outputPath.c_str());
+    }
+
+    return anyFailed ? EXITCODE_FAIL : EXITCODE_OK;
+}
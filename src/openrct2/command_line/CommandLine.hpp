@@ -111,6 +111,8 @@ namespace OpenRCT2::CommandLine
     extern const CommandLineCommand kScreenshotCommands[];
     extern const CommandLineCommand kSpriteCommands[];
     extern const CommandLineCommand kSimulateCommands[];
+    extern const CommandLineCommand kBenchmarkSimulateCommands[];
+    extern const CommandLineCommand kBenchGfxCommands[];
     extern const CommandLineCommand kParkInfoCommands[];
 
     extern const CommandLineExample kRootExamples[];
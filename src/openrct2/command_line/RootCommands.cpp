@@ -24,6 +24,7 @@
 #include "../park/ParkFile.h"
 #include "../platform/Crash.h"
 #include "../platform/Platform.h"
+#include "../profiling/Profiling.h"
 #include "../scripting/ScriptEngine.h"
 #include "CommandLine.hpp"
 
@@ -63,6 +64,7 @@ static u8string _openrct2DataPath = {};
 static u8string _rct1DataPath = {};
 static u8string _rct2DataPath = {};
 static bool _silentBreakpad = false;
+static u8string _profileTracePath = {};
 
 // clang-format off
 static constexpr CommandLineOptionDefinition kStandardOptions[]
@@ -84,6 +86,7 @@ static constexpr CommandLineOptionDefinition kStandardOptions[]
     { CMDLINE_TYPE_STRING,  &_openrct2DataPath, kNAC, "openrct2-data-path", "path to the OpenRCT2 data directory (containing languages)" },
     { CMDLINE_TYPE_STRING,  &_rct1DataPath,     kNAC, "rct1-data-path",     "path to the RollerCoaster Tycoon 1 data directory (containing data/csg1.dat)" },
     { CMDLINE_TYPE_STRING,  &_rct2DataPath,     kNAC, "rct2-data-path",     "path to the RollerCoaster Tycoon 2 data directory (containing data/g1.dat)" },
+    { CMDLINE_TYPE_STRING,  &_profileTracePath, kNAC, "profile-trace",      "enable the profiler and write a Chrome trace to this file on exit" },
 #ifdef USE_BREAKPAD
     { CMDLINE_TYPE_SWITCH,  &_silentBreakpad,  kNAC, "silent-breakpad",   "make breakpad crash reporting silent"                       },
 #endif // USE_BREAKPAD
@@ -142,10 +145,12 @@ const CommandLineCommand CommandLine::kRootCommands[]
 #endif
 
     // Sub-commands
-    DefineSubCommand("screenshot",      CommandLine::kScreenshotCommands       ),
-    DefineSubCommand("sprite",          CommandLine::kSpriteCommands           ),
-    DefineSubCommand("simulate",        CommandLine::kSimulateCommands         ),
-    DefineSubCommand("parkinfo",        CommandLine::kParkInfoCommands         ),
+    DefineSubCommand("screenshot",         CommandLine::kScreenshotCommands        ),
+    DefineSubCommand("sprite",             CommandLine::kSpriteCommands            ),
+    DefineSubCommand("simulate",           CommandLine::kSimulateCommands          ),
+    DefineSubCommand("benchmark-simulate", CommandLine::kBenchmarkSimulateCommands ),
+    DefineSubCommand("benchgfx",           CommandLine::kBenchGfxCommands          ),
+    DefineSubCommand("parkinfo",           CommandLine::kParkInfoCommands          ),
     kCommandTableEnd
 };
 
@@ -231,6 +236,12 @@ exitcode_t CommandLine::HandleCommandDefault()
         gSilentReplays = _silentReplays;
     }
 
+    if (!_profileTracePath.empty())
+    {
+        gProfileTracePath = Path::GetAbsolute(_profileTracePath);
+        Profiling::Enable();
+    }
+
     return result;
 }
 
@@ -123,6 +123,11 @@ namespace OpenRCT2::Config
         ConfigEnumEntry<VirtualFloorStyles>("GLASSY", VirtualFloorStyles::Glassy),
     });
 
+    static const auto Enum_SendBacklogPolicy = ConfigEnum<SendBacklogPolicy>({
+        ConfigEnumEntry<SendBacklogPolicy>("DISCONNECT", SendBacklogPolicy::Disconnect),
+        ConfigEnumEntry<SendBacklogPolicy>("DROP_OPTIONAL", SendBacklogPolicy::DropOptional),
+    });
+
     /**
      * Config enum wrapping LanguagesDescriptors.
      */
@@ -211,6 +216,9 @@ namespace OpenRCT2::Config
             model->EnableLightFxForVehicles = supportsLightFx && reader->GetBoolean("enable_light_fx_for_vehicles", false);
             model->UpperCaseBanners = reader->GetBoolean("upper_case_banners", false);
             model->DisableLightningEffect = reader->GetBoolean("disable_lightning_effect", false);
+            model->BoundedPaintSort = reader->GetBoolean("bounded_paint_sort", false);
+            model->MinifiedSpriteCache = reader->GetBoolean("minified_sprite_cache", true);
+            model->PresentDirtyRegionsOnly = reader->GetBoolean("present_dirty_regions_only", false);
             model->WindowScale = reader->GetFloat("window_scale", Platform::GetDefaultScale());
             model->InferDisplayDPI = reader->GetBoolean("infer_display_dpi", true);
             model->ShowFPS = reader->GetBoolean("show_fps", false);
@@ -311,6 +319,9 @@ namespace OpenRCT2::Config
         writer->WriteBoolean("enable_light_fx_for_vehicles", model->EnableLightFxForVehicles);
         writer->WriteBoolean("upper_case_banners", model->UpperCaseBanners);
         writer->WriteBoolean("disable_lightning_effect", model->DisableLightningEffect);
+        writer->WriteBoolean("bounded_paint_sort", model->BoundedPaintSort);
+        writer->WriteBoolean("minified_sprite_cache", model->MinifiedSpriteCache);
+        writer->WriteBoolean("present_dirty_regions_only", model->PresentDirtyRegionsOnly);
         writer->WriteFloat("window_scale", model->WindowScale);
         writer->WriteBoolean("infer_display_dpi", model->InferDisplayDPI);
         writer->WriteBoolean("show_fps", model->ShowFPS);
@@ -483,6 +494,9 @@ namespace OpenRCT2::Config
             model->LogServerActions = reader->GetBoolean("log_server_actions", false);
             model->PauseServerIfNoClients = reader->GetBoolean("pause_server_if_no_clients", false);
             model->DesyncDebugging = reader->GetBoolean("desync_debugging", false);
+            model->SendBacklogLimit = reader->GetInt32("send_backlog_limit", 128);
+            model->SendBacklogPolicy = reader->GetEnum<SendBacklogPolicy>(
+                "send_backlog_policy", SendBacklogPolicy::Disconnect, Enum_SendBacklogPolicy);
         }
     }
 
@@ -510,6 +524,8 @@ namespace OpenRCT2::Config
         writer->WriteBoolean("log_server_actions", model->LogServerActions);
         writer->WriteBoolean("pause_server_if_no_clients", model->PauseServerIfNoClients);
         writer->WriteBoolean("desync_debugging", model->DesyncDebugging);
+        writer->WriteInt32("send_backlog_limit", model->SendBacklogLimit);
+        writer->WriteEnum<SendBacklogPolicy>("send_backlog_policy", model->SendBacklogPolicy, Enum_SendBacklogPolicy);
     }
 
     static void ReadNotifications(IIniReader* reader)
@@ -581,6 +597,7 @@ namespace OpenRCT2::Config
             model->HeightBig = reader->GetInt32("height_big", false);
             model->EnableHinting = reader->GetBoolean("enable_hinting", true);
             model->HintingThreshold = reader->GetInt32("hinting_threshold", false);
+            model->CacheSize = reader->GetInt32("cache_size", 1024);
         }
     }
 
@@ -602,6 +619,7 @@ namespace OpenRCT2::Config
         writer->WriteInt32("height_big", model->HeightBig);
         writer->WriteBoolean("enable_hinting", model->EnableHinting);
         writer->WriteInt32("hinting_threshold", model->HintingThreshold);
+        writer->WriteInt32("cache_size", model->CacheSize);
     }
 
     static void ReadPlugin(IIniReader* reader)
@@ -58,6 +58,9 @@ namespace OpenRCT2::Config
         bool DisableLightningEffect;
         bool ShowGuestPurchases;
         bool TransparentScreenshot;
+        bool BoundedPaintSort;
+        bool MinifiedSpriteCache;
+        bool PresentDirtyRegionsOnly;
         bool TransparentWater;
 
         bool InvisibleRides;
@@ -185,6 +188,8 @@ namespace OpenRCT2::Config
         bool LogServerActions;
         bool PauseServerIfNoClients;
         bool DesyncDebugging;
+        int32_t SendBacklogLimit; // MiB per client, 0 for no limit.
+        ::SendBacklogPolicy SendBacklogPolicy;
     };
 
     struct Notification
@@ -225,6 +230,7 @@ namespace OpenRCT2::Config
         int32_t HeightBig;
         bool EnableHinting;
         int32_t HintingThreshold;
+        int32_t CacheSize;
     };
 
     struct Plugin
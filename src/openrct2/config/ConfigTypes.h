@@ -57,3 +57,9 @@ enum class TitleMusicKind : int32_t
     RCT1,
     RCT2,
 };
+
+enum class SendBacklogPolicy : int32_t
+{
+    Disconnect,
+    DropOptional,
+};
@@ -7,16 +7,16 @@
  * OpenRCT2 is licensed under the GNU General Public License version 3.
  *****************************************************************************/
 
+#pragma once
+
+#include "TaskScheduler.h"
+
 #include <algorithm>
 #include <atomic>
-#include <condition_variable>
-#include <deque>
 #include <functional>
 #include <memory>
 #include <mutex>
 #include <optional>
-#include <stop_token>
-#include <thread>
 #include <type_traits>
 #include <vector>
 
@@ -174,34 +174,19 @@ namespace OpenRCT2
         };
 
     public:
-        BackgroundWorker()
-        {
-            const auto threadsAvailable = std::max(std::thread::hardware_concurrency(), 1u);
-
-            // NOTE: We don't want to use all available threads, this is for background work only.
-            // Adjust the number of threads if needed.
-            const auto numThreads = std::min(threadsAvailable, 2u);
-
-            for (auto i = 0u; i < numThreads; ++i)
-            {
-                _workThreads.emplace_back([this] { processJobs(); });
-            }
-        }
+        BackgroundWorker() = default;
 
         ~BackgroundWorker()
         {
             {
                 std::lock_guard lock(_mtx);
-                _shouldStop = true;
-            }
-            _cv.notify_all();
-            for (auto& thread : _workThreads)
-            {
-                if (thread.joinable())
+                for (auto& job : _jobs)
                 {
-                    thread.join();
+                    job->cancel();
                 }
             }
+            // Cancelled jobs skip their work, this only waits for the ones already running.
+            _tasks.Wait();
         }
 
         template<typename WorkFunc, typename CompletionFunc>
@@ -240,9 +225,8 @@ namespace OpenRCT2
             {
                 std::lock_guard lock(_mtx);
                 _jobs.push_back(job);
-                _pending.push_back(job);
             }
-            _cv.notify_one();
+            _tasks.Run([job]() { job->run(); }, TaskPriority::background);
 
             return Job(job);
         }
@@ -293,33 +277,9 @@ namespace OpenRCT2
         }
 
     private:
-        void processJobs()
-        {
-            while (true)
-            {
-                std::shared_ptr<Detail::JobBase> job;
-                {
-                    std::unique_lock lock(_mtx);
-                    _cv.wait(lock, [this] { return !_pending.empty() || _shouldStop; });
-
-                    if (_shouldStop)
-                    {
-                        break;
-                    }
-
-                    job = _pending.front();
-                    _pending.pop_front();
-                }
-                job->run();
-            }
-        }
-
         mutable std::mutex _mtx;
-        std::vector<std::thread> _workThreads;
-        std::condition_variable _cv;
-        std::atomic_bool _shouldStop{ false };
         std::vector<std::shared_ptr<Detail::JobBase>> _jobs;
-        std::deque<std::shared_ptr<Detail::JobBase>> _pending;
+        TaskGroup _tasks;
     };
 
 } // namespace OpenRCT2
@@ -16,9 +16,9 @@
 #include "File.h"
 #include "FileScanner.h"
 #include "FileStream.h"
-#include "JobPool.h"
 #include "Numerics.hpp"
 #include "Path.hpp"
+#include "TaskScheduler.h"
 
 #include <chrono>
 #include <list>
@@ -177,13 +177,13 @@ private:
         const size_t totalCount = scanResult.Files.size();
         if (totalCount > 0)
         {
-            JobPool jobPool;
+            OpenRCT2::TaskGroup tasks;
             std::mutex mtx;
             std::atomic<size_t> processed{ 0 };
 
             for (size_t i = 0; i < totalCount; i++)
             {
-                jobPool.AddTask([&, index = i]() {
+                tasks.Run([&, index = i]() {
                     const auto& filePath = scanResult.Files.at(index);
 
                     if (auto item = Create(language, filePath); item.has_value())
@@ -196,7 +196,7 @@ private:
                 });
             }
 
-            jobPool.Join([&]() {
+            tasks.Wait([&]() {
                 OpenRCT2::GetContext()->SetProgress(static_cast<uint32_t>(processed.load()), static_cast<uint32_t>(totalCount));
             });
         }
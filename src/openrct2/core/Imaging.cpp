@@ -170,95 +170,215 @@ namespace OpenRCT2::Imaging
         }
     }
 
-    static void WritePng(std::ostream& ostream, const Image& image)
+    struct PngWriteState
     {
         png_structp png_ptr = nullptr;
+        png_infop info_ptr = nullptr;
         png_colorp png_palette = nullptr;
-        try
-        {
-            png_ptr = png_create_write_struct(PNG_LIBPNG_VER_STRING, nullptr, PngError, PngWarning);
-            if (png_ptr == nullptr)
-            {
-                throw std::runtime_error("png_create_write_struct failed.");
-            }
+    };
 
-            png_text text_ptr[1];
-            text_ptr[0].key = const_cast<char*>("Software");
-            text_ptr[0].text = const_cast<char*>(gVersionInfoFull);
-            text_ptr[0].compression = PNG_TEXT_COMPRESSION_zTXt;
+    static void DestroyPng(PngWriteState& state)
+    {
+        if (state.png_ptr == nullptr)
+            return;
 
-            auto info_ptr = png_create_info_struct(png_ptr);
-            if (info_ptr == nullptr)
-            {
-                throw std::runtime_error("png_create_info_struct failed.");
-            }
+        png_free(state.png_ptr, state.png_palette);
+        png_destroy_write_struct(&state.png_ptr, &state.info_ptr);
+        state = {};
+    }
 
-            if (image.Depth == 8)
-            {
-                if (!image.Palette.has_value())
-                {
-                    throw std::runtime_error("Expected a palette for 8-bit image.");
-                }
+    // Sets up writing an image with the meta and palette of header and writes the PNG header.
+    static void BeginPng(PngWriteState& state, std::ostream& ostream, const Image& header)
+    {
+        state.png_ptr = png_create_write_struct(PNG_LIBPNG_VER_STRING, nullptr, PngError, PngWarning);
+        if (state.png_ptr == nullptr)
+        {
+            throw std::runtime_error("png_create_write_struct failed.");
+        }
+        auto png_ptr = state.png_ptr;
 
-                // Set the palette
-                png_palette = static_cast<png_colorp>(png_malloc(png_ptr, PNG_MAX_PALETTE_LENGTH * sizeof(png_color)));
-                if (png_palette == nullptr)
-                {
-                    throw std::runtime_error("png_malloc failed.");
-                }
-                for (size_t i = 0; i < PNG_MAX_PALETTE_LENGTH; i++)
-                {
-                    const auto& entry = (*image.Palette)[i];
-                    png_palette[i].blue = entry.Blue;
-                    png_palette[i].green = entry.Green;
-                    png_palette[i].red = entry.Red;
-                }
-                png_set_PLTE(png_ptr, info_ptr, png_palette, PNG_MAX_PALETTE_LENGTH);
-            }
+        png_text text_ptr[1];
+        text_ptr[0].key = const_cast<char*>("Software");
+        text_ptr[0].text = const_cast<char*>(gVersionInfoFull);
+        text_ptr[0].compression = PNG_TEXT_COMPRESSION_zTXt;
 
-            png_set_write_fn(png_ptr, &ostream, PngWriteData, PngFlush);
+        state.info_ptr = png_create_info_struct(png_ptr);
+        if (state.info_ptr == nullptr)
+        {
+            throw std::runtime_error("png_create_info_struct failed.");
+        }
+        auto info_ptr = state.info_ptr;
 
-            // Set error handler
-            if (setjmp(png_jmpbuf(png_ptr)))
+        if (header.Depth == 8)
+        {
+            if (!header.Palette.has_value())
             {
-                throw std::runtime_error("PNG ERROR");
+                throw std::runtime_error("Expected a palette for 8-bit image.");
             }
 
-            // Write header
-            auto colourType = PNG_COLOR_TYPE_RGB_ALPHA;
-            if (image.Depth == 8)
+            // Set the palette
+            state.png_palette = static_cast<png_colorp>(png_malloc(png_ptr, PNG_MAX_PALETTE_LENGTH * sizeof(png_color)));
+            if (state.png_palette == nullptr)
             {
-                png_byte transparentIndex = 0;
-                png_set_tRNS(png_ptr, info_ptr, &transparentIndex, 1, nullptr);
-                colourType = PNG_COLOR_TYPE_PALETTE;
+                throw std::runtime_error("png_malloc failed.");
             }
-            png_set_text(png_ptr, info_ptr, text_ptr, 1);
-            png_set_IHDR(
-                png_ptr, info_ptr, image.Width, image.Height, 8, colourType, PNG_INTERLACE_NONE, PNG_COMPRESSION_TYPE_DEFAULT,
-                PNG_FILTER_TYPE_DEFAULT);
-            png_write_info(png_ptr, info_ptr);
-
-            // Write pixels
-            auto pixels = image.Pixels.data();
-            for (uint32_t y = 0; y < image.Height; y++)
+            for (size_t i = 0; i < PNG_MAX_PALETTE_LENGTH; i++)
             {
-                png_write_row(png_ptr, const_cast<png_byte*>(pixels));
-                pixels += image.Stride;
+                const auto& entry = (*header.Palette)[i];
+                state.png_palette[i].blue = entry.Blue;
+                state.png_palette[i].green = entry.Green;
+                state.png_palette[i].red = entry.Red;
             }
+            png_set_PLTE(png_ptr, info_ptr, state.png_palette, PNG_MAX_PALETTE_LENGTH);
+        }
+
+        png_set_write_fn(png_ptr, &ostream, PngWriteData, PngFlush);
+
+        // Set error handler
+        if (setjmp(png_jmpbuf(png_ptr)))
+        {
+            throw std::runtime_error("PNG ERROR");
+        }
+
+        // Write header
+        auto colourType = PNG_COLOR_TYPE_RGB_ALPHA;
+        if (header.Depth == 8)
+        {
+            png_byte transparentIndex = 0;
+            png_set_tRNS(png_ptr, info_ptr, &transparentIndex, 1, nullptr);
+            colourType = PNG_COLOR_TYPE_PALETTE;
+        }
+        png_set_text(png_ptr, info_ptr, text_ptr, 1);
+        png_set_IHDR(
+            png_ptr, info_ptr, header.Width, header.Height, 8, colourType, PNG_INTERLACE_NONE, PNG_COMPRESSION_TYPE_DEFAULT,
+            PNG_FILTER_TYPE_DEFAULT);
+        png_write_info(png_ptr, info_ptr);
+    }
+
+    static void WritePngRows(PngWriteState& state, const uint8_t* pixels, uint32_t numRows, uint32_t stride)
+    {
+        if (setjmp(png_jmpbuf(state.png_ptr)))
+        {
+            throw std::runtime_error("PNG ERROR");
+        }
+
+        for (uint32_t y = 0; y < numRows; y++)
+        {
+            png_write_row(state.png_ptr, const_cast<png_byte*>(pixels));
+            pixels += stride;
+        }
+    }
+
+    static void EndPng(PngWriteState& state)
+    {
+        if (setjmp(png_jmpbuf(state.png_ptr)))
+        {
+            throw std::runtime_error("PNG ERROR");
+        }
+
+        png_write_end(state.png_ptr, nullptr);
+        DestroyPng(state);
+    }
 
-            png_write_end(png_ptr, nullptr);
-            png_destroy_info_struct(png_ptr, &info_ptr);
-            png_free(png_ptr, png_palette);
-            png_destroy_write_struct(&png_ptr, nullptr);
+    static void WritePng(std::ostream& ostream, const Image& image)
+    {
+        PngWriteState state;
+        try
+        {
+            BeginPng(state, ostream, image);
+            WritePngRows(state, image.Pixels.data(), image.Height, image.Stride);
+            EndPng(state);
         }
         catch (const std::exception&)
         {
-            png_free(png_ptr, png_palette);
-            png_destroy_write_struct(&png_ptr, nullptr);
+            DestroyPng(state);
             throw;
         }
     }
 
+#ifdef __EMSCRIPTEN__
+    // Hands the file to the browser as a download, as there is no file system to write it to.
+    static void DownloadFile(std::string_view path, std::string dataStr)
+    {
+        void* data = reinterpret_cast<void*>(dataStr.data());
+        MAIN_THREAD_EM_ASM(
+            {
+                const a = document.createElement("a");
+                // Blob requires the data must not be shared
+                const data = new Uint8Array(HEAPU8.subarray($0, $0 + $1));
+                a.href = URL.createObjectURL(new Blob([data]));
+                a.download = UTF8ToString($2).split("/").pop();
+                a.click();
+                setTimeout(function(){ URL.revokeObjectURL(a.href) }, 1000);
+            },
+            data, dataStr.size(), std::string(path).c_str());
+        free(data);
+    }
+#endif
+
+    struct PngWriter::State
+    {
+        std::string Path;
+#ifndef __EMSCRIPTEN__
+        std::ofstream Stream;
+#else
+        std::ostringstream Stream{ std::ios::binary };
+#endif
+        PngWriteState Png;
+        uint32_t Height{};
+        uint32_t RowsWritten{};
+    };
+
+    PngWriter::PngWriter(std::string_view path, const Image& header)
+        : _state(std::make_unique<State>())
+    {
+        _state->Path = path;
+        _state->Height = header.Height;
+#ifndef __EMSCRIPTEN__
+        _state->Stream.open(fs::u8path(path), std::ios::binary);
+        if (!_state->Stream.is_open())
+        {
+            throw std::runtime_error("Unable to open file for writing.");
+        }
+#endif
+        try
+        {
+            BeginPng(_state->Png, _state->Stream, header);
+        }
+        catch (const std::exception&)
+        {
+            DestroyPng(_state->Png);
+            throw;
+        }
+    }
+
+    PngWriter::~PngWriter()
+    {
+        DestroyPng(_state->Png);
+    }
+
+    void PngWriter::WriteRows(const uint8_t* pixels, uint32_t numRows, uint32_t stride)
+    {
+        Guard::Assert(_state->RowsWritten + numRows <= _state->Height, "Too many rows written to image");
+        WritePngRows(_state->Png, pixels, numRows, stride);
+        _state->RowsWritten += numRows;
+    }
+
+    void PngWriter::Finish()
+    {
+        Guard::Assert(_state->RowsWritten == _state->Height, "Not all rows of the image have been written");
+        EndPng(_state->Png);
+#ifndef __EMSCRIPTEN__
+        _state->Stream.close();
+        if (_state->Stream.fail())
+        {
+            throw std::runtime_error("Unable to write file.");
+        }
+#else
+        DownloadFile(_state->Path, _state->Stream.str());
+#endif
+    }
+
     ImageFormat GetImageFormatFromPath(std::string_view path)
     {
         if (String::endsWith(path, ".png", true))
@@ -346,20 +466,7 @@ namespace OpenRCT2::Imaging
 #else
                 std::ostringstream stream(std::ios::binary);
                 WritePng(stream, image);
-                std::string dataStr = stream.str();
-                void* data = reinterpret_cast<void*>(dataStr.data());
-                MAIN_THREAD_EM_ASM(
-                    {
-                        const a = document.createElement("a");
-                        // Blob requires the data must not be shared
-                        const data = new Uint8Array(HEAPU8.subarray($0, $0 + $1));
-                        a.href = URL.createObjectURL(new Blob([data]));
-                        a.download = UTF8ToString($2).split("/").pop();
-                        a.click();
-                        setTimeout(function(){ URL.revokeObjectURL(a.href) }, 1000);
-                    },
-                    data, dataStr.size(), std::string(path).c_str());
-                free(data);
+                DownloadFile(path, stream.str());
 #endif
                 break;
             }
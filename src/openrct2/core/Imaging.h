@@ -52,4 +52,27 @@ namespace OpenRCT2::Imaging
     void WriteToFile(std::string_view path, const Image& image, ImageFormat format = ImageFormat::automatic);
 
     void SetReader(ImageFormat format, ImageReaderFunc impl);
+
+    /**
+     * Writes a PNG a few rows at a time, so images too large to hold in memory can be written as they are produced.
+     * The size, depth and palette are taken from header, its pixels are not used.
+     */
+    class PngWriter
+    {
+    public:
+        PngWriter(std::string_view path, const Image& header);
+        PngWriter(const PngWriter&) = delete;
+        PngWriter& operator=(const PngWriter&) = delete;
+        ~PngWriter();
+
+        // Writes the next rows of the image, each stride bytes after the previous one.
+        void WriteRows(const uint8_t* pixels, uint32_t numRows, uint32_t stride);
+
+        // Completes the file once every row has been written.
+        void Finish();
+
+    private:
+        struct State;
+        std::unique_ptr<State> _state;
+    };
 } // namespace OpenRCT2::Imaging
@@ -172,6 +172,36 @@ namespace OpenRCT2
             }
         }
 
+        /**
+         * Copies a stream written with CompressionType::none from source to destination, compressing its chunk data.
+         * This lets the slow part of saving run away from the game state the chunks were written from.
+         */
+        static void Compress(IStream& source, IStream& destination)
+        {
+            auto header = source.ReadValue<Header>();
+            sfl::small_vector<ChunkEntry, 32> chunks;
+            for (uint32_t i = 0; i < header.NumChunks; i++)
+            {
+                chunks.push_back(source.ReadValue<ChunkEntry>());
+            }
+
+            std::vector<uint8_t> data(static_cast<size_t>(header.CompressedSize));
+            source.Read(data.data(), data.size());
+            if (header.Compression == CompressionType::none)
+            {
+                data = Compression::gzip(data.data(), data.size());
+                header.Compression = CompressionType::gzip;
+                header.CompressedSize = data.size();
+            }
+
+            destination.WriteValue(header);
+            for (const auto& chunk : chunks)
+            {
+                destination.WriteValue(chunk);
+            }
+            destination.Write(data.data(), data.size());
+        }
+
         Mode GetMode() const
         {
             return _mode;
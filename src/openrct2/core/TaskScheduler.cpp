@@ -0,0 +1,364 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2025 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "TaskScheduler.h"
+
+#include <cassert>
+
+namespace OpenRCT2
+{
+    // Tasks queued beyond this are run straight away by the submitting thread.
+    static constexpr size_t kWorkQueueCapacity = 1024;
+    // Background tasks are mostly waiting on the disk, running more at once would only take workers away from others.
+    static constexpr size_t kMaxRunningBackgroundTasks = 2;
+    // How often an idle worker looks for work again before going to sleep.
+    static constexpr int32_t kIdleSpinCount = 64;
+
+    static thread_local TaskScheduler* _currentScheduler = nullptr;
+    static thread_local size_t _currentWorkerIndex = 0;
+
+    Task::Task(Task&& other) noexcept
+        : _ops(other._ops)
+        , _group(other._group)
+        , _priority(other._priority)
+    {
+        if (_ops != nullptr)
+        {
+            _ops->relocate(_storage, other._storage);
+            other._ops = nullptr;
+        }
+    }
+
+    Task& Task::operator=(Task&& other) noexcept
+    {
+        if (this != &other)
+        {
+            Reset();
+            _ops = other._ops;
+            _group = other._group;
+            _priority = other._priority;
+            if (_ops != nullptr)
+            {
+                _ops->relocate(_storage, other._storage);
+                other._ops = nullptr;
+            }
+        }
+        return *this;
+    }
+
+    Task::~Task()
+    {
+        Reset();
+    }
+
+    void Task::Run()
+    {
+        assert(_ops != nullptr);
+        _ops->invoke(_storage);
+        Reset();
+    }
+
+    void Task::Reset()
+    {
+        if (_ops != nullptr)
+        {
+            _ops->destroy(_storage);
+            _ops = nullptr;
+        }
+    }
+
+    TaskScheduler::WorkQueue::WorkQueue(size_t capacity)
+        : _tasks(capacity)
+    {
+    }
+
+    bool TaskScheduler::WorkQueue::TryPush(Task&& task)
+    {
+        std::lock_guard lock(_mutex);
+        if (_count == _tasks.size())
+            return false;
+
+        _tasks[(_head + _count) % _tasks.size()] = std::move(task);
+        _count++;
+        return true;
+    }
+
+    bool TaskScheduler::WorkQueue::TryPopBack(Task& task, const TaskGroup* group)
+    {
+        std::lock_guard lock(_mutex);
+        for (size_t offset = _count; offset > 0; offset--)
+        {
+            if (group == nullptr || _tasks[(_head + offset - 1) % _tasks.size()].GetGroup() == group)
+            {
+                Take(offset - 1, task);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool TaskScheduler::WorkQueue::TryPopFront(Task& task, const TaskGroup* group)
+    {
+        std::lock_guard lock(_mutex);
+        for (size_t offset = 0; offset < _count; offset++)
+        {
+            if (group == nullptr || _tasks[(_head + offset) % _tasks.size()].GetGroup() == group)
+            {
+                Take(offset, task);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void TaskScheduler::WorkQueue::Take(size_t offset, Task& task)
+    {
+        const auto capacity = _tasks.size();
+        task = std::move(_tasks[(_head + offset) % capacity]);
+
+        // Close the gap from whichever end is nearer, taking from either end moves nothing.
+        if (offset < _count / 2)
+        {
+            for (size_t i = offset; i > 0; i--)
+            {
+                _tasks[(_head + i) % capacity] = std::move(_tasks[(_head + i - 1) % capacity]);
+            }
+            _head = (_head + 1) % capacity;
+        }
+        else
+        {
+            for (size_t i = offset + 1; i < _count; i++)
+            {
+                _tasks[(_head + i - 1) % capacity] = std::move(_tasks[(_head + i) % capacity]);
+            }
+        }
+        _count--;
+    }
+
+    TaskScheduler& TaskScheduler::Get()
+    {
+        // The calling thread takes part in waiting, so leave one hardware thread for it.
+        static TaskScheduler scheduler(std::max(std::thread::hardware_concurrency(), 2u) - 1);
+        return scheduler;
+    }
+
+    TaskScheduler::TaskScheduler(size_t numWorkers)
+    {
+        numWorkers = std::max<size_t>(numWorkers, 1);
+        for (size_t i = 0; i <= numWorkers; i++)
+        {
+            _queues.push_back(std::make_unique<WorkQueue>(kWorkQueueCapacity));
+        }
+        _backgroundQueue = std::make_unique<WorkQueue>(kWorkQueueCapacity);
+
+        for (size_t i = 0; i < numWorkers; i++)
+        {
+            _threads.emplace_back(&TaskScheduler::WorkerMain, this, i);
+        }
+    }
+
+    TaskScheduler::~TaskScheduler()
+    {
+        {
+            std::lock_guard lock(_sleepMutex);
+            _shouldStop = true;
+        }
+        _sleepCondition.notify_all();
+
+        for (auto& thread : _threads)
+        {
+            thread.join();
+        }
+    }
+
+    void TaskScheduler::Submit(Task&& task)
+    {
+        const auto isBackground = task.GetPriority() == TaskPriority::background;
+        auto& counter = isBackground ? _queuedBackgroundTasks : _queuedTasks;
+
+        // Count the task before it becomes visible, so a thread taking it never sees the counter go below zero.
+        counter.fetch_add(1);
+
+        bool queued;
+        if (isBackground)
+        {
+            queued = _backgroundQueue->TryPush(std::move(task));
+        }
+        else
+        {
+            const auto queueIndex = _currentScheduler == this ? _currentWorkerIndex : _threads.size();
+            queued = _queues[queueIndex]->TryPush(std::move(task));
+        }
+
+        if (!queued)
+        {
+            counter.fetch_sub(1);
+            RunTask(task);
+            return;
+        }
+
+        WakeWorker();
+    }
+
+    bool TaskScheduler::TryTakeTask(Task& task, const TaskGroup* group)
+    {
+        const auto numQueues = _queues.size();
+        const auto ownIndex = _currentScheduler == this ? _currentWorkerIndex : numQueues - 1;
+
+        // Workers take their newest task first while its data is still in cache, everything else is taken oldest first.
+        const bool isWorker = ownIndex != numQueues - 1;
+        const bool found = isWorker ? _queues[ownIndex]->TryPopBack(task, group)
+                                    : _queues[ownIndex]->TryPopFront(task, group);
+        if (found)
+        {
+            _queuedTasks.fetch_sub(1);
+            return true;
+        }
+
+        for (size_t i = 1; i < numQueues; i++)
+        {
+            if (_queues[(ownIndex + i) % numQueues]->TryPopFront(task, group))
+            {
+                _queuedTasks.fetch_sub(1);
+                return true;
+            }
+        }
+
+        if (group != nullptr || _queuedBackgroundTasks.load() == 0)
+            return false;
+
+        if (_runningBackgroundTasks.fetch_add(1) < kMaxRunningBackgroundTasks && _backgroundQueue->TryPopFront(task, nullptr))
+        {
+            _queuedBackgroundTasks.fetch_sub(1);
+            return true;
+        }
+        _runningBackgroundTasks.fetch_sub(1);
+        return false;
+    }
+
+    bool TaskScheduler::TryRunTask(const TaskGroup* group)
+    {
+        Task task;
+        if (!TryTakeTask(task, group))
+            return false;
+
+        const auto isBackground = task.GetPriority() == TaskPriority::background;
+        RunTask(task);
+        if (isBackground)
+        {
+            _runningBackgroundTasks.fetch_sub(1);
+            // A sleeping worker may now be allowed to pick up the next background task.
+            WakeWorker();
+        }
+        return true;
+    }
+
+    void TaskScheduler::RunTask(Task& task)
+    {
+        auto* group = task.GetGroup();
+        task.Run();
+        group->OnTaskCompleted();
+    }
+
+    bool TaskScheduler::HasRunnableTasks() const
+    {
+        if (_queuedTasks.load() != 0)
+            return true;
+        return _queuedBackgroundTasks.load() != 0 && _runningBackgroundTasks.load() < kMaxRunningBackgroundTasks;
+    }
+
+    void TaskScheduler::WakeWorker()
+    {
+        if (_sleepingWorkers.load() == 0)
+            return;
+
+        // Taking the lock makes sure a worker about to sleep either sees the new task or gets the notification.
+        {
+            std::lock_guard lock(_sleepMutex);
+        }
+        _sleepCondition.notify_one();
+    }
+
+    void TaskScheduler::WorkerMain(size_t index)
+    {
+        _currentScheduler = this;
+        _currentWorkerIndex = index;
+
+        while (true)
+        {
+            bool ranTask = false;
+            for (int32_t i = 0; i < kIdleSpinCount && !ranTask; i++)
+            {
+                ranTask = TryRunTask(nullptr);
+                if (!ranTask)
+                    std::this_thread::yield();
+            }
+            if (ranTask)
+                continue;
+
+            std::unique_lock lock(_sleepMutex);
+            _sleepingWorkers.fetch_add(1);
+            _sleepCondition.wait(lock, [this]() { return _shouldStop || HasRunnableTasks(); });
+            _sleepingWorkers.fetch_sub(1);
+            if (_shouldStop)
+                break;
+        }
+    }
+
+    TaskGroup::TaskGroup(TaskScheduler& scheduler)
+        : _scheduler(scheduler)
+    {
+    }
+
+    TaskGroup::~TaskGroup()
+    {
+        Wait();
+    }
+
+    void TaskGroup::Wait()
+    {
+        Wait(nullptr);
+    }
+
+    void TaskGroup::Wait(const std::function<void()>& reportFn)
+    {
+        size_t lastCompleted = 0;
+        while (true)
+        {
+            // Help with the queued tasks of this group rather than blocking. Tasks of other groups are left to the
+            // workers, they could take far longer than the caller is willing to wait, such as the object preloader.
+            if (_pending.load() != 0 && _scheduler.TryRunTask(this))
+            {
+                if (reportFn)
+                    reportFn();
+                continue;
+            }
+
+            std::unique_lock lock(_mutex);
+            _condition.wait(lock, [&]() { return _pending.load() == 0 || _completed != lastCompleted; });
+            lastCompleted = _completed;
+            const bool isDone = _pending.load() == 0;
+            lock.unlock();
+
+            if (reportFn)
+                reportFn();
+            if (isDone)
+                break;
+        }
+    }
+
+    void TaskGroup::OnTaskCompleted()
+    {
+        // Done under the lock so a waiter that sees no pending tasks can not destroy the group while this runs.
+        std::lock_guard lock(_mutex);
+        _completed++;
+        _pending.fetch_sub(1);
+        _condition.notify_all();
+    }
+} // namespace OpenRCT2
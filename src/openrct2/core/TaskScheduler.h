@@ -0,0 +1,239 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2025 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace OpenRCT2
+{
+    class TaskGroup;
+
+    enum class TaskPriority : uint8_t
+    {
+        normal,
+        // Long running work such as loading files. Never picked up by a thread waiting on a task group, so it can not
+        // stall frame work, and only a few run at the same time.
+        background,
+    };
+
+    /**
+     * A unit of work with its callable stored inline, so queuing a task does not allocate.
+     */
+    class Task
+    {
+    public:
+        static constexpr size_t kStorageSize = 64;
+
+        Task() = default;
+
+        template<typename TFn>
+        Task(TFn&& fn, TaskGroup* group, TaskPriority priority)
+            : _group(group)
+            , _priority(priority)
+        {
+            using TCallable = std::decay_t<TFn>;
+            static_assert(sizeof(TCallable) <= kStorageSize, "Task callable is too large, capture by reference instead");
+            static_assert(alignof(TCallable) <= alignof(std::max_align_t), "Task callable is over-aligned");
+
+            new (_storage) TCallable(std::forward<TFn>(fn));
+            _ops = &kOps<TCallable>;
+        }
+
+        Task(Task&& other) noexcept;
+        Task& operator=(Task&& other) noexcept;
+        Task(const Task&) = delete;
+        Task& operator=(const Task&) = delete;
+        ~Task();
+
+        void Run();
+
+        TaskGroup* GetGroup() const
+        {
+            return _group;
+        }
+
+        TaskPriority GetPriority() const
+        {
+            return _priority;
+        }
+
+    private:
+        struct Ops
+        {
+            void (*invoke)(void* storage);
+            void (*relocate)(void* dst, void* src);
+            void (*destroy)(void* storage);
+        };
+
+        template<typename TCallable>
+        static constexpr Ops kOps = {
+            [](void* storage) { (*static_cast<TCallable*>(storage))(); },
+            [](void* dst, void* src) {
+                new (dst) TCallable(std::move(*static_cast<TCallable*>(src)));
+                static_cast<TCallable*>(src)->~TCallable();
+            },
+            [](void* storage) { static_cast<TCallable*>(storage)->~TCallable(); },
+        };
+
+        void Reset();
+
+        alignas(std::max_align_t) std::byte _storage[kStorageSize];
+        const Ops* _ops = nullptr;
+        TaskGroup* _group = nullptr;
+        TaskPriority _priority = TaskPriority::normal;
+    };
+
+    /**
+     * Engine wide work-stealing task scheduler. Every worker thread owns a queue it pushes to and pops from the back
+     * of, idle threads steal from the front of the other queues. Tasks submitted from threads that are not workers go
+     * to a shared queue. Threads waiting on a task group run queued tasks of that group instead of blocking.
+     */
+    class TaskScheduler
+    {
+    public:
+        // The shared scheduler, created on first use.
+        static TaskScheduler& Get();
+
+        explicit TaskScheduler(size_t numWorkers);
+        TaskScheduler(const TaskScheduler&) = delete;
+        TaskScheduler& operator=(const TaskScheduler&) = delete;
+        ~TaskScheduler();
+
+        size_t GetNumWorkers() const
+        {
+            return _threads.size();
+        }
+
+        /**
+         * Calls fn(index) for every index in [begin, end), split into chunks of grainSize indices run in parallel.
+         * The calling thread takes part and the call returns once every index has been processed.
+         */
+        template<typename TFn>
+        void ParallelFor(size_t begin, size_t end, size_t grainSize, TFn&& fn);
+
+    private:
+        friend class TaskGroup;
+
+        class WorkQueue
+        {
+        public:
+            explicit WorkQueue(size_t capacity);
+
+            bool TryPush(Task&& task);
+            // Takes the newest or oldest task, or only of the given group if there is one.
+            bool TryPopBack(Task& task, const TaskGroup* group);
+            bool TryPopFront(Task& task, const TaskGroup* group);
+
+        private:
+            void Take(size_t offset, Task& task);
+
+            std::mutex _mutex;
+            std::vector<Task> _tasks;
+            size_t _head = 0;
+            size_t _count = 0;
+        };
+
+        void Submit(Task&& task);
+        // Takes any task when group is null, otherwise only a normal priority task of that group.
+        bool TryTakeTask(Task& task, const TaskGroup* group);
+        bool TryRunTask(const TaskGroup* group);
+        void RunTask(Task& task);
+        bool HasRunnableTasks() const;
+        void WakeWorker();
+        void WorkerMain(size_t index);
+
+        std::vector<std::thread> _threads;
+        // One queue per worker, followed by the queue shared by all other threads.
+        std::vector<std::unique_ptr<WorkQueue>> _queues;
+        std::unique_ptr<WorkQueue> _backgroundQueue;
+
+        std::atomic<size_t> _queuedTasks{ 0 };
+        std::atomic<size_t> _queuedBackgroundTasks{ 0 };
+        std::atomic<size_t> _runningBackgroundTasks{ 0 };
+
+        std::mutex _sleepMutex;
+        std::condition_variable _sleepCondition;
+        std::atomic<size_t> _sleepingWorkers{ 0 };
+        bool _shouldStop = false;
+    };
+
+    /**
+     * A set of tasks that can be waited on together. Waiting helps to run queued tasks of the group on the calling
+     * thread, so task groups can be nested and waited on from worker threads. The destructor waits for any remaining
+     * tasks.
+     */
+    class TaskGroup
+    {
+    public:
+        explicit TaskGroup(TaskScheduler& scheduler = TaskScheduler::Get());
+        TaskGroup(const TaskGroup&) = delete;
+        TaskGroup& operator=(const TaskGroup&) = delete;
+        ~TaskGroup();
+
+        template<typename TFn>
+        void Run(TFn&& fn, TaskPriority priority = TaskPriority::normal)
+        {
+            _pending.fetch_add(1);
+            _scheduler.Submit(Task(std::forward<TFn>(fn), this, priority));
+        }
+
+        void Wait();
+
+        // Waits like Wait, calling reportFn on the waiting thread every time tasks of the group complete.
+        void Wait(const std::function<void()>& reportFn);
+
+        bool IsBusy() const
+        {
+            return _pending.load() != 0;
+        }
+
+    private:
+        friend class TaskScheduler;
+
+        void OnTaskCompleted();
+
+        TaskScheduler& _scheduler;
+        std::atomic<size_t> _pending{ 0 };
+        size_t _completed = 0;
+        std::mutex _mutex;
+        std::condition_variable _condition;
+    };
+
+    template<typename TFn>
+    void TaskScheduler::ParallelFor(size_t begin, size_t end, size_t grainSize, TFn&& fn)
+    {
+        grainSize = std::max<size_t>(grainSize, 1);
+
+        TaskGroup group(*this);
+        for (size_t chunkBegin = begin; chunkBegin < end; chunkBegin += grainSize)
+        {
+            const auto chunkEnd = std::min(chunkBegin + grainSize, end);
+            group.Run([&fn, chunkBegin, chunkEnd]() {
+                for (size_t i = chunkBegin; i < chunkEnd; i++)
+                {
+                    fn(i);
+                }
+            });
+        }
+        group.Wait();
+    }
+} // namespace OpenRCT2
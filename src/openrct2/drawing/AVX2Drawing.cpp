@@ -41,6 +41,56 @@ void MaskAvx2(
     }
 }
 
+void RemapRunAvx2(
+    const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t count, const uint8_t* RESTRICT map, bool remapDst)
+{
+    const __m256i zero = {};
+    const __m256i lowNibble = _mm256_set1_epi8(0x0F);
+
+    int32_t i = 0;
+    for (; i + 32 <= count; i += 32)
+    {
+        const __m256i source = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+        const __m256i dest = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + i));
+        const __m256i index = remapDst ? dest : source;
+        const __m256i indexLow = _mm256_and_si256(index, lowNibble);
+        const __m256i indexHigh = _mm256_and_si256(_mm256_srli_epi16(index, 4), lowNibble);
+
+        // Look up the map 16 entries at a time, keeping the results of the pixels whose high nibble selects them.
+        // The shuffle works within each 128 bit lane, so both lanes get the same entries.
+        __m256i mapped = zero;
+        for (int32_t row = 0; row < 16; row++)
+        {
+            const __m256i mapRow = _mm256_broadcastsi128_si256(
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(map + row * 16)));
+            const __m256i isRow = _mm256_cmpeq_epi8(indexHigh, _mm256_set1_epi8(static_cast<char>(row)));
+            mapped = _mm256_or_si256(mapped, _mm256_and_si256(_mm256_shuffle_epi8(mapRow, indexLow), isRow));
+        }
+
+        const __m256i keep = _mm256_or_si256(_mm256_cmpeq_epi8(source, zero), _mm256_cmpeq_epi8(mapped, zero));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_blendv_epi8(mapped, dest, keep));
+    }
+
+    RemapRunScalar(src + i, dst + i, count - i, map, remapDst);
+}
+
+void PaletteToRgbaAvx2(const uint8_t* RESTRICT src, uint32_t* RESTRICT dst, int32_t count, const uint32_t* RESTRICT palette)
+{
+    const auto* table = reinterpret_cast<const int*>(palette);
+
+    int32_t i = 0;
+    for (; i + 16 <= count; i += 16)
+    {
+        const __m128i indices = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        const __m256i low = _mm256_i32gather_epi32(table, _mm256_cvtepu8_epi32(indices), 4);
+        const __m256i high = _mm256_i32gather_epi32(table, _mm256_cvtepu8_epi32(_mm_srli_si128(indices, 8)), 4);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), low);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i + 8), high);
+    }
+
+    PaletteToRgbaScalar(src + i, dst + i, count - i, palette);
+}
+
 #else
 
     #ifdef OPENRCT2_X86
@@ -54,4 +104,15 @@ void MaskAvx2(
     OpenRCT2::Guard::Fail("AVX2 function called on a CPU that doesn't support AVX2");
 }
 
+void RemapRunAvx2(
+    const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t count, const uint8_t* RESTRICT map, bool remapDst)
+{
+    OpenRCT2::Guard::Fail("AVX2 function called on a CPU that doesn't support AVX2");
+}
+
+void PaletteToRgbaAvx2(const uint8_t* RESTRICT src, uint32_t* RESTRICT dst, int32_t count, const uint32_t* RESTRICT palette)
+{
+    OpenRCT2::Guard::Fail("AVX2 function called on a CPU that doesn't support AVX2");
+}
+
 #endif // __AVX2__
@@ -9,6 +9,8 @@
 
 #include "Drawing.h"
 
+#include "SpriteMipCache.h"
+
 #include <cassert>
 #include <cstring>
 
@@ -57,7 +59,12 @@ static void FASTCALL DrawRLESpriteMagnify(RenderTarget& rt, const DrawSpriteArgs
     }
 }
 
-template<DrawBlendOp TBlendOp, size_t TZoom>
+// Shortest run of pixels drawn with RemapRunFn rather than pixel by pixel. Shorter runs leave the AVX2 code nothing to do
+// in whole vectors, so the call is only overhead.
+static constexpr int32_t kRemapRunMinPixels = 32;
+
+// Minified copies from the mip cache are drawn with TZoom 0, but have to skip the same pixels the zoomed out levels do.
+template<DrawBlendOp TBlendOp, size_t TZoom, bool TFromMipCache = false>
 static void FASTCALL DrawRLESpriteMinify(RenderTarget& rt, const DrawSpriteArgs& args)
 {
     auto src0 = args.SourceImage.offset;
@@ -129,14 +136,33 @@ static void FASTCALL DrawRLESpriteMinify(RenderTarget& rt, const DrawSpriteArgs&
             numPixels = std::min(numPixels, width - x);
 
             auto dst = dstLineStart + (x >> TZoom);
-            if constexpr ((TBlendOp & kBlendSrc) == 0 && (TBlendOp & kBlendDst) == 0 && TZoom == 0)
+            if constexpr ((TBlendOp & kBlendSrc) == 0 && (TBlendOp & kBlendDst) == 0 && TZoom == 0 && !TFromMipCache)
             {
                 // Since we're sampling each pixel at this zoom level, just do a straight std::memcpy
+                // This copies pixels of index 0 as well, which BlitPixel skips.
                 if (numPixels > 0)
                 {
                     std::memcpy(dst, src, numPixels);
                 }
             }
+            else if constexpr (
+                (TBlendOp & kBlendTransparent) != 0 && ((TBlendOp & kBlendSrc) != 0) != ((TBlendOp & kBlendDst) != 0)
+                && TZoom == 0)
+            {
+                // Remap long runs with the vector code, the call is not worth it for a handful of pixels
+                auto& paletteMap = args.PalMap;
+                if (numPixels >= kRemapRunMinPixels && paletteMap.Size() >= 256)
+                {
+                    RemapRunFn(src, dst, numPixels, paletteMap.Data(), (TBlendOp & kBlendDst) != 0);
+                }
+                else
+                {
+                    for (int32_t j = 0; j < numPixels; j++)
+                    {
+                        BlitPixel<TBlendOp>(src + j, dst + j, paletteMap);
+                    }
+                }
+            }
             else
             {
                 auto& paletteMap = args.PalMap;
@@ -152,6 +178,45 @@ static void FASTCALL DrawRLESpriteMinify(RenderTarget& rt, const DrawSpriteArgs&
     }
 }
 
+// Draws the pixels DrawRLESpriteMinify would from the cached minified copy of the sprite, which is drawn unzoomed.
+// Returns false if there is no copy to draw from.
+template<DrawBlendOp TBlendOp, size_t TZoom>
+static bool DrawRLESpriteFromMipCache(RenderTarget& rt, const DrawSpriteArgs& args)
+{
+    using namespace OpenRCT2::Drawing;
+
+    constexpr int32_t zoom = 1 << TZoom;
+    auto srcY = args.SrcY;
+    auto height = args.Height;
+    auto dst = args.DestinationBits;
+
+    // Only the columns at multiples of the zoom are kept, which are the ones drawn unless the sprite is cut off at an
+    // odd position.
+    if (args.SrcX & (zoom - 1))
+        return false;
+
+    // Same as DrawRLESpriteMinify.
+    if (srcY < 0)
+    {
+        srcY += zoom;
+        height -= zoom;
+        dst += rt.LineStride();
+    }
+    if (height <= 0)
+        return true;
+
+    const auto rowPhase = static_cast<uint8_t>(srcY & (zoom - 1));
+    const auto sprite = SpriteMipCache::Get(args.Image.GetIndex(), args.SourceImage, TZoom, rowPhase);
+    if (sprite == nullptr)
+        return false;
+
+    const DrawSpriteArgs minifiedArgs(
+        args.Image, args.PalMap, sprite->Element, args.SrcX >> TZoom, srcY >> TZoom, (args.Width + zoom - 1) >> TZoom,
+        (height + zoom - 1) >> TZoom, dst);
+    DrawRLESpriteMinify<TBlendOp, 0, true>(rt, minifiedArgs);
+    return true;
+}
+
 template<DrawBlendOp TBlendOp>
 static void FASTCALL DrawRLESprite(RenderTarget& rt, const DrawSpriteArgs& args)
 {
@@ -166,13 +231,16 @@ static void FASTCALL DrawRLESprite(RenderTarget& rt, const DrawSpriteArgs& args)
             DrawRLESpriteMinify<TBlendOp, 0>(rt, args);
             break;
         case 1:
-            DrawRLESpriteMinify<TBlendOp, 1>(rt, args);
+            if (!DrawRLESpriteFromMipCache<TBlendOp, 1>(rt, args))
+                DrawRLESpriteMinify<TBlendOp, 1>(rt, args);
             break;
         case 2:
-            DrawRLESpriteMinify<TBlendOp, 2>(rt, args);
+            if (!DrawRLESpriteFromMipCache<TBlendOp, 2>(rt, args))
+                DrawRLESpriteMinify<TBlendOp, 2>(rt, args);
             break;
         case 3:
-            DrawRLESpriteMinify<TBlendOp, 3>(rt, args);
+            if (!DrawRLESpriteFromMipCache<TBlendOp, 3>(rt, args))
+                DrawRLESpriteMinify<TBlendOp, 3>(rt, args);
             break;
         default:
             assert(false);
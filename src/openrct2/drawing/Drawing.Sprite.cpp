@@ -23,6 +23,7 @@
 #include "../rct1/Csg.h"
 #include "../ui/UiContext.h"
 #include "ScrollingText.h"
+#include "SpriteMipCache.h"
 
 #include <cassert>
 #include <memory>
@@ -411,6 +412,22 @@ void MaskScalar(
     }
 }
 
+void RemapRunScalar(
+    const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t count, const uint8_t* RESTRICT map, bool remapDst)
+{
+    for (int32_t i = 0; i < count; i++)
+    {
+        if (src[i] == 0)
+            continue;
+
+        const auto pixel = map[remapDst ? dst[i] : src[i]];
+        if (pixel != 0)
+        {
+            dst[i] = pixel;
+        }
+    }
+}
+
 static void MaskMagnify(
     const ZoomLevel zoom, int32_t width, int32_t height, const uint8_t* RESTRICT maskSrc, const uint8_t* RESTRICT colourSrc,
     uint8_t* RESTRICT dst, int32_t maskStride, int32_t colourStride, int32_t dstStride, int32_t srcX, int32_t srcY)
@@ -503,6 +520,7 @@ bool GfxLoadG1(const IPlatformEnvironment& env)
 
 void GfxUnloadG1()
 {
+    Drawing::SpriteMipCache::InvalidateAll();
     _g1.data.reset();
     _g1.elements.clear();
     _g1.elements.shrink_to_fit();
@@ -510,6 +528,7 @@ void GfxUnloadG1()
 
 void GfxUnloadG2AndFonts()
 {
+    Drawing::SpriteMipCache::InvalidateAll();
     _g2.data.reset();
     _g2.elements.clear();
     _g2.elements.shrink_to_fit();
@@ -523,6 +542,7 @@ void GfxUnloadG2AndFonts()
 
 void GfxUnloadCsg()
 {
+    Drawing::SpriteMipCache::InvalidateAll();
     _csg.data.reset();
     _csg.elements.clear();
     _csg.elements.shrink_to_fit();
@@ -1118,6 +1138,11 @@ void GfxSetG1Element(ImageIndex imageId, const G1Element* g1)
 
     if (g1 != nullptr)
     {
+        if (isValid)
+        {
+            Drawing::SpriteMipCache::Invalidate(imageId);
+        }
+
         if (isTemp)
         {
             _g1Temp = *g1;
@@ -678,6 +678,61 @@ void MaskFn(
     MaskFunc(width, height, maskSrc, colourSrc, dst, maskWrap, colourWrap, dstWrap);
 }
 
+static auto GetRemapRunFunction()
+{
+    if (Platform::AVX2Available())
+    {
+        LOG_VERBOSE("registering AVX2 remap run function");
+        return RemapRunAvx2;
+    }
+    else
+    {
+        LOG_VERBOSE("registering scalar remap run function");
+        return RemapRunScalar;
+    }
+}
+
+static const auto RemapRunFunc = GetRemapRunFunction();
+
+void RemapRunFn(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t count, const uint8_t* RESTRICT map, bool remapDst)
+{
+    RemapRunFunc(src, dst, count, map, remapDst);
+}
+
+void PaletteToRgbaScalar(const uint8_t* RESTRICT src, uint32_t* RESTRICT dst, int32_t count, const uint32_t* RESTRICT palette)
+{
+    for (int32_t i = 0; i < count; i++)
+    {
+        dst[i] = palette[src[i]];
+    }
+}
+
+static auto GetPaletteToRgbaFunction()
+{
+    if (Platform::AVX2Available())
+    {
+        LOG_VERBOSE("registering AVX2 palette expansion function");
+        return PaletteToRgbaAvx2;
+    }
+    else if (Platform::SSE41Available())
+    {
+        LOG_VERBOSE("registering SSE4.1 palette expansion function");
+        return PaletteToRgbaSse4_1;
+    }
+    else
+    {
+        LOG_VERBOSE("registering scalar palette expansion function");
+        return PaletteToRgbaScalar;
+    }
+}
+
+static const auto PaletteToRgbaFunc = GetPaletteToRgbaFunction();
+
+void PaletteToRgbaFn(const uint8_t* RESTRICT src, uint32_t* RESTRICT dst, int32_t count, const uint32_t* RESTRICT palette)
+{
+    PaletteToRgbaFunc(src, dst, count, palette);
+}
+
 void GfxFilterPixel(RenderTarget& rt, const ScreenCoordsXY& coords, FilterPaletteID palette)
 {
     GfxFilterRect(rt, { coords, coords }, palette);
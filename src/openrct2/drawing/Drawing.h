@@ -389,6 +389,17 @@ public:
     uint8_t operator[](size_t index) const;
 
     uint8_t Blend(uint8_t src, uint8_t dst) const;
+
+    const uint8_t* Data() const
+    {
+        return _data.data();
+    }
+
+    size_t Size() const
+    {
+        return _data.size();
+    }
+
     void Copy(size_t dstIndex, const PaletteMap& src, size_t srcIndex, size_t length);
 };
 
@@ -605,6 +616,22 @@ void MaskFn(
     int32_t width, int32_t height, const uint8_t* RESTRICT maskSrc, const uint8_t* RESTRICT colourSrc, uint8_t* RESTRICT dst,
     int32_t maskWrap, int32_t colourWrap, int32_t dstWrap);
 
+// Draws a run of sprite pixels through a 256 entry palette map, indexed by the source pixels or by the destination pixels
+// if remapDst is set. Like BlitPixel, transparent source pixels and pixels that map to 0 are left alone.
+void RemapRunScalar(
+    const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t count, const uint8_t* RESTRICT map, bool remapDst);
+void RemapRunAvx2(
+    const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t count, const uint8_t* RESTRICT map, bool remapDst);
+
+void RemapRunFn(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t count, const uint8_t* RESTRICT map, bool remapDst);
+
+// Expands a run of 8-bit pixels to 32-bit ones through a palette already converted to the format of the display.
+void PaletteToRgbaScalar(const uint8_t* RESTRICT src, uint32_t* RESTRICT dst, int32_t count, const uint32_t* RESTRICT palette);
+void PaletteToRgbaSse4_1(const uint8_t* RESTRICT src, uint32_t* RESTRICT dst, int32_t count, const uint32_t* RESTRICT palette);
+void PaletteToRgbaAvx2(const uint8_t* RESTRICT src, uint32_t* RESTRICT dst, int32_t count, const uint32_t* RESTRICT palette);
+
+void PaletteToRgbaFn(const uint8_t* RESTRICT src, uint32_t* RESTRICT dst, int32_t count, const uint32_t* RESTRICT palette);
+
 std::optional<uint32_t> GetPaletteG1Index(colour_t paletteId);
 std::optional<PaletteMap> GetPaletteMapForColour(colour_t paletteId);
 void UpdatePalette(std::span<const OpenRCT2::Drawing::PaletteBGRA> palette, int32_t start_index, int32_t num_colours);
@@ -1,10 +1,21 @@
 #include "InvalidationGrid.h"
 
+#include "../profiling/Profiling.h"
+
 #include <algorithm>
 #include <cstring>
 
 namespace OpenRCT2::Drawing
 {
+    // Drawing a region has a fixed cost on top of its area, mostly for setting up paint sessions for its viewport
+    // columns, so two regions are drawn as one when that only adds up to this many blocks that are not dirty.
+    static constexpr uint32_t kMaxMergeWasteBlocks = 2;
+
+    static Profiling::Counter _dirtyFramesCounter("Dirty frames");
+    static Profiling::Counter _dirtyBlocksCounter("Dirty blocks");
+    static Profiling::Counter _dirtyRegionsCounter("Dirty regions drawn");
+    static Profiling::Counter _dirtyPixelsCounter("Dirty pixels drawn");
+
     uint32_t InvalidationGrid::getRowCount() const noexcept
     {
         return _rowCount;
@@ -89,4 +100,156 @@ namespace OpenRCT2::Drawing
         }
     }
 
+    void InvalidationGrid::collectDirtyRegions()
+    {
+        _regions.clear();
+
+        const uint32_t columnCount = _columnCount;
+        const uint32_t rowCount = _rowCount;
+        auto& blocks = _blocks;
+
+        const uint32_t startRow = rowCount ? std::clamp(_lowestRow, 0u, rowCount - 1) : 0;
+        const uint32_t endRow = rowCount ? std::clamp(_highestRow, 0u, rowCount - 1) : 0;
+        const uint32_t startCol = columnCount ? std::clamp(_lowestColumn, 0u, columnCount - 1) : 0;
+        const uint32_t endCol = columnCount ? std::clamp(_highestColumn, 0u, columnCount - 1) : 0;
+
+        uint32_t dirtyBlocks = 0;
+        for (uint32_t currentRow = startRow; currentRow <= endRow && !blocks.empty(); ++currentRow)
+        {
+            for (uint32_t currentCol = startCol; currentCol <= endCol;)
+            {
+                const uint32_t blockIndex = currentRow * columnCount + currentCol;
+
+                if (blocks[blockIndex] == 0)
+                {
+                    ++currentCol;
+                    continue;
+                }
+
+                // Horizontal merge.
+                uint32_t horizontalSpan = 1;
+                while (currentCol + horizontalSpan < columnCount
+                       && blocks[currentRow * columnCount + currentCol + horizontalSpan] != 0)
+                {
+                    ++horizontalSpan;
+                }
+
+                // Vertical merge.
+                uint32_t mergedWidth = horizontalSpan;
+                uint32_t verticalSpan = 0;
+                for (uint32_t rowOffset = 1; currentRow + rowOffset <= endRow; ++rowOffset)
+                {
+                    uint32_t validWidth = 0;
+                    while (validWidth < mergedWidth
+                           && blocks[(currentRow + rowOffset) * columnCount + currentCol + validWidth] != 0)
+                    {
+                        ++validWidth;
+                    }
+                    if (validWidth == 0)
+                        break;
+                    mergedWidth = validWidth;
+                    ++verticalSpan;
+                }
+
+                const uint32_t totalRows = verticalSpan + 1;
+
+                // Clear blocks
+                for (uint32_t y = currentRow; y < currentRow + totalRows; ++y)
+                {
+                    for (uint32_t x = currentCol; x < currentCol + mergedWidth; ++x)
+                    {
+                        blocks[y * columnCount + x] = 0;
+                    }
+                }
+
+                _regions.push_back({ currentCol, currentRow, currentCol + mergedWidth, currentRow + totalRows });
+                dirtyBlocks += mergedWidth * totalRows;
+
+                // Skip processed columns
+                currentCol += mergedWidth;
+            }
+        }
+
+        _lowestRow = std::numeric_limits<uint32_t>::max();
+        _highestRow = 0;
+        _lowestColumn = std::numeric_limits<uint32_t>::max();
+        _highestColumn = 0;
+
+        mergeRegions();
+
+        // Convert to screen coordinates, leaving out regions that start off screen.
+        for (auto& region : _regions)
+        {
+            region.left *= _blockWidth;
+            region.top *= _blockHeight;
+            region.right = std::min<uint32_t>(region.right * _blockWidth, _screenWidth);
+            region.bottom = std::min<uint32_t>(region.bottom * _blockHeight, _screenHeight);
+        }
+        auto last = std::remove_if(_regions.begin(), _regions.end(), [this](const Region& region) {
+            return region.left >= _screenWidth || region.top >= _screenHeight;
+        });
+        _regions.erase(last, _regions.end());
+
+        uint64_t drawnPixels = 0;
+        for (const auto& region : _regions)
+        {
+            drawnPixels += region.area();
+        }
+
+        if (dirtyBlocks != 0)
+        {
+            _dirtyFramesCounter.Increment();
+            _dirtyBlocksCounter.Add(dirtyBlocks);
+            _dirtyRegionsCounter.Add(_regions.size());
+            _dirtyPixelsCounter.Add(drawnPixels);
+        }
+    }
+
+    void InvalidationGrid::mergeRegions() noexcept
+    {
+        // Regions are disjoint to begin with, but a merged region can partly cover others, which are then drawn twice
+        // where they overlap. Only a little waste is allowed per merge, so this stays rare.
+        // This is a single pass: each region absorbs the later regions it can merge with, and absorbed regions are
+        // emptied and removed at the end, so many dirty regions cost O(n^2) rather than restarting after every merge.
+        const auto isEmpty = [](const Region& region) { return region.left == region.right; };
+        for (size_t i = 0; i < _regions.size(); i++)
+        {
+            if (isEmpty(_regions[i]))
+                continue;
+
+            for (size_t j = i + 1; j < _regions.size(); j++)
+            {
+                auto& a = _regions[i];
+                auto& b = _regions[j];
+                if (isEmpty(b))
+                    continue;
+
+                const Region combined = {
+                    std::min(a.left, b.left),
+                    std::min(a.top, b.top),
+                    std::max(a.right, b.right),
+                    std::max(a.bottom, b.bottom),
+                };
+                if (combined.area() > a.area() + b.area() + kMaxMergeWasteBlocks)
+                    continue;
+
+                a = combined;
+                b = {};
+
+                // Earlier regions now covered by the merged one do not need to be drawn on their own, later ones are
+                // absorbed for free when the loop reaches them.
+                for (size_t k = 0; k < i; k++)
+                {
+                    auto& region = _regions[k];
+                    if (!isEmpty(region) && region.left >= combined.left && region.top >= combined.top
+                        && region.right <= combined.right && region.bottom <= combined.bottom)
+                    {
+                        region = {};
+                    }
+                }
+            }
+        }
+        _regions.erase(std::remove_if(_regions.begin(), _regions.end(), isEmpty), _regions.end());
+    }
+
 } // namespace OpenRCT2::Drawing
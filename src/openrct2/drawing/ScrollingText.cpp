@@ -18,6 +18,7 @@
 #include "../localisation/Formatter.h"
 #include "../localisation/Formatting.h"
 #include "../localisation/LocalisationService.h"
+#include "../paint/Paint.SessionFlags.h"
 #include "../paint/Paint.h"
 #include "Drawing.h"
 #include "TTF.h"
@@ -1441,6 +1442,9 @@ ImageId ScrollingTextSetup(
     if (session.DPI.zoom_level > ZoomLevel{ 0 })
         return ImageId(SPR_SCROLLING_TEXT_DEFAULT);
 
+    // The text moves every frame and its image slot may be reused by other text.
+    session.Flags |= PaintSessionFlags::IsAnimated;
+
     _drawSCrollNextIndex++;
     ft.Rewind();
     uint32_t scrollIndex = ScrollingTextGetMatchingOrOldest(stringId, ft, scroll, scrollingMode, colour);
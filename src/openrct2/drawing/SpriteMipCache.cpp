@@ -0,0 +1,235 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2025 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "SpriteMipCache.h"
+
+#include "../SpriteIds.h"
+#include "../config/Config.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+namespace OpenRCT2::Drawing::SpriteMipCache
+{
+    // Zoom levels drawn by minifying RLE sprites, see DrawRLESprite.
+    static constexpr uint8_t kMaxZoom = 3;
+    static constexpr size_t kMemoryBudget = 64 * 1024 * 1024;
+    // Sprites are spread over shards by index, so threads drawing different sprites rarely wait on each other.
+    static constexpr size_t kNumShards = 16;
+    static constexpr size_t kShardMemoryBudget = kMemoryBudget / kNumShards;
+    // Rough size of the bookkeeping of a cached sprite.
+    static constexpr size_t kEntryOverhead = 128;
+
+    struct Entry
+    {
+        uint64_t Key;
+        std::shared_ptr<const MinifiedSprite> Sprite;
+        size_t Size;
+    };
+
+    struct Shard
+    {
+        std::mutex Mutex;
+        // Most recently used first.
+        std::list<Entry> Entries;
+        std::unordered_map<uint64_t, std::list<Entry>::iterator> Lookup;
+        size_t Size{};
+    };
+
+    static std::array<Shard, kNumShards> _shards;
+
+    static uint64_t GetKey(ImageIndex index, uint8_t zoom, uint8_t rowPhase)
+    {
+        return (static_cast<uint64_t>(index) << 16) | (zoom << 8) | rowPhase;
+    }
+
+    static Shard& GetShard(ImageIndex index)
+    {
+        return _shards[index % kNumShards];
+    }
+
+    static bool CanCache(ImageIndex index)
+    {
+        // Temporary and scrolling text images are replaced all the time.
+        if (index == SPR_TEMP)
+            return false;
+        return index < SPR_SCROLLING_TEXT_START || (index >= SPR_IMAGE_LIST_BEGIN && index < SPR_IMAGE_LIST_END);
+    }
+
+    static void RemoveEntry(Shard& shard, std::list<Entry>::iterator it)
+    {
+        shard.Size -= it->Size;
+        shard.Lookup.erase(it->Key);
+        shard.Entries.erase(it);
+    }
+
+    static std::shared_ptr<MinifiedSprite> Build(const G1Element& source, uint8_t zoom, uint8_t rowPhase)
+    {
+        const int32_t step = 1 << zoom;
+        const int32_t width = (source.width + step - 1) >> zoom;
+        const int32_t height = source.height > rowPhase ? (source.height - rowPhase + step - 1) >> zoom : 0;
+
+        auto sprite = std::make_shared<MinifiedSprite>();
+        sprite->Source = source.offset;
+        auto& data = sprite->Data;
+        data.resize(height * sizeof(uint16_t));
+
+        // Index 0 can appear inside runs and is drawn by blend modes that do not skip transparent pixels, so which
+        // pixels belong to a run is tracked apart from their value.
+        std::vector<uint8_t> sourceRow(source.width);
+        std::vector<bool> sourceDrawn(source.width);
+        std::vector<uint8_t> row(width);
+        std::vector<bool> drawn(width);
+        for (int32_t y = 0; y < height; y++)
+        {
+            // Unpack the source row.
+            std::fill(sourceDrawn.begin(), sourceDrawn.end(), false);
+            const auto sourceY = rowPhase + (y << zoom);
+            uint16_t lineOffset;
+            std::memcpy(&lineOffset, &source.offset[sourceY * sizeof(uint16_t)], sizeof(uint16_t));
+            const uint8_t* src = source.offset + lineOffset;
+            bool isEndOfLine = false;
+            while (!isEndOfLine)
+            {
+                auto dataSize = *src++;
+                auto firstPixelX = *src++;
+                isEndOfLine = (dataSize & 0x80) != 0;
+                dataSize &= 0x7F;
+                const auto numPixels = std::min<int32_t>(dataSize, source.width - firstPixelX);
+                if (numPixels > 0)
+                {
+                    std::memcpy(&sourceRow[firstPixelX], src, numPixels);
+                    std::fill_n(sourceDrawn.begin() + firstPixelX, numPixels, true);
+                }
+                src += dataSize;
+            }
+
+            for (int32_t x = 0; x < width; x++)
+            {
+                row[x] = sourceRow[x << zoom];
+                drawn[x] = sourceDrawn[x << zoom];
+            }
+
+            if (data.size() > UINT16_MAX)
+                return nullptr;
+            const auto offset = static_cast<uint16_t>(data.size());
+            std::memcpy(&data[y * sizeof(uint16_t)], &offset, sizeof(uint16_t));
+
+            // Pack the row again, leaving out the pixels that were not part of a run.
+            size_t lastChunk = SIZE_MAX;
+            for (int32_t x = 0; x < width;)
+            {
+                if (!drawn[x])
+                {
+                    x++;
+                    continue;
+                }
+
+                int32_t runLength = 0;
+                while (x + runLength < width && drawn[x + runLength] && runLength < 0x7F)
+                    runLength++;
+
+                lastChunk = data.size();
+                data.push_back(static_cast<uint8_t>(runLength));
+                data.push_back(static_cast<uint8_t>(x));
+                data.insert(data.end(), row.begin() + x, row.begin() + x + runLength);
+                x += runLength;
+            }
+            if (lastChunk == SIZE_MAX)
+            {
+                lastChunk = data.size();
+                data.push_back(0);
+                data.push_back(0);
+            }
+            data[lastChunk] |= 0x80;
+        }
+
+        sprite->Element.offset = data.data();
+        sprite->Element.width = width;
+        sprite->Element.height = height;
+        sprite->Element.flags = G1_FLAG_RLE_COMPRESSION;
+        return sprite;
+    }
+
+    std::shared_ptr<const MinifiedSprite> Get(ImageIndex index, const G1Element& source, uint8_t zoom, uint8_t rowPhase)
+    {
+        if (zoom == 0 || zoom > kMaxZoom || !CanCache(index) || !Config::Get().general.MinifiedSpriteCache)
+            return nullptr;
+
+        const auto key = GetKey(index, zoom, rowPhase);
+        auto& shard = GetShard(index);
+        {
+            std::lock_guard lock(shard.Mutex);
+            auto it = shard.Lookup.find(key);
+            if (it != shard.Lookup.end())
+            {
+                auto entryIt = it->second;
+                if (entryIt->Sprite->Source == source.offset)
+                {
+                    shard.Entries.splice(shard.Entries.begin(), shard.Entries, entryIt);
+                    return entryIt->Sprite;
+                }
+                RemoveEntry(shard, entryIt);
+            }
+        }
+
+        // Built without holding the lock, another thread may build the same sprite in the meantime.
+        auto sprite = Build(source, zoom, rowPhase);
+        if (sprite == nullptr)
+            return nullptr;
+
+        const auto size = sprite->Data.size() + kEntryOverhead;
+        std::lock_guard lock(shard.Mutex);
+        auto it = shard.Lookup.find(key);
+        if (it != shard.Lookup.end())
+            RemoveEntry(shard, it->second);
+
+        shard.Entries.push_front({ key, sprite, size });
+        shard.Lookup.emplace(key, shard.Entries.begin());
+        shard.Size += size;
+        while (shard.Size > kShardMemoryBudget && shard.Entries.size() > 1)
+        {
+            RemoveEntry(shard, std::prev(shard.Entries.end()));
+        }
+        return sprite;
+    }
+
+    void Invalidate(ImageIndex index)
+    {
+        auto& shard = GetShard(index);
+        std::lock_guard lock(shard.Mutex);
+        if (shard.Entries.empty())
+            return;
+
+        for (uint8_t zoom = 1; zoom <= kMaxZoom; zoom++)
+        {
+            for (uint8_t rowPhase = 0; rowPhase < (1 << zoom); rowPhase++)
+            {
+                auto it = shard.Lookup.find(GetKey(index, zoom, rowPhase));
+                if (it != shard.Lookup.end())
+                    RemoveEntry(shard, it->second);
+            }
+        }
+    }
+
+    void InvalidateAll()
+    {
+        for (auto& shard : _shards)
+        {
+            std::lock_guard lock(shard.Mutex);
+            shard.Entries.clear();
+            shard.Lookup.clear();
+            shard.Size = 0;
+        }
+    }
+} // namespace OpenRCT2::Drawing::SpriteMipCache
@@ -0,0 +1,43 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2025 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "Drawing.h"
+#include "ImageIndexType.h"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/**
+ * Keeps copies of RLE sprites with only the pixels drawn at a zoomed out level, so they can be drawn like unzoomed
+ * sprites instead of decoding every run of the full sprite. Copies are built on first use and the least recently used
+ * ones are dropped once the cache goes over its memory budget.
+ */
+namespace OpenRCT2::Drawing::SpriteMipCache
+{
+    struct MinifiedSprite
+    {
+        // The data of the sprite this was built from, to check the image has not been replaced since.
+        const uint8_t* Source{};
+        std::vector<uint8_t> Data;
+        G1Element Element;
+    };
+
+    /**
+     * Returns the RLE sprite holding the pixels drawn from source at zoom level 2^zoom, from the rows whose index
+     * modulo 2^zoom equals rowPhase. Returns nullptr if the image can not be cached or the cache is disabled.
+     */
+    std::shared_ptr<const MinifiedSprite> Get(ImageIndex index, const G1Element& source, uint8_t zoom, uint8_t rowPhase);
+
+    // Drops the copies of an image whose element is about to change.
+    void Invalidate(ImageIndex index);
+    void InvalidateAll();
+} // namespace OpenRCT2::Drawing::SpriteMipCache
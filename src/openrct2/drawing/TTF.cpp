@@ -11,7 +11,10 @@
 
     #include "../Diagnostic.h"
 
+    #include <array>
+    #include <list>
     #include <mutex>
+    #include <unordered_map>
     #pragma clang diagnostic push
     #pragma clang diagnostic ignored "-Wdocumentation"
     #include <ft2build.h>
@@ -25,6 +28,7 @@
     #include "../drawing/Font.h"
     #include "../localisation/LocalisationService.h"
     #include "../platform/Platform.h"
+    #include "../profiling/Profiling.h"
     #include "DrawingLock.hpp"
     #include "TTF.h"
 
@@ -32,45 +36,147 @@ using namespace OpenRCT2;
 
 static bool _ttfInitialised = false;
 
-constexpr int32_t kTTFSurfaceCacheSize = 256;
-constexpr int32_t kTTFGetWidthCacheSize = 1024;
+// Number of rendered strings kept when the font config does not set it, four times as many widths are kept.
+constexpr int32_t kTTFDefaultCacheSize = 1024;
+constexpr int32_t kTTFGetWidthCacheSizeFactor = 4;
+// Strings are spread over shards by hash, so threads drawing different text rarely wait on each other.
+constexpr size_t kTTFCacheShardCount = 16;
 
-struct ttf_cache_entry
-{
-    TTFSurface* surface;
-    TTF_Font* font;
-    u8string text;
-    uint32_t lastUseTick;
-};
+static TTFSurface* TTFRender(TTF_Font* font, std::string_view text);
+static bool TTFGetSize(TTF_Font* font, std::string_view text, int32_t* outWidth, int32_t* outHeight);
 
-struct ttf_getwidth_cache_entry
+/**
+ * Keeps the most recently used values computed for a font and string. Entries used during the current draw are never
+ * dropped, as other threads may still be drawing them, so a shard can go over its size until the next draw.
+ */
+template<typename TValue>
+class TTFCache
 {
-    uint32_t width;
-    TTF_Font* font;
-    u8string text;
-    uint32_t lastUseTick;
-};
+    struct Entry
+    {
+        TTF_Font* Font;
+        u8string Text;
+        uint32_t Hash;
+        TValue Value;
+        uint32_t LastUseTick;
+    };
+
+    struct Shard
+    {
+        std::mutex Mutex;
+        // Most recently used first.
+        std::list<Entry> Entries;
+        std::unordered_multimap<uint32_t, typename std::list<Entry>::iterator> Lookup;
+    };
+
+    std::array<Shard, kTTFCacheShardCount> _shards;
+    void (*const _dispose)(TValue);
+    Profiling::Counter _hits;
+    Profiling::Counter _misses;
+
+    static typename std::list<Entry>::iterator Find(Shard& shard, TTF_Font* font, std::string_view text, uint32_t hash)
+    {
+        auto [begin, end] = shard.Lookup.equal_range(hash);
+        for (auto it = begin; it != end; it++)
+        {
+            if (it->second->Font == font && String::equals(it->second->Text, text))
+                return it->second;
+        }
+        return shard.Entries.end();
+    }
+
+    void Remove(Shard& shard, typename std::list<Entry>::iterator entry)
+    {
+        auto [begin, end] = shard.Lookup.equal_range(entry->Hash);
+        for (auto it = begin; it != end; it++)
+        {
+            if (it->second == entry)
+            {
+                shard.Lookup.erase(it);
+                break;
+            }
+        }
+        if (_dispose != nullptr)
+            _dispose(entry->Value);
+        shard.Entries.erase(entry);
+    }
 
-static ttf_cache_entry _ttfSurfaceCache[kTTFSurfaceCacheSize] = {};
-static int32_t _ttfSurfaceCacheCount = 0;
-static int32_t _ttfSurfaceCacheHitCount = 0;
-static int32_t _ttfSurfaceCacheMissCount = 0;
+public:
+    TTFCache(void (*dispose)(TValue), const char* hitsName, const char* missesName)
+        : _dispose(dispose)
+        , _hits(hitsName)
+        , _misses(missesName)
+    {
+    }
 
-static ttf_getwidth_cache_entry _ttfGetWidthCache[kTTFGetWidthCacheSize] = {};
-static int32_t _ttfGetWidthCacheCount = 0;
-static int32_t _ttfGetWidthCacheHitCount = 0;
-static int32_t _ttfGetWidthCacheMissCount = 0;
+    bool TryGet(TTF_Font* font, std::string_view text, uint32_t hash, TValue& value)
+    {
+        auto& shard = _shards[hash % kTTFCacheShardCount];
+        DrawingUniqueLock<std::mutex> lock(shard.Mutex);
 
+        auto entry = Find(shard, font, text, hash);
+        if (entry == shard.Entries.end())
+        {
+            _misses.Increment();
+            return false;
+        }
+
+        _hits.Increment();
+        entry->LastUseTick = gCurrentDrawCount;
+        shard.Entries.splice(shard.Entries.begin(), shard.Entries, entry);
+        value = entry->Value;
+        return true;
+    }
+
+    // Adds a value computed after TryGet failed. If another thread added the same string in the meantime, the new
+    // value is disposed of and the existing one is returned.
+    TValue Add(TTF_Font* font, std::string_view text, uint32_t hash, TValue value, size_t size)
+    {
+        auto& shard = _shards[hash % kTTFCacheShardCount];
+        DrawingUniqueLock<std::mutex> lock(shard.Mutex);
+
+        auto existing = Find(shard, font, text, hash);
+        if (existing != shard.Entries.end())
+        {
+            if (_dispose != nullptr)
+                _dispose(value);
+            existing->LastUseTick = gCurrentDrawCount;
+            return existing->Value;
+        }
+
+        shard.Entries.push_front({ font, u8string(text), hash, value, gCurrentDrawCount });
+        shard.Lookup.emplace(hash, shard.Entries.begin());
+
+        const auto shardSize = std::max<size_t>(1, size / kTTFCacheShardCount);
+        while (shard.Entries.size() > shardSize && shard.Entries.back().LastUseTick != gCurrentDrawCount)
+        {
+            Remove(shard, std::prev(shard.Entries.end()));
+        }
+        return value;
+    }
+
+    void Clear()
+    {
+        for (auto& shard : _shards)
+        {
+            DrawingUniqueLock<std::mutex> lock(shard.Mutex);
+            while (!shard.Entries.empty())
+            {
+                Remove(shard, shard.Entries.begin());
+            }
+        }
+    }
+};
+
+static TTFCache<TTFSurface*> _ttfSurfaceCache(TTFFreeSurface, "TTF surface cache hits", "TTF surface cache misses");
+static TTFCache<uint32_t> _ttfGetWidthCache(nullptr, "TTF width cache hits", "TTF width cache misses");
+
+// Guards the fonts, FreeType can not be used from several threads with the same font.
 static std::mutex _mutex;
 
 static TTF_Font* TTFOpenFont(const utf8* fontPath, int32_t ptSize);
 static void TTFCloseFont(TTF_Font* font);
-static void TTFSurfaceCacheDispose(ttf_cache_entry* entry);
-static void TTFSurfaceCacheDisposeAll();
-static void TTFGetWidthCacheDisposeAll();
-static bool TTFGetSize(TTF_Font* font, std::string_view text, int32_t* outWidth, int32_t* outHeight);
 static void TTFToggleHinting(bool);
-static TTFSurface* TTFRender(TTF_Font* font, std::string_view text);
 
 static void TTFToggleHinting(bool)
 {
@@ -86,10 +192,7 @@ static void TTFToggleHinting(bool)
         TTF_SetFontHinting(fontDesc->font, use_hinting ? 1 : 0);
     }
 
-    if (_ttfSurfaceCacheCount)
-    {
-        TTFSurfaceCacheDisposeAll();
-    }
+    _ttfSurfaceCache.Clear();
 }
 
 bool TTFInitialise()
@@ -138,8 +241,8 @@ void TTFDispose()
     if (!_ttfInitialised)
         return;
 
-    TTFSurfaceCacheDisposeAll();
-    TTFGetWidthCacheDisposeAll();
+    _ttfSurfaceCache.Clear();
+    _ttfGetWidthCache.Clear();
 
     for (int32_t i = 0; i < FontStyleCount; i++)
     {
@@ -176,24 +279,10 @@ static uint32_t TTFSurfaceCacheHash(TTF_Font* font, std::string_view text)
     return hash;
 }
 
-static void TTFSurfaceCacheDispose(ttf_cache_entry* entry)
-{
-    if (entry->surface != nullptr)
-    {
-        TTFFreeSurface(entry->surface);
-        entry->text.clear();
-        entry->surface = nullptr;
-        entry->font = nullptr;
-    }
-}
-
-static void TTFSurfaceCacheDisposeAll()
+static size_t TTFGetCacheSize()
 {
-    for (int32_t i = 0; i < kTTFSurfaceCacheSize; i++)
-    {
-        TTFSurfaceCacheDispose(&_ttfSurfaceCache[i]);
-        _ttfSurfaceCacheCount--;
-    }
+    const auto size = Config::Get().fonts.CacheSize;
+    return size > 0 ? size : kTTFDefaultCacheSize;
 }
 
 void TTFToggleHinting()
@@ -204,132 +293,45 @@ void TTFToggleHinting()
 
 TTFSurface* TTFSurfaceCacheGetOrAdd(TTF_Font* font, std::string_view text)
 {
-    ttf_cache_entry* entry;
-
     uint32_t hash = TTFSurfaceCacheHash(font, text);
-    int32_t index = hash % kTTFSurfaceCacheSize;
 
-    DrawingUniqueLock<std::mutex> lock(_mutex);
+    TTFSurface* surface;
+    if (_ttfSurfaceCache.TryGet(font, text, hash, surface))
+        return surface;
 
-    for (int32_t i = 0; i < kTTFSurfaceCacheSize; i++)
     {
-        entry = &_ttfSurfaceCache[index];
-
-        // Check if entry is a hit
-        if (entry->surface == nullptr)
-            break;
-        if (entry->font == font && String::equals(entry->text, text))
-        {
-            _ttfSurfaceCacheHitCount++;
-            entry->lastUseTick = gCurrentDrawCount;
-            return entry->surface;
-        }
-
-        // If entry hasn't been used for a while, replace it
-        if (entry->lastUseTick < gCurrentDrawCount - 64)
-        {
-            break;
-        }
-
-        // Check if next entry is a hit
-        if (++index >= kTTFSurfaceCacheSize)
-            index = 0;
+        DrawingUniqueLock<std::mutex> lock(_mutex);
+        surface = TTFRender(font, text);
     }
-
-    // Cache miss, replace entry with new surface
-    entry = &_ttfSurfaceCache[index];
-    TTFSurfaceCacheDispose(entry);
-
-    TTFSurface* surface = TTFRender(font, text);
     if (surface == nullptr)
     {
         return nullptr;
     }
 
-    _ttfSurfaceCacheMissCount++;
-    // printf("CACHE HITS: %d   MISSES: %d)\n", _ttfSurfaceCacheHitCount, _ttfSurfaceCacheMissCount);
-
-    _ttfSurfaceCacheCount++;
-    entry->surface = surface;
-    entry->font = font;
-    entry->text = text;
-    entry->lastUseTick = gCurrentDrawCount;
-    return entry->surface;
-}
-
-static void TTFGetWidthCacheDispose(ttf_getwidth_cache_entry* entry)
-{
-    if (entry->text.empty())
-        return;
-
-    entry->text.clear();
-    entry->width = 0;
-    entry->font = nullptr;
-}
-
-static void TTFGetWidthCacheDisposeAll()
-{
-    for (int32_t i = 0; i < kTTFGetWidthCacheSize; i++)
-    {
-        TTFGetWidthCacheDispose(&_ttfGetWidthCache[i]);
-        _ttfGetWidthCacheCount--;
-    }
+    return _ttfSurfaceCache.Add(font, text, hash, surface, TTFGetCacheSize());
 }
 
 uint32_t TTFGetWidthCacheGetOrAdd(TTF_Font* font, std::string_view text)
 {
-    ttf_getwidth_cache_entry* entry;
-
     uint32_t hash = TTFSurfaceCacheHash(font, text);
-    int32_t index = hash % kTTFGetWidthCacheSize;
 
-    DrawingUniqueLock<std::mutex> lock(_mutex);
+    uint32_t width;
+    if (_ttfGetWidthCache.TryGet(font, text, hash, width))
+        return width;
 
-    for (int32_t i = 0; i < kTTFGetWidthCacheSize; i++)
+    int32_t measuredWidth, measuredHeight;
     {
-        entry = &_ttfGetWidthCache[index];
-
-        // Check if entry is a hit
-        if (entry->text.empty())
-            break;
-        if (entry->font == font && String::equals(entry->text, text))
-        {
-            _ttfGetWidthCacheHitCount++;
-            entry->lastUseTick = gCurrentDrawCount;
-            return entry->width;
-        }
-
-        // If entry hasn't been used for a while, replace it
-        if (entry->lastUseTick < gCurrentDrawCount - 64)
-        {
-            break;
-        }
-
-        // Check if next entry is a hit
-        if (++index >= kTTFGetWidthCacheSize)
-            index = 0;
+        DrawingUniqueLock<std::mutex> lock(_mutex);
+        TTFGetSize(font, text, &measuredWidth, &measuredHeight);
     }
 
-    // Cache miss, replace entry with new width
-    entry = &_ttfGetWidthCache[index];
-    TTFGetWidthCacheDispose(entry);
-
-    int32_t width, height;
-    TTFGetSize(font, text, &width, &height);
-
-    _ttfGetWidthCacheMissCount++;
-
-    _ttfGetWidthCacheCount++;
-    entry->width = width;
-    entry->font = font;
-    entry->text = text;
-    entry->lastUseTick = gCurrentDrawCount;
-    return entry->width;
+    width = static_cast<uint32_t>(measuredWidth);
+    return _ttfGetWidthCache.Add(font, text, hash, width, TTFGetCacheSize() * kTTFGetWidthCacheSizeFactor);
 }
 
 TTFFontDescriptor* TTFGetFontFromSpriteBase(FontStyle fontStyle)
 {
-    DrawingUniqueLock<std::mutex> lock(_mutex);
+    // The font set is only changed while nothing is being drawn.
     return &gCurrentTTFFontSet->size[EnumValue(fontStyle)];
 }
 
@@ -113,6 +113,11 @@ void X8WeatherDrawer::Restore(RenderTarget& rt)
     }
 }
 
+bool X8WeatherDrawer::HasPixels() const
+{
+    return _weatherPixelsCount > 0;
+}
+
 #ifdef __WARN_SUGGEST_FINAL_METHODS__
     #pragma GCC diagnostic push
     #pragma GCC diagnostic ignored "-Wsuggest-final-methods"
@@ -48,6 +48,7 @@ namespace OpenRCT2
                 RenderTarget& rt, int32_t x, int32_t y, int32_t width, int32_t height, int32_t xStart, int32_t yStart,
                 const uint8_t* weatherpattern) override;
             void Restore(RenderTarget& rt);
+            bool HasPixels() const;
         };
 
 #ifdef __WARN_SUGGEST_FINAL_TYPES__
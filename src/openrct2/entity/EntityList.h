@@ -14,10 +14,10 @@
 #include "EntityBase.h"
 #include "EntityRegistry.h"
 
-#include <list>
+#include <algorithm>
 #include <vector>
 
-const std::list<EntityId>& GetEntityList(const EntityType id);
+const std::vector<EntityId>& GetEntityList(const EntityType id);
 
 uint16_t GetEntityListCount(EntityType list);
 uint16_t GetMiscEntityCount();
@@ -98,18 +98,50 @@ public:
     }
 };
 
+/**
+ * Position within an entity list, the lists are kept sorted by Id. Entities may be added or
+ * removed while iterating, in which case iteration resumes after the last visited Id.
+ */
+class EntityListCursor
+{
+private:
+    const std::vector<EntityId>* list;
+    size_t index;
+    EntityId lastId = EntityId::GetNull();
+
+public:
+    EntityListCursor(const std::vector<EntityId>& _list, size_t _index)
+        : list(&_list)
+        , index(_index)
+    {
+    }
+
+    bool TryNext(EntityId& id)
+    {
+        if (index > 0 && (index > list->size() || (*list)[index - 1] != lastId))
+        {
+            // List was modified before our position.
+            index = std::upper_bound(list->begin(), list->end(), lastId) - list->begin();
+        }
+        if (index >= list->size())
+        {
+            return false;
+        }
+        id = lastId = (*list)[index++];
+        return true;
+    }
+};
+
 template<typename T>
 class EntityListIterator
 {
 private:
-    std::list<EntityId>::const_iterator iter;
-    std::list<EntityId>::const_iterator end;
+    EntityListCursor cursor;
     T* Entity = nullptr;
 
 public:
-    EntityListIterator(std::list<EntityId>::const_iterator _iter, std::list<EntityId>::const_iterator _end)
-        : iter(_iter)
-        , end(_end)
+    EntityListIterator(const std::vector<EntityId>& _list, size_t _index)
+        : cursor(_list, _index)
     {
         ++(*this);
     }
@@ -117,9 +149,10 @@ public:
     {
         Entity = nullptr;
 
-        while (iter != end && Entity == nullptr)
+        EntityId id;
+        while (Entity == nullptr && cursor.TryNext(id))
         {
-            Entity = TryGetEntity<T>(*iter++);
+            Entity = TryGetEntity<T>(id);
         }
         return *this;
     }
@@ -128,7 +161,7 @@ public:
     {
         EntityListIterator retval = *this;
         ++(*this);
-        return *iter;
+        return retval;
     }
     bool operator==(EntityListIterator other) const
     {
@@ -155,7 +188,7 @@ class EntityList
 {
 private:
     using EntityListIterator_t = EntityListIterator<T>;
-    const std::list<EntityId>& vec;
+    const std::vector<EntityId>& vec;
 
 public:
     EntityList()
@@ -165,10 +198,10 @@ public:
 
     EntityListIterator_t begin() const
     {
-        return EntityListIterator_t(std::cbegin(vec), std::cend(vec));
+        return EntityListIterator_t(vec, 0);
     }
     EntityListIterator_t end() const
     {
-        return EntityListIterator_t(std::cend(vec), std::cend(vec));
+        return EntityListIterator_t(vec, vec.size());
     }
 };
@@ -42,7 +42,8 @@
 using namespace OpenRCT2;
 using namespace OpenRCT2::Core;
 
-static std::array<std::list<EntityId>, EnumValue(EntityType::Count)> gEntityLists;
+// Dense per-type lists of entity ids, kept sorted by id so that iteration order is deterministic.
+static std::array<std::vector<EntityId>, EnumValue(EntityType::Count)> gEntityLists;
 static std::vector<EntityId> _freeIdList;
 
 static bool _entityFlashingList[kMaxEntities];
@@ -55,6 +56,11 @@ static constexpr uint32_t kSpatialIndexDirtyMask = 1u << 31;
 
 static std::array<std::vector<EntityId>, kSpatialIndexSize> gEntitySpatialIndex;
 
+// Entities that left their tile since the last spatial index update, the second list
+// is swapped in while the dirty entities are being processed.
+static std::vector<EntityId> _spatialIndexDirtyList;
+static std::vector<EntityId> _spatialIndexProcessingList;
+
 static void FreeEntity(EntityBase& entity);
 
 static constexpr uint32_t ComputeSpatialIndex(const CoordsXY& loc)
@@ -154,7 +160,7 @@ static void ResetFreeIds()
     });
 }
 
-const std::list<EntityId>& GetEntityList(const EntityType id)
+const std::vector<EntityId>& GetEntityList(const EntityType id)
 {
     return gEntityLists[EnumValue(id)];
 }
@@ -211,6 +217,7 @@ void ResetEntitySpatialIndices()
     {
         vec.clear();
     }
+    _spatialIndexDirtyList.clear();
     for (EntityId::UnderlyingType i = 0; i < kMaxEntities; i++)
     {
         auto* entity = GetEntity(EntityId::FromUnderlying(i));
@@ -462,17 +469,19 @@ static void UpdateEntitySpatialIndex(EntityBase& entity)
 
 void UpdateEntitiesSpatialIndex()
 {
-    for (auto& entityList : gEntityLists)
+    std::swap(_spatialIndexDirtyList, _spatialIndexProcessingList);
+
+    // The list may contain entities that have since been removed, re-created or already
+    // re-indexed, UpdateEntitySpatialIndex only acts on entities still marked dirty.
+    for (auto entityId : _spatialIndexProcessingList)
     {
-        for (auto& entityId : entityList)
+        auto* entity = TryGetEntity(entityId);
+        if (entity != nullptr && entity->Type != EntityType::Null)
         {
-            auto* entity = TryGetEntity(entityId);
-            if (entity != nullptr && entity->Type != EntityType::Null)
-            {
-                UpdateEntitySpatialIndex(*entity);
-            }
+            UpdateEntitySpatialIndex(*entity);
         }
     }
+    _spatialIndexProcessingList.clear();
 }
 
 CoordsXYZ EntityBase::GetLocation() const
@@ -506,6 +515,7 @@ void EntityBase::SetLocation(const CoordsXYZ& newLocation)
     }
 
     SpatialIndex |= kSpatialIndexDirtyMask;
+    _spatialIndexDirtyList.push_back(Id);
 }
 
 static void EntitySetCoordinates(const CoordsXYZ& entityPos, EntityBase* entity)
@@ -16,7 +16,8 @@
 
 namespace OpenRCT2
 {
-    union Entity_t
+    // Aligned to cache lines, so the fields entities group by how often they are used fall into the same lines.
+    union alignas(64) Entity_t
     {
         uint8_t Pad00[0x200];
         EntityBase base;
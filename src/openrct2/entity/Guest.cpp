@@ -62,7 +62,9 @@
 #include "../world/Location.hpp"
 #include "../world/Map.h"
 #include "../world/Park.h"
+#include "../world/RideProximityIndex.h"
 #include "../world/Scenery.h"
+#include "../world/SurroundingsIndex.h"
 #include "../world/TileElementsView.h"
 #include "../world/tile_element/EntranceElement.h"
 #include "../world/tile_element/LargeSceneryElement.h"
@@ -1874,6 +1876,17 @@ static void GuestPickRideToGoOn(Guest& guest)
     }
 }
 
+/**
+ * Marks every ride with track within 10 tiles of the guest.
+ */
+static void GuestFindNearbyRides(const Guest& guest, OpenRCT2::BitSet<OpenRCT2::Limits::kMaxRidesInPark>& rides)
+{
+    constexpr auto kSearchRadius = 10;
+    const auto centre = TileCoordsXY(CoordsXY{ floor2(guest.x, kCoordsXYStep), floor2(guest.y, kCoordsXYStep) });
+    OpenRCT2::RideProximityIndex::QueryRides(
+        rides, { centre.x - kSearchRadius, centre.y - kSearchRadius }, { centre.x + kSearchRadius, centre.y + kSearchRadius });
+}
+
 static OpenRCT2::BitSet<OpenRCT2::Limits::kMaxRidesInPark> GuestFindRidesToGoOn(Guest& guest)
 {
     OpenRCT2::BitSet<OpenRCT2::Limits::kMaxRidesInPark> rideConsideration;
@@ -1895,27 +1908,7 @@ static OpenRCT2::BitSet<OpenRCT2::Limits::kMaxRidesInPark> GuestFindRidesToGoOn(
     else
     {
         // Take nearby rides into consideration
-        constexpr auto radius = 10 * 32;
-        int32_t cx = floor2(guest.x, 32);
-        int32_t cy = floor2(guest.y, 32);
-        for (int32_t tileX = cx - radius; tileX <= cx + radius; tileX += kCoordsXYStep)
-        {
-            for (int32_t tileY = cy - radius; tileY <= cy + radius; tileY += kCoordsXYStep)
-            {
-                auto location = CoordsXY{ tileX, tileY };
-                if (!MapIsLocationValid(location))
-                    continue;
-
-                for (auto* trackElement : TileElementsView<TrackElement>(location))
-                {
-                    auto rideIndex = trackElement->GetRideIndex();
-                    if (!rideIndex.IsNull())
-                    {
-                        rideConsideration[rideIndex.ToUnderlying()] = true;
-                    }
-                }
-            }
-        }
+        GuestFindNearbyRides(guest, rideConsideration);
 
         // Always take the tall rides into consideration (realistic as you can usually see them from anywhere in the park)
         for (auto& ride : GetRideManager())
@@ -2952,89 +2945,43 @@ static PeepThoughtType GuestAssessSurroundings(int16_t centre_x, int16_t centre_
     if ((TileElementHeight({ centre_x, centre_y })) > centre_z)
         return PeepThoughtType::None;
 
-    uint16_t num_scenery = 0;
-    uint16_t num_fountains = 0;
-    uint16_t nearby_music = 0;
-    uint16_t num_rubbish = 0;
-
-    // TODO: Refactor this to step as tiles, 160 units is 5 tiles.
-    int16_t initial_x = std::max(centre_x - 160, 0);
-    int16_t initial_y = std::max(centre_y - 160, 0);
-    int16_t final_x = std::min(centre_x + 160, kMaximumMapSizeBig);
-    int16_t final_y = std::min(centre_y + 160, kMaximumMapSizeBig);
+    // Look at the 10x10 tiles around the guest, 160 units is 5 tiles.
+    const auto centreTile = TileCoordsXY(CoordsXY{ centre_x, centre_y });
+    const auto minTile = TileCoordsXY{ centreTile.x - 5, centreTile.y - 5 };
+    const auto maxTile = TileCoordsXY{ centreTile.x + 4, centreTile.y + 4 };
 
-    for (int16_t x = initial_x; x < final_x; x += kCoordsXYStep)
-    {
-        for (int16_t y = initial_y; y < final_y; y += kCoordsXYStep)
-        {
-            for (auto* tileElement : TileElementsView(CoordsXY{ x, y }))
-            {
-                if (tileElement->IsGhost())
-                {
-                    continue;
-                }
-
-                switch (tileElement->GetType())
-                {
-                    case TileElementType::Path:
-                    {
-                        if (!tileElement->AsPath()->HasAddition())
-                            break;
-
-                        auto* pathAddEntry = tileElement->AsPath()->GetAdditionEntry();
-                        if (pathAddEntry == nullptr)
-                        {
-                            return PeepThoughtType::None;
-                        }
-                        if (tileElement->AsPath()->AdditionIsGhost())
-                            break;
+    const auto counts = OpenRCT2::SurroundingsIndex::Query(minTile, maxTile);
+    if (counts.missingAdditions != 0)
+        return PeepThoughtType::None;
 
-                        if (pathAddEntry->flags
-                            & (PATH_ADDITION_FLAG_JUMPING_FOUNTAIN_WATER | PATH_ADDITION_FLAG_JUMPING_FOUNTAIN_SNOW))
-                        {
-                            num_fountains++;
-                            break;
-                        }
-                        if (tileElement->AsPath()->IsBroken())
-                        {
-                            num_rubbish++;
-                        }
-                        break;
-                    }
-                    case TileElementType::LargeScenery:
-                    case TileElementType::SmallScenery:
-                        num_scenery++;
-                        break;
-                    case TileElementType::Track:
-                    {
-                        auto* ride = GetRide(tileElement->AsTrack()->GetRideIndex());
-                        if (ride == nullptr)
-                            break;
+    uint32_t num_scenery = counts.scenery;
+    uint32_t num_fountains = counts.fountains;
+    uint32_t num_rubbish = counts.brokenAdditions;
+    uint16_t nearby_music = 0;
 
-                        bool isPlayingMusic = ride->lifecycleFlags & RIDE_LIFECYCLE_MUSIC && ride->status != RideStatus::closed
-                            && !(ride->lifecycleFlags & (RIDE_LIFECYCLE_BROKEN_DOWN | RIDE_LIFECYCLE_CRASHED));
-                        if (!isPlayingMusic)
-                            break;
+    OpenRCT2::BitSet<OpenRCT2::Limits::kMaxRidesInPark> nearbyRides;
+    OpenRCT2::RideProximityIndex::QueryRides(nearbyRides, minTile, maxTile, false);
+    for (const auto& ride : GetRideManager())
+    {
+        if (!nearbyRides[ride.id.ToUnderlying()])
+            continue;
 
-                        const auto* musicObject = ride->getMusicObject();
-                        if (musicObject == nullptr)
-                            break;
+        bool isPlayingMusic = ride.lifecycleFlags & RIDE_LIFECYCLE_MUSIC && ride.status != RideStatus::closed
+            && !(ride.lifecycleFlags & (RIDE_LIFECYCLE_BROKEN_DOWN | RIDE_LIFECYCLE_CRASHED));
+        if (!isPlayingMusic)
+            continue;
 
-                        if (musicObject->GetNiceFactor() == MusicNiceFactor::Nice)
-                        {
-                            nearby_music |= 1;
-                        }
-                        else if (musicObject->GetNiceFactor() == MusicNiceFactor::Overbearing)
-                        {
-                            nearby_music |= 2;
-                        }
+        const auto* musicObject = ride.getMusicObject();
+        if (musicObject == nullptr)
+            continue;
 
-                        break;
-                    }
-                    default:
-                        break;
-                }
-            }
+        if (musicObject->GetNiceFactor() == MusicNiceFactor::Nice)
+        {
+            nearby_music |= 1;
+        }
+        else if (musicObject->GetNiceFactor() == MusicNiceFactor::Overbearing)
+        {
+            nearby_music |= 2;
         }
     }
 
@@ -3198,29 +3145,13 @@ static void PeepHeadForNearestRide(Guest& guest, bool considerOnlyCloseRides, T
     else
     {
         // Take nearby rides into consideration
-        constexpr auto kSearchRadius = 10 * 32;
-        int32_t cx = floor2(guest.x, 32);
-        int32_t cy = floor2(guest.y, 32);
-        for (auto x = cx - kSearchRadius; x <= cx + kSearchRadius; x += kCoordsXYStep)
+        OpenRCT2::BitSet<OpenRCT2::Limits::kMaxRidesInPark> nearbyRides;
+        GuestFindNearbyRides(guest, nearbyRides);
+        for (const auto& ride : GetRideManager())
         {
-            for (auto y = cy - kSearchRadius; y <= cy + kSearchRadius; y += kCoordsXYStep)
+            if (nearbyRides[ride.id.ToUnderlying()] && predicate(ride))
             {
-                auto location = CoordsXY{ x, y };
-                if (!MapIsLocationValid(location))
-                    continue;
-
-                for (auto* trackElement : TileElementsView<TrackElement>(location))
-                {
-                    auto rideIndex = trackElement->GetRideIndex();
-                    auto ride = GetRide(rideIndex);
-                    if (ride == nullptr)
-                        continue;
-
-                    if (!predicate(*ride))
-                        continue;
-
-                    rideConsideration[ride->id.ToUnderlying()] = true;
-                }
+                rideConsideration[ride.id.ToUnderlying()] = true;
             }
         }
     }
@@ -6410,6 +6341,7 @@ static void GuestUpdateWalkingBreakScenery(Guest& guest)
     }
 
     tileElement->SetIsBroken(true);
+    OpenRCT2::SurroundingsIndex::InvalidateTile(TileCoordsXY(guest.NextLoc));
 
     MapInvalidateTileZoom1({ guest.NextLoc, tileElement->GetBaseZ(), tileElement->GetBaseZ() + 32 });
 
@@ -261,6 +261,11 @@ struct Guest : Peep
     static constexpr auto cEntityType = EntityType::Guest;
 
 public:
+    // Updated every tick, kept at the start of the guest data next to each other.
+    RideId PreviousRide;
+    uint16_t PreviousRideTimeOut;
+    std::array<PeepThought, kPeepMaxThoughts> Thoughts;
+
     uint8_t GuestNumRides;
     EntityId GuestNextInQueue;
     int32_t ParkEntryTime;
@@ -292,9 +297,6 @@ public:
     RideId Photo4RideRef;
 
     int8_t RejoinQueueTimeout; // whilst waiting for a free vehicle (or pair) in the entrance
-    RideId PreviousRide;
-    uint16_t PreviousRideTimeOut;
-    std::array<PeepThought, kPeepMaxThoughts> Thoughts;
     // 0x3F Litter Count split into lots of 3 with time, 0xC0 Time since last recalc
     uint8_t LitterCount;
     // 0x3F Sick Count split into lots of 3 with time, 0xC0 Time since last recalc
@@ -422,6 +424,16 @@ void UpdateRideApproachVehicleWaypointsMotionSimulator(Guest&, const CoordsXY&,
 void UpdateRideApproachVehicleWaypointsDefault(Guest&, const CoordsXY&, int16_t&);
 
 static_assert(sizeof(Guest) <= 512);
+// The guest fields updated every tick have to share a single cache line, next to the first one of the peep.
+#ifdef __GNUC__
+    #pragma GCC diagnostic push
+    #pragma GCC diagnostic ignored "-Winvalid-offsetof"
+#endif
+static_assert(offsetof(Guest, PreviousRide) == sizeof(Peep));
+static_assert(offsetof(Guest, PreviousRide) / 64 == (offsetof(Guest, Thoughts) + sizeof(Guest::Thoughts) - 1) / 64);
+#ifdef __GNUC__
+    #pragma GCC diagnostic pop
+#endif
 
 enum
 {
@@ -10,6 +10,7 @@
 #include "PatrolArea.h"
 
 #include "../core/Algorithm.hpp"
+#include "../paint/PaintCache.h"
 #include "EntityList.h"
 #include "Staff.h"
 
@@ -172,12 +173,22 @@ void ClearPatrolAreaToRender()
     SetPatrolAreaToRender(EntityId::GetNull());
 }
 
+static void UpdatePatrolAreaToRender(std::variant<StaffType, EntityId> patrolArea)
+{
+    if (_patrolAreaToRender != patrolArea)
+    {
+        _patrolAreaToRender = patrolArea;
+        // The patrol area is drawn on the land of the tiles.
+        PaintCache::InvalidateAll();
+    }
+}
+
 void SetPatrolAreaToRender(EntityId staffId)
 {
-    _patrolAreaToRender = staffId;
+    UpdatePatrolAreaToRender(std::variant<StaffType, EntityId>(staffId));
 }
 
 void SetPatrolAreaToRender(StaffType staffType)
 {
-    _patrolAreaToRender = staffType;
+    UpdatePatrolAreaToRender(std::variant<StaffType, EntityId>(staffType));
 }
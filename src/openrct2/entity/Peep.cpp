@@ -209,6 +209,8 @@ void PeepUpdateAll()
     constexpr auto kTicks128Mask = 128u - 1u;
     const auto currentTicksMasked = currentTicks & kTicks128Mask;
 
+    PathFinding::SpeculateGuestSearches();
+
     uint32_t index = 0;
     // Warning this loop can delete peeps
     for (auto peep : EntityList<Guest>())
@@ -227,6 +229,8 @@ void PeepUpdateAll()
         index++;
     }
 
+    PathFinding::ClearGuestSearches();
+
     for (auto staff : EntityList<Staff>())
     {
         if ((index & kTicks128Mask) == currentTicksMasked)
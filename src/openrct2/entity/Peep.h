@@ -17,6 +17,7 @@
 #include "../world/Location.hpp"
 
 #include <array>
+#include <cstddef>
 #include <optional>
 #include <string>
 #include <string_view>
@@ -292,9 +293,9 @@ struct Staff;
 
 struct Peep : EntityBase
 {
-    char* Name;
-    CoordsXYZ NextLoc;
-    uint8_t NextFlags;
+    // Fields touched by Update() on every tick are grouped first so they share a cache line with
+    // EntityBase; the rest is mostly used by the periodic updates, pathfinding and the UI.
+    uint32_t PeepFlags;
     PeepState State;
     union
     {
@@ -303,6 +304,19 @@ struct Peep : EntityBase
         PeepRideSubState RideSubState;
         PeepUsingBinSubState UsingBinSubState;
     };
+    uint8_t NextFlags;
+    PeepActionType Action;
+    uint8_t StepProgress;
+    uint8_t Energy;
+    uint8_t EnergyTarget;
+    uint8_t WindowInvalidateFlags;
+    uint8_t AnimationFrameNum;
+    uint8_t AnimationImageIdOffset;
+    PeepAnimationType AnimationType;
+    uint8_t WalkingAnimationFrameNum;
+
+    char* Name;
+    CoordsXYZ NextLoc;
     ObjectEntryIndex AnimationObjectIndex;
     PeepAnimationGroup AnimationGroup;
     uint8_t TshirtColour;
@@ -311,10 +325,7 @@ struct Peep : EntityBase
     uint16_t DestinationY;
     uint8_t DestinationTolerance; // How close to destination before next action/state 0 = exact
     uint8_t Var37;
-    uint8_t Energy;
-    uint8_t EnergyTarget;
     uint8_t Mass;
-    uint8_t WindowInvalidateFlags;
     RideId CurrentRide;
     StationIndex CurrentRideStation;
     uint8_t CurrentTrain;
@@ -334,14 +345,9 @@ struct Peep : EntityBase
     };
     // Normally 0, 1 for carrying sliding board on spiral slide ride, 2 for carrying lawn mower
     uint8_t SpecialSprite;
-    PeepAnimationType AnimationType;
     // Seems to be used like a local variable, as it's always set before calling SwitchNextAnimationType, which
     // reads this again
     PeepAnimationType NextAnimationType;
-    uint8_t AnimationImageIdOffset;
-    PeepActionType Action;
-    uint8_t AnimationFrameNum;
-    uint8_t StepProgress;
     union
     {
         uint8_t MazeLastEdge;
@@ -352,8 +358,6 @@ struct Peep : EntityBase
     uint8_t PathCheckOptimisation; // see peep.checkForPath
     TileCoordsXYZD PathfindGoal;
     std::array<TileCoordsXYZD, 4> PathfindHistory;
-    uint8_t WalkingAnimationFrameNum;
-    uint32_t PeepFlags;
 
 public: // Peep
     std::optional<CoordsXY> UpdateAction(int16_t& xy_distance);
@@ -414,6 +418,17 @@ protected:
     uint32_t GetStepsToTake() const;
 };
 
+// The fields updated every tick have to stay within the first cache line of the entity slot.
+#ifdef __GNUC__
+    #pragma GCC diagnostic push
+    #pragma GCC diagnostic ignored "-Winvalid-offsetof"
+#endif
+static_assert(offsetof(Peep, PeepFlags) == sizeof(EntityBase));
+static_assert(offsetof(Peep, WalkingAnimationFrameNum) + sizeof(Peep::WalkingAnimationFrameNum) <= 64);
+#ifdef __GNUC__
+    #pragma GCC diagnostic pop
+#endif
+
 enum
 {
     PATHING_DESTINATION_REACHED = 1 << 0,
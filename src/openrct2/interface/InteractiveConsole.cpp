@@ -1674,6 +1674,25 @@ static void ConsoleCommandProfilerExportCSV(
     console.WriteFormatLine("Wrote file CSV file: \"%s\"", csvFilePath.c_str());
 }
 
+static void ConsoleCommandProfilerExportTrace(
+    [[maybe_unused]] InteractiveConsole& console, [[maybe_unused]] const arguments_t& argv)
+{
+    if (argv.size() < 1)
+    {
+        console.WriteLineError("Missing argument: <file path>");
+        return;
+    }
+
+    const auto& traceFilePath = argv[0];
+    if (!OpenRCT2::Profiling::ExportChromeTrace(traceFilePath))
+    {
+        console.WriteFormatLine("Unable to export trace file to %s", traceFilePath.c_str());
+        return;
+    }
+
+    console.WriteFormatLine("Wrote trace file: \"%s\"", traceFilePath.c_str());
+}
+
 static void ConsoleCommandProfilerStop([[maybe_unused]] InteractiveConsole& console, [[maybe_unused]] const arguments_t& argv)
 {
     if (OpenRCT2::Profiling::IsEnabled())
@@ -1813,6 +1832,8 @@ static constexpr ConsoleCommand console_command_table[] = {
     { "profiler_stop", ConsoleCommandProfilerStop, "Stops the profiler.", "profiler_stop [<output file>]" },
     { "profiler_exportcsv", ConsoleCommandProfilerExportCSV, "Exports the current profiler data.",
       "profiler_exportcsv <output file>" },
+    { "profiler_exporttrace", ConsoleCommandProfilerExportTrace,
+      "Exports the recorded call timeline as a Chrome trace / Perfetto JSON file.", "profiler_exporttrace <output file>" },
 };
 
 static void ConsoleCommandWindows(InteractiveConsole& console, [[maybe_unused]] const arguments_t& argv)
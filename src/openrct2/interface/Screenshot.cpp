@@ -24,6 +24,7 @@
 #include "../core/Imaging.h"
 #include "../core/Path.hpp"
 #include "../core/String.hpp"
+#include "../core/TaskScheduler.h"
 #include "../drawing/Drawing.h"
 #include "../drawing/X8DrawingEngine.h"
 #include "../localisation/Formatter.h"
@@ -32,15 +33,20 @@
 #include "../world/Climate.h"
 #include "../world/Map.h"
 #include "../world/Park.h"
+#include "../world/TileHeightMap.h"
 #include "../world/tile_element/SurfaceElement.h"
 #include "Viewport.h"
 
+#include <array>
 #include <cctype>
 #include <chrono>
 #include <cstdlib>
+#include <cstring>
+#include <exception>
 #include <memory>
 #include <optional>
 #include <string>
+#include <vector>
 
 using namespace std::literals::string_literals;
 using namespace OpenRCT2;
@@ -52,6 +58,9 @@ extern uint8_t gClipHeight;
 
 uint8_t gScreenshotCountdown = 0;
 
+// Rows of a rendered image held in memory at a time, see RenderViewportToFile.
+static constexpr int32_t kScreenshotBandHeight = 512;
+
 static bool WriteDpiToFile(std::string_view path, const RenderTarget& rt, const GamePalette& palette)
 {
     auto const pixels8 = rt.bits;
@@ -192,6 +201,9 @@ std::string ScreenshotDumpPNG(RenderTarget& rt)
 
 static int32_t GetHighestBaseClearanceZ(const CoordsXY& location, const bool useViewClipping)
 {
+    if (!useViewClipping)
+        return TileHeightMap::GetTileMaxZ(TileCoordsXY(location));
+
     int32_t z = 0;
     auto element = MapGetFirstElementAt(location);
     if (element != nullptr)
@@ -227,34 +239,6 @@ static int32_t GetTallestVisibleTileTop(
     return minViewY - 64;
 }
 
-static RenderTarget CreateDPI(const Viewport& viewport)
-{
-    RenderTarget rt;
-    rt.width = viewport.width;
-    rt.height = viewport.height;
-    rt.bits = new (std::nothrow) uint8_t[rt.width * rt.height];
-    if (rt.bits == nullptr)
-    {
-        throw std::runtime_error("Giant screenshot failed, unable to allocate memory for image.");
-    }
-
-    if (viewport.flags & VIEWPORT_FLAG_TRANSPARENT_BACKGROUND)
-    {
-        std::memset(rt.bits, PaletteIndex::pi0, static_cast<size_t>(rt.width) * rt.height);
-    }
-
-    return rt;
-}
-
-static void ReleaseDPI(RenderTarget& rt)
-{
-    if (rt.bits != nullptr)
-        delete[] rt.bits;
-    rt.bits = nullptr;
-    rt.width = 0;
-    rt.height = 0;
-}
-
 static Viewport GetGiantViewport(int32_t rotation, ZoomLevel zoom)
 {
     auto& gameState = getGameState();
@@ -305,29 +289,103 @@ static Viewport GetGiantViewport(int32_t rotation, ZoomLevel zoom)
     return viewport;
 }
 
-static void RenderViewport(IDrawingEngine* drawingEngine, const Viewport& viewport, RenderTarget& rt)
+/**
+ * Renders the viewport to a PNG in bands of rows, so only a few bands are held in memory rather than the whole image.
+ * Each band is painted with its columns spread over the task scheduler like the game view, and written to the file on
+ * another task while the next band is painted.
+ */
+static void RenderViewportToFile(std::string_view path, const Viewport& viewport)
 {
     // Ensure sprites appear regardless of rotation
     ResetAllSpriteQuadrantPlacements();
 
-    std::unique_ptr<X8DrawingEngine> tempDrawingEngine;
-    if (drawingEngine == nullptr)
+    Image header;
+    header.Width = viewport.width;
+    header.Height = viewport.height;
+    header.Depth = 8;
+    header.Palette = gPalette;
+    Imaging::PngWriter writer(path, header);
+
+    const auto width = static_cast<size_t>(viewport.width);
+    const auto bandHeight = std::clamp(viewport.height, 1, kScreenshotBandHeight);
+    std::array<std::vector<uint8_t>, 2> bands;
+    for (auto& band : bands)
+    {
+        band.resize(width * bandHeight);
+    }
+
+    std::optional<TaskGroup> writeTasks;
+    if (Config::Get().general.MultiThreading)
     {
-        tempDrawingEngine = std::make_unique<X8DrawingEngine>(GetContext()->GetUiContext());
-        drawingEngine = tempDrawingEngine.get();
+        writeTasks.emplace();
     }
+    std::exception_ptr writeError;
+
+    X8DrawingEngine drawingEngine(GetContext()->GetUiContext());
+    drawingEngine.BeginDraw();
 
-    tempDrawingEngine->BeginDraw();
+    size_t bandIndex = 0;
+    for (int32_t y = 0; y < viewport.height; y += bandHeight, bandIndex ^= 1)
+    {
+        const auto numRows = std::min(bandHeight, viewport.height - y);
+        auto* bits = bands[bandIndex].data();
+        std::memset(bits, PaletteIndex::pi0, width * numRows);
 
-    rt.DrawingEngine = drawingEngine;
-    ViewportRender(rt, &viewport);
+        RenderTarget rt;
+        rt.DrawingEngine = &drawingEngine;
+        rt.bits = bits;
+        rt.x = 0;
+        rt.y = y;
+        rt.width = viewport.width;
+        rt.height = numRows;
+        ViewportRender(rt, &viewport);
 
-    tempDrawingEngine->EndDraw();
+        auto writeBand = [&writer, &writeError, bits, numRows, width]() {
+            try
+            {
+                writer.WriteRows(bits, numRows, static_cast<uint32_t>(width));
+            }
+            catch (...)
+            {
+                writeError = std::current_exception();
+            }
+        };
+
+        if (writeTasks.has_value())
+        {
+            // The other band is painted next, the previous one has to be written by then.
+            writeTasks->Wait();
+            if (writeError == nullptr)
+            {
+                // Not a background task, those are capped and may all be taken by long running jobs.
+                writeTasks->Run(writeBand);
+            }
+        }
+        else
+        {
+            writeBand();
+        }
+        if (writeError != nullptr)
+        {
+            break;
+        }
+    }
+
+    drawingEngine.EndDraw();
+
+    if (writeTasks.has_value())
+    {
+        writeTasks->Wait();
+    }
+    if (writeError != nullptr)
+    {
+        std::rethrow_exception(writeError);
+    }
+    writer.Finish();
 }
 
 void ScreenshotGiant()
 {
-    RenderTarget rt{};
     try
     {
         auto path = ScreenshotGetNextPath();
@@ -355,10 +413,7 @@ void ScreenshotGiant()
             viewport.flags |= VIEWPORT_FLAG_TRANSPARENT_BACKGROUND;
         }
 
-        rt = CreateDPI(viewport);
-
-        RenderViewport(nullptr, viewport, rt);
-        WriteDpiToFile(path.value(), rt, gPalette);
+        RenderViewportToFile(path.value(), viewport);
 
         // Show user that screenshot saved successfully
         const auto filename = Path::GetFileName(path.value());
@@ -372,8 +427,6 @@ void ScreenshotGiant()
         LOG_ERROR("%s", e.what());
         ContextShowError(STR_SCREENSHOT_FAILED, kStringIdNone, {}, true);
     }
-
-    ReleaseDPI(rt);
 }
 
 static void ApplyOptions(const ScreenshotOptions* options, Viewport& viewport)
@@ -446,7 +499,6 @@ int32_t CommandLineForScreenshot(const char** argv, int32_t argc, ScreenshotOpti
     }
 
     int32_t exitCode = 1;
-    RenderTarget rt;
     try
     {
         bool customLocation = false;
@@ -549,17 +601,13 @@ int32_t CommandLineForScreenshot(const char** argv, int32_t argc, ScreenshotOpti
 
         ApplyOptions(options, viewport);
 
-        rt = CreateDPI(viewport);
-
-        RenderViewport(nullptr, viewport, rt);
-        WriteDpiToFile(outputPath, rt, gPalette);
+        RenderViewportToFile(outputPath, viewport);
     }
     catch (const std::exception& e)
     {
         std::printf("%s\n", e.what());
         exitCode = -1;
     }
-    ReleaseDPI(rt);
 
     DrawingEngineDispose();
 
@@ -642,8 +690,5 @@ void CaptureImage(const CaptureOptions& options)
     }
 
     auto outputPath = ResolveFilenameForCapture(options.Filename);
-    auto rt = CreateDPI(viewport);
-    RenderViewport(nullptr, viewport, rt);
-    WriteDpiToFile(outputPath, rt, gPalette);
-    ReleaseDPI(rt);
+    RenderViewportToFile(outputPath, viewport);
 }
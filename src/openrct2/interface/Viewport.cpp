@@ -17,8 +17,8 @@
 #include "../OpenRCT2.h"
 #include "../config/Config.h"
 #include "../core/Guard.hpp"
-#include "../core/JobPool.h"
 #include "../core/Numerics.hpp"
+#include "../core/TaskScheduler.h"
 #include "../drawing/Drawing.h"
 #include "../drawing/IDrawingEngine.h"
 #include "../entity/EntityList.h"
@@ -30,6 +30,7 @@
 #include "../object/SmallSceneryEntry.h"
 #include "../object/WallSceneryEntry.h"
 #include "../paint/Paint.h"
+#include "../paint/PaintCache.h"
 #include "../profiling/Profiling.h"
 #include "../ride/Ride.h"
 #include "../ride/RideData.h"
@@ -48,6 +49,7 @@
 
 #include <cstring>
 #include <list>
+#include <optional>
 #include <unordered_map>
 
 namespace OpenRCT2
@@ -68,7 +70,6 @@ namespace OpenRCT2
     static std::list<Viewport> _viewports;
     Viewport* g_music_tracking_viewport;
 
-    static std::unique_ptr<JobPool> _paintJobs;
     static std::vector<PaintSession*> _paintColumns;
 
     InteractionInfo::InteractionInfo(const PaintStruct* ps)
@@ -80,7 +81,7 @@ namespace OpenRCT2
     }
 
     static void ViewportPaintWeatherGloom(RenderTarget& rt);
-    static void ViewportPaint(const Viewport* viewport, RenderTarget& rt);
+    static void ViewportPaint(const Viewport* viewport, RenderTarget& rt, bool retainPaint);
     static void ViewportUpdateFollowSprite(WindowBase* window);
     static void ViewportUpdateSmartFollowEntity(WindowBase* window);
     static void ViewportUpdateSmartFollowStaff(WindowBase* window, const Staff& peep);
@@ -237,6 +238,12 @@ namespace OpenRCT2
         _viewports.erase(it);
     }
 
+    // Viewports created for windows, as opposed to ones set up for a single render such as a screenshot.
+    static bool ViewportIsWindowViewport(const Viewport* viewport)
+    {
+        return std::any_of(_viewports.begin(), _viewports.end(), [viewport](const auto& vp) { return &vp == viewport; });
+    }
+
     static Viewport* ViewportGetMain()
     {
         auto mainWindow = WindowGetMain();
@@ -917,7 +924,7 @@ namespace OpenRCT2
      *  edi: dpi
      *  ebp: bottom
      */
-    void ViewportRender(RenderTarget& rt, const Viewport* viewport)
+    void ViewportRender(RenderTarget& rt, const Viewport* viewport, bool retainPaint)
     {
         if (viewport->flags & VIEWPORT_FLAG_RENDERING_INHIBITED)
             return;
@@ -931,14 +938,18 @@ namespace OpenRCT2
         if (rt.y >= viewport->pos.y + viewport->height)
             return;
 
-        ViewportPaint(viewport, rt);
+        ViewportPaint(viewport, rt, retainPaint);
     }
 
-    static void ViewportFillColumn(PaintSession& session)
+    static void ViewportFillColumn(PaintSession& session, bool usePaintCache)
     {
         PROFILED_FUNCTION();
 
+        session.CacheColumn = usePaintCache ? PaintCache::AcquireColumn(session) : nullptr;
         PaintSessionGenerate(session);
+        PaintCache::ReleaseColumn(session.CacheColumn);
+        session.CacheColumn = nullptr;
+
         PaintSessionArrange(session);
     }
 
@@ -983,7 +994,7 @@ namespace OpenRCT2
      *  edi: dpi
      *  ebp: bottom
      */
-    static void ViewportPaint(const Viewport* viewport, RenderTarget& rt)
+    static void ViewportPaint(const Viewport* viewport, RenderTarget& rt, bool retainPaint)
     {
         PROFILED_FUNCTION();
 
@@ -1006,14 +1017,15 @@ namespace OpenRCT2
 
         _paintColumns.clear();
 
+        // Renders of views that are not shown again, such as giant screenshots, would only evict the retained paint of
+        // the windows.
+        const bool usePaintCache = retainPaint || ViewportIsWindowViewport(viewport);
+
         bool useMultithreading = Config::Get().general.MultiThreading;
-        if (useMultithreading && _paintJobs == nullptr)
-        {
-            _paintJobs = std::make_unique<JobPool>();
-        }
-        else if (useMultithreading == false && _paintJobs != nullptr)
+        std::optional<TaskGroup> paintTasks;
+        if (useMultithreading)
         {
-            _paintJobs.reset();
+            paintTasks.emplace();
         }
 
         bool useParallelDrawing = false;
@@ -1062,17 +1074,17 @@ namespace OpenRCT2
 
             if (useMultithreading)
             {
-                _paintJobs->AddTask([session]() -> void { ViewportFillColumn(*session); });
+                paintTasks->Run([session, usePaintCache]() -> void { ViewportFillColumn(*session, usePaintCache); });
             }
             else
             {
-                ViewportFillColumn(*session);
+                ViewportFillColumn(*session, usePaintCache);
             }
         }
 
         if (useMultithreading)
         {
-            _paintJobs->Join();
+            paintTasks->Wait();
         }
 
         // Paint columns.
@@ -1080,7 +1092,7 @@ namespace OpenRCT2
         {
             if (useParallelDrawing)
             {
-                _paintJobs->AddTask([session]() -> void { ViewportPaintColumn(*session); });
+                paintTasks->Run([session]() -> void { ViewportPaintColumn(*session); });
             }
             else
             {
@@ -1089,7 +1101,7 @@ namespace OpenRCT2
         }
         if (useParallelDrawing)
         {
-            _paintJobs->Join();
+            paintTasks->Wait();
         }
 
         // Release resources.
@@ -197,7 +197,8 @@ namespace OpenRCT2
     void ViewportUpdateSmartFollowGuest(WindowBase* window, const Guest& peep);
     void ViewportRotateSingle(WindowBase* window, int32_t direction);
     void ViewportRotateAll(int32_t direction);
-    void ViewportRender(RenderTarget& rt, const Viewport* viewport);
+    // Retaining paint is always done for window viewports, other views can opt in when they are painted repeatedly.
+    void ViewportRender(RenderTarget& rt, const Viewport* viewport, bool retainPaint = false);
 
     CoordsXYZ ViewportAdjustForMapHeight(const ScreenCoordsXY& startCoords, uint8_t rotation);
 
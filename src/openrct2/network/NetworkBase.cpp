@@ -39,7 +39,9 @@
 #include "../world/MapAnimation.h"
 #include "Network.h"
 
+#include <algorithm>
 #include <cassert>
+#include <cinttypes>
 #include <iterator>
 #include <stdexcept>
 
@@ -49,7 +51,7 @@ using namespace OpenRCT2;
 // It is used for making sure only compatible builds get connected, even within
 // single OpenRCT2 version.
 
-constexpr uint8_t kNetworkStreamVersion = 0;
+constexpr uint8_t kNetworkStreamVersion = 3;
 
 const std::string kNetworkStreamID = std::string(kOpenRCT2Version) + "-" + std::to_string(kNetworkStreamVersion);
 
@@ -62,6 +64,17 @@ static int32_t _pickup_peep_old_x = kLocationNull;
 // with uint16_t and needs some spare room for other data in the packet.
 static constexpr uint32_t kChunkSize = 1024 * 63;
 
+// Clients requesting the map up to this many milliseconds after a snapshot of it was taken get the same snapshot.
+static constexpr uint32_t kMapSnapshotLifetime = 3000;
+
+// A client gives up on resyncing regions once it needed this many resyncs within the window, in ticks. The server
+// serves no more than that to each client in the same window.
+static constexpr size_t kMaxRegionsResyncs = 3;
+static constexpr uint32_t kRegionsResyncWindow = NetworkRegions::kSweepTicks * 4;
+
+// Requests for more regions than this are answered with the full map.
+static constexpr uint32_t kMaxRegionsPerResync = 64;
+
 // If data is sent fast enough it would halt the entire server, process only a maximum amount.
 // This limit is per connection, the current value was determined by tests with fuzzing.
 static constexpr uint32_t kMaxPacketsPerUpdate = 100;
@@ -75,6 +88,7 @@ static constexpr uint32_t kMaxPacketsPerUpdate = 100;
     #include "../core/EnumUtils.hpp"
     #include "../core/FileStream.h"
     #include "../core/MemoryStream.h"
+    #include "../core/OrcaStream.hpp"
     #include "../core/Path.hpp"
     #include "../core/String.hpp"
     #include "../interface/Chat.h"
@@ -139,6 +153,7 @@ NetworkBase::NetworkBase(OpenRCT2::IContext& context)
     client_command_handlers[NetworkCommand::ScriptsHeader] = &NetworkBase::Client_Handle_SCRIPTS_HEADER;
     client_command_handlers[NetworkCommand::ScriptsData] = &NetworkBase::Client_Handle_SCRIPTS_DATA;
     client_command_handlers[NetworkCommand::GameState] = &NetworkBase::Client_Handle_GAMESTATE;
+    client_command_handlers[NetworkCommand::Regions] = &NetworkBase::Client_Handle_REGIONS;
 
     server_command_handlers[NetworkCommand::Auth] = &NetworkBase::ServerHandleAuth;
     server_command_handlers[NetworkCommand::Chat] = &NetworkBase::ServerHandleChat;
@@ -149,6 +164,7 @@ NetworkBase::NetworkBase(OpenRCT2::IContext& context)
     server_command_handlers[NetworkCommand::MapRequest] = &NetworkBase::ServerHandleMapRequest;
     server_command_handlers[NetworkCommand::RequestGameState] = &NetworkBase::ServerHandleRequestGamestate;
     server_command_handlers[NetworkCommand::Heartbeat] = &NetworkBase::ServerHandleHeartbeat;
+    server_command_handlers[NetworkCommand::RequestRegions] = &NetworkBase::ServerHandleRequestRegions;
 
     _chat_log_fs << std::unitbuf;
     _server_log_fs << std::unitbuf;
@@ -198,12 +214,17 @@ void NetworkBase::Close()
         CloseServerLog();
         CloseConnection();
 
+        ClearMapSnapshots();
         client_connection_list.clear();
         GameActions::ClearQueue();
         GameActions::ResumeQueue();
         player_list.clear();
         group_list.clear();
         _serverTickData.clear();
+        _regionsResyncRequests.clear();
+        _regionsResyncs.clear();
+        _regionsToResync.clear();
+        _regionsResyncPending = false;
         _pendingPlayerLists.clear();
         _pendingPlayerInfo.clear();
 
@@ -276,6 +297,10 @@ bool NetworkBase::BeginClient(const std::string& host, uint16_t port)
     _lastConnectStatus = SocketStatus::Closed;
     _clientMapLoaded = false;
     _serverTickData.clear();
+    _regionsResyncRequests.clear();
+    _regionsResyncs.clear();
+    _regionsToResync.clear();
+    _regionsResyncPending = false;
 
     BeginChatLog();
     BeginServerLog();
@@ -528,6 +553,9 @@ void NetworkBase::UpdateServer()
         }
     }
 
+    UpdateMapSnapshots();
+    UpdateRegionsRequests();
+
     uint32_t ticks = Platform::GetTicks();
     if (ticks > last_ping_sent_time + 3000)
     {
@@ -782,8 +810,28 @@ const char* NetworkBase::FormatChat(NetworkPlayer* fromPlayer, const char* text)
     return formatted.c_str();
 }
 
-void NetworkBase::SendPacketToClients(const NetworkPacket& packet, bool front, bool gameCmd) const
+void NetworkBase::SendPacketToClients(const NetworkPacket& packet, bool front, bool gameCmd)
 {
+    // Serialised once for all clients rather than by each of them.
+    const auto buffer = packet.Serialise();
+
+    switch (packet.GetCommand())
+    {
+        case NetworkCommand::GameAction:
+        case NetworkCommand::Tick:
+        case NetworkCommand::PlayerInfo:
+        case NetworkCommand::PlayerList:
+            // Clients loading a map snapshot need these to follow the game from the tick it was taken at. They are
+            // logged and sent after the map in the order they were sent, front is ignored as none of these use it.
+            for (auto& snapshot : _mapSnapshots)
+            {
+                snapshot->Packets.push_back({ packet.GetCommand(), buffer });
+            }
+            break;
+        default:
+            break;
+    }
+
     for (auto& client_connection : client_connection_list)
     {
         if (gameCmd)
@@ -797,7 +845,7 @@ void NetworkBase::SendPacketToClients(const NetworkPacket& packet, bool front, b
                 continue;
             }
         }
-        client_connection->QueuePacket(packet, front);
+        client_connection->QueuePacket(packet, buffer, front);
     }
 }
 
@@ -814,24 +862,29 @@ bool NetworkBase::CheckSRAND(uint32_t tick, uint32_t srand0)
     const ServerTickData storedTick = itTickData->second;
     _serverTickData.erase(itTickData);
 
+    bool inSync = true;
     if (storedTick.srand0 != srand0)
     {
         LOG_INFO("Srand0 mismatch, client = %08X, server = %08X", srand0, storedTick.srand0);
-        return false;
+        inSync = false;
     }
 
-    if (!storedTick.spriteHash.empty())
+    // Remember which regions diverged, so only those have to be fetched from the server.
+    _mismatchedRegions.clear();
+    for (const auto& serverChecksum : storedTick.regionChecksums)
     {
-        EntitiesChecksum checksum = GetAllEntitiesChecksum();
-        std::string clientSpriteHash = checksum.ToString();
-        if (clientSpriteHash != storedTick.spriteHash)
+        const auto clientChecksum = NetworkRegions::GetChecksum(serverChecksum.Region);
+        if (clientChecksum != serverChecksum.Checksum)
         {
-            LOG_INFO("Sprite hash mismatch, client = %s, server = %s", clientSpriteHash.c_str(), storedTick.spriteHash.c_str());
-            return false;
+            LOG_INFO(
+                "Checksum mismatch in %s, client = %016" PRIX64 ", server = %016" PRIX64,
+                NetworkRegions::GetName(serverChecksum.Region).c_str(), clientChecksum, serverChecksum.Checksum);
+            _mismatchedRegions.push_back(serverChecksum.Region);
+            inSync = false;
         }
     }
 
-    return true;
+    return inSync;
 }
 
 bool NetworkBase::IsDesynchronised() const noexcept
@@ -842,10 +895,17 @@ bool NetworkBase::IsDesynchronised() const noexcept
 bool NetworkBase::CheckDesynchronizaton()
 {
     const auto currentTicks = getGameState().currentTicks;
+    if (GetMode() != NETWORK_MODE_CLIENT || _serverState.state == NetworkServerStatus::Desynced)
+        return false;
+
+    // Check synchronisation, diverged regions are fetched again from the server before giving up.
+    bool inSync = ApplyRegionsResync(currentTicks);
+    if (inSync && !CheckSRAND(currentTicks, ScenarioRandState().s0))
+    {
+        inSync = RequestRegionsResync(currentTicks);
+    }
 
-    // Check synchronisation
-    if (GetMode() == NETWORK_MODE_CLIENT && _serverState.state != NetworkServerStatus::Desynced
-        && !CheckSRAND(currentTicks, ScenarioRandState().s0))
+    if (!inSync)
     {
         _serverState.state = NetworkServerStatus::Desynced;
         _serverState.desyncTick = currentTicks;
@@ -868,6 +928,90 @@ bool NetworkBase::CheckDesynchronizaton()
     return false;
 }
 
+bool NetworkBase::RequestRegionsResync(uint32_t tick)
+{
+    // Desync reports need the diverged state.
+    if (_serverState.gamestateSnapshotsEnabled)
+        return false;
+
+    _regionsToResync.insert(_regionsToResync.end(), _mismatchedRegions.begin(), _mismatchedRegions.end());
+    return SendRegionsResyncRequest(tick);
+}
+
+bool NetworkBase::SendRegionsResyncRequest(uint32_t tick)
+{
+    // The server serves one request per client at a time, regions found diverged meanwhile are asked for next.
+    // The resync on its way also brings the random number generator back in line.
+    if (_regionsResyncPending)
+        return true;
+
+    // Repeated divergence means the cause lies outside of the regions.
+    const auto expired = std::remove_if(
+        _regionsResyncRequests.begin(), _regionsResyncRequests.end(),
+        [tick](uint32_t requestTick) { return tick - requestTick >= kRegionsResyncWindow; });
+    _regionsResyncRequests.erase(expired, _regionsResyncRequests.end());
+    if (_regionsResyncRequests.size() >= kMaxRegionsResyncs)
+    {
+        LOG_INFO("Too many resyncs in a short time, giving up");
+        return false;
+    }
+
+    std::sort(_regionsToResync.begin(), _regionsToResync.end());
+    _regionsToResync.erase(std::unique(_regionsToResync.begin(), _regionsToResync.end()), _regionsToResync.end());
+
+    _regionsResyncRequests.push_back(tick);
+    _regionsResyncPending = true;
+    Client_Send_RequestRegions(_regionsToResync);
+    _regionsToResync.clear();
+    return true;
+}
+
+bool NetworkBase::ApplyRegionsResync(uint32_t tick)
+{
+    if (!_clientMapLoaded)
+        return true;
+
+    bool applied = true;
+    while (!_regionsResyncs.empty() && _regionsResyncs.begin()->first <= tick)
+    {
+        auto it = _regionsResyncs.begin();
+        if (it->first < tick)
+        {
+            // The server took the regions at a tick the client has already passed.
+            LOG_INFO("Resync for tick %u arrived too late", it->first);
+            applied = false;
+        }
+        else
+        {
+            try
+            {
+                // The server took the regions at the start of this tick, before anything has been updated.
+                auto& data = it->second;
+                data.SetPosition(0);
+                DataSerialiser ds(false, data);
+                const auto diverged = NetworkRegions::ReadResync(ds);
+                GfxInvalidateScreen();
+                LOG_INFO("Resynchronised regions at tick %u, %zu other regions differ", tick, diverged.size());
+
+                // Ask for every other region that differs now, rather than waiting for the sweep to find them.
+                _regionsToResync.insert(_regionsToResync.end(), diverged.begin(), diverged.end());
+                _regionsResyncPending = false;
+                if (!_regionsToResync.empty() && !SendRegionsResyncRequest(tick))
+                {
+                    applied = false;
+                }
+            }
+            catch (const std::exception& e)
+            {
+                LOG_WARNING("Unable to apply resync: %s", e.what());
+                applied = false;
+            }
+        }
+        _regionsResyncs.erase(it);
+    }
+    return applied;
+}
+
 void NetworkBase::RequestStateSnapshot()
 {
     LOG_INFO("Requesting game state for tick %u", _serverState.desyncTick);
@@ -1238,6 +1382,19 @@ void NetworkBase::CloseServerLog()
     _server_log_fs.close();
 }
 
+void NetworkBase::Client_Send_RequestRegions(const std::vector<uint32_t>& regions)
+{
+    LOG_INFO("Requesting resync of %zu regions from server", regions.size());
+
+    NetworkPacket packet(NetworkCommand::RequestRegions);
+    packet << static_cast<uint32_t>(regions.size());
+    for (auto region : regions)
+    {
+        packet << region;
+    }
+    _serverConnection->QueuePacket(std::move(packet));
+}
+
 void NetworkBase::Client_Send_RequestGameState(uint32_t tick)
 {
     if (_serverState.gamestateSnapshotsEnabled == false)
@@ -1424,6 +1581,7 @@ NetworkStats NetworkBase::GetStats() const
                 stats.bytesReceived[n] += connection->Stats.bytesReceived[n];
                 stats.bytesSent[n] += connection->Stats.bytesSent[n];
             }
+            stats.bytesQueued += connection->Stats.bytesQueued;
         }
     }
     return stats;
@@ -1451,28 +1609,37 @@ void NetworkBase::ServerSendAuth(NetworkConnection& connection)
 
 void NetworkBase::ServerSendMap(NetworkConnection* connection)
 {
-    std::vector<const ObjectRepositoryItem*> objects;
     if (connection != nullptr)
     {
-        objects = connection->RequestedObjects;
-    }
-    else
-    {
-        // This will send all custom objects to connected clients
-        // TODO: fix it so custom objects negotiation is performed even in this case.
-        auto& context = GetContext();
-        auto& objManager = context.GetObjectManager();
-        objects = objManager.GetPackableObjects();
+        auto* snapshot = GetMapSnapshot(connection->RequestedObjects);
+        if (snapshot == nullptr)
+        {
+            connection->SetLastDisconnectReason(STR_MULTIPLAYER_CONNECTION_CLOSED);
+            connection->Disconnect();
+        }
+        else if (snapshot->IsReady)
+        {
+            ServerSendMapSnapshot(*connection, *snapshot);
+        }
+        else
+        {
+            snapshot->PendingConnections.push_back(connection);
+        }
+        return;
     }
 
+    // This will send all custom objects to connected clients
+    // TODO: fix it so custom objects negotiation is performed even in this case.
+    auto& context = GetContext();
+    auto& objManager = context.GetObjectManager();
+    auto objects = objManager.GetPackableObjects();
+
+    // Clients waiting for a snapshot get the new map along with everyone else.
+    ClearMapSnapshots();
+
     auto header = SaveForNetwork(objects);
     if (header.empty())
     {
-        if (connection != nullptr)
-        {
-            connection->SetLastDisconnectReason(STR_MULTIPLAYER_CONNECTION_CLOSED);
-            connection->Disconnect();
-        }
         return;
     }
     size_t chunksize = kChunkSize;
@@ -1482,15 +1649,109 @@ void NetworkBase::ServerSendMap(NetworkConnection* connection)
         NetworkPacket packet(NetworkCommand::Map);
         packet << static_cast<uint32_t>(header.size()) << static_cast<uint32_t>(i);
         packet.Write(&header[i], datasize);
-        if (connection != nullptr)
-        {
-            connection->QueuePacket(std::move(packet));
-        }
-        else
+        SendPacketToClients(packet);
+    }
+}
+
+// Compresses a map saved without compression and splits it into map packets.
+static std::vector<NetworkPacketBuffer> BuildMapPackets(MemoryStream& map)
+{
+    MemoryStream compressed;
+    map.SetPosition(0);
+    OrcaStream::Compress(map, compressed);
+
+    const auto* data = static_cast<const uint8_t*>(compressed.GetData());
+    const auto size = static_cast<size_t>(compressed.GetLength());
+    std::vector<NetworkPacketBuffer> packets;
+    for (size_t i = 0; i < size; i += kChunkSize)
+    {
+        const auto chunkSize = std::min<size_t>(kChunkSize, size - i);
+        NetworkPacket packet(NetworkCommand::Map);
+        packet << static_cast<uint32_t>(size) << static_cast<uint32_t>(i);
+        packet.Write(data + i, chunkSize);
+        packets.push_back(packet.Serialise());
+    }
+    return packets;
+}
+
+NetworkBase::MapSnapshot* NetworkBase::GetMapSnapshot(const std::vector<const ObjectRepositoryItem*>& objects)
+{
+    auto sortedObjects = objects;
+    std::sort(sortedObjects.begin(), sortedObjects.end());
+    for (auto& snapshot : _mapSnapshots)
+    {
+        if (snapshot->Objects == sortedObjects)
         {
-            SendPacketToClients(packet);
+            return snapshot.get();
         }
     }
+
+    // Only the save itself has to be done on the game state, compressing it is left to a background thread.
+    auto map = std::make_shared<MemoryStream>();
+    if (!SaveMap(map.get(), objects, false))
+    {
+        LOG_WARNING("Failed to export map.");
+        return nullptr;
+    }
+
+    auto snapshot = std::make_unique<MapSnapshot>();
+    snapshot->Objects = std::move(sortedObjects);
+    snapshot->Tick = getGameState().currentTicks;
+    snapshot->CreationTime = Platform::GetTicks();
+
+    auto* result = snapshot.get();
+    snapshot->Job = GetContext().GetBackgroundWorker().addJob(
+        [map]() { return BuildMapPackets(*map); },
+        [this, result](std::vector<NetworkPacketBuffer> packets) {
+            LOG_VERBOSE("Map snapshot of tick %u is ready", result->Tick);
+            result->MapPackets = std::move(packets);
+            result->IsReady = true;
+            for (auto* pendingConnection : result->PendingConnections)
+            {
+                ServerSendMapSnapshot(*pendingConnection, *result);
+            }
+            result->PendingConnections.clear();
+        });
+    _mapSnapshots.push_back(std::move(snapshot));
+    return result;
+}
+
+void NetworkBase::ServerSendMapSnapshot(NetworkConnection& connection, const MapSnapshot& snapshot)
+{
+    if (!connection.IsValid())
+    {
+        return;
+    }
+
+    for (const auto& buffer : snapshot.MapPackets)
+    {
+        connection.QueuePacket(NetworkPacket(NetworkCommand::Map), buffer);
+    }
+    for (const auto& logged : snapshot.Packets)
+    {
+        connection.QueuePacket(NetworkPacket(logged.Command), logged.Buffer);
+    }
+}
+
+void NetworkBase::UpdateMapSnapshots()
+{
+    const auto currentTime = Platform::GetTicks();
+    _mapSnapshots.erase(
+        std::remove_if(
+            _mapSnapshots.begin(), _mapSnapshots.end(),
+            [currentTime](const auto& snapshot) {
+                return snapshot->IsReady && currentTime - snapshot->CreationTime > kMapSnapshotLifetime;
+            }),
+        _mapSnapshots.end());
+}
+
+void NetworkBase::ClearMapSnapshots()
+{
+    for (auto& snapshot : _mapSnapshots)
+    {
+        snapshot->Job.cancel();
+    }
+    _mapSnapshots.clear();
 }
 
 std::vector<uint8_t> NetworkBase::SaveForNetwork(const std::vector<const ObjectRepositoryItem*>& objects) const
@@ -1528,12 +1789,13 @@ void NetworkBase::ServerSendChat(const char* text, const std::vector<uint8_t>& p
     }
     else
     {
+        const auto buffer = packet.Serialise();
         for (auto playerId : playerIds)
         {
             auto conn = GetPlayerConnection(playerId);
             if (conn != nullptr)
             {
-                conn->QueuePacket(packet);
+                conn->QueuePacket(packet, buffer);
             }
         }
     }
@@ -1576,24 +1838,23 @@ void NetworkBase::ServerSendTick()
 {
     NetworkPacket packet(NetworkCommand::Tick);
     packet << getGameState().currentTicks << ScenarioRandState().s0;
+    // Only a slice of the park is checksummed each tick, which is cheap enough to do every tick.
+    const auto regionChecksums = NetworkRegions::GetTickChecksums(getGameState().currentTicks);
     uint32_t flags = 0;
-    // Simple counter which limits how often a sprite checksum gets sent.
-    // This can get somewhat expensive, so we don't want to push it every tick in release,
-    // but debug version can check more often.
-    static int32_t checksum_counter = 0;
-    checksum_counter++;
-    if (checksum_counter >= 100)
+    if (!regionChecksums.empty())
     {
-        checksum_counter = 0;
-        flags |= NETWORK_TICK_FLAG_CHECKSUMS;
+        flags |= NETWORK_TICK_FLAG_REGION_CHECKSUMS;
     }
     // Send flags always, so we can understand packet structure on the other end,
     // and allow for some expansion.
     packet << flags;
-    if (flags & NETWORK_TICK_FLAG_CHECKSUMS)
+    if (flags & NETWORK_TICK_FLAG_REGION_CHECKSUMS)
     {
-        EntitiesChecksum checksum = GetAllEntitiesChecksum();
-        packet.WriteString(checksum.ToString());
+        packet << static_cast<uint16_t>(regionChecksums.size());
+        for (const auto& regionChecksum : regionChecksums)
+        {
+            packet << regionChecksum.Region << regionChecksum.Checksum;
+        }
     }
 
     SendPacketToClients(packet);
@@ -2013,6 +2274,12 @@ void NetworkBase::ProcessDisconnectedClients()
             continue;
         }
 
+        for (auto& snapshot : _mapSnapshots)
+        {
+            auto& pending = snapshot->PendingConnections;
+            pending.erase(std::remove(pending.begin(), pending.end(), connection.get()), pending.end());
+        }
+
         // Make sure to send all remaining packets out before disconnecting.
         connection->SendQueuedData();
         connection->Socket->Disconnect();
@@ -2291,6 +2558,96 @@ void NetworkBase::ServerHandleRequestGamestate(NetworkConnection& connection, Ne
     }
 }
 
+void NetworkBase::ServerHandleRequestRegions(NetworkConnection& connection, NetworkPacket& packet)
+{
+    // A client waits for the reply before asking again, so one request is kept per client.
+    if (connection.RegionsRequested)
+    {
+        return;
+    }
+
+    uint32_t numRegions{};
+    packet >> numRegions;
+    if (numRegions > kMaxRegionsPerResync)
+    {
+        // Too much has diverged to resync it piece by piece.
+        LOG_INFO("Client %s requested %u regions, sending the map instead", connection.Socket->GetHostName(), numRegions);
+        ServerSendMap(&connection);
+        return;
+    }
+
+    const auto maxRegions = NetworkRegions::GetNumRegions();
+    connection.RequestedRegions.clear();
+    for (uint32_t i = 0; i < numRegions; i++)
+    {
+        uint32_t region{};
+        packet >> region;
+        if (region < maxRegions)
+        {
+            connection.RequestedRegions.push_back(region);
+        }
+    }
+    connection.RegionsRequested = true;
+
+    // The reply tells the client every region that differs, so it should only need to ask once more.
+    ServerServeRegionsRequest(connection);
+}
+
+void NetworkBase::UpdateRegionsRequests()
+{
+    for (auto& connection : client_connection_list)
+    {
+        if (connection->IsValid() && connection->RegionsRequested)
+        {
+            ServerServeRegionsRequest(*connection);
+        }
+    }
+}
+
+void NetworkBase::ServerServeRegionsRequest(NetworkConnection& connection)
+{
+    // Requests are served before the tick is updated, the client applies the regions at the start of the same tick.
+    const auto tick = getGameState().currentTicks;
+
+    // Every request serialises the regions and checksums the park on the main thread, so a client asking more often
+    // than it would before giving up waits for its older requests to expire.
+    auto& resyncTicks = connection.RegionsResyncTicks;
+    const auto expired = std::remove_if(
+        resyncTicks.begin(), resyncTicks.end(),
+        [tick](uint32_t resyncTick) { return tick - resyncTick >= kRegionsResyncWindow; });
+    resyncTicks.erase(expired, resyncTicks.end());
+    if (resyncTicks.size() >= kMaxRegionsResyncs)
+        return;
+
+    ServerSendRegions(connection, connection.RequestedRegions);
+    connection.RequestedRegions.clear();
+    connection.RegionsRequested = false;
+    resyncTicks.push_back(tick);
+}
+
+void NetworkBase::ServerSendRegions(NetworkConnection& connection, const std::vector<uint32_t>& regions)
+{
+    const auto tick = getGameState().currentTicks;
+    MemoryStream regionsMemory;
+    DataSerialiser ds(true, regionsMemory);
+    NetworkRegions::WriteResync(ds, regions);
+
+    uint32_t bytesSent = 0;
+    uint32_t length = static_cast<uint32_t>(regionsMemory.GetLength());
+    while (bytesSent < length)
+    {
+        uint32_t dataSize = std::min<uint32_t>(kChunkSize, length - bytesSent);
+
+        NetworkPacket packetRegionsChunk(NetworkCommand::Regions);
+        packetRegionsChunk << tick << length << bytesSent << dataSize;
+        packetRegionsChunk.Write(static_cast<const uint8_t*>(regionsMemory.GetData()) + bytesSent, dataSize);
+
+        connection.QueuePacket(std::move(packetRegionsChunk));
+
+        bytesSent += dataSize;
+    }
+}
+
 void NetworkBase::ServerHandleHeartbeat(NetworkConnection& connection, NetworkPacket& packet)
 {
     LOG_VERBOSE("Client %s heartbeat", connection.Socket->GetHostName());
@@ -2517,6 +2874,36 @@ void NetworkBase::Client_Handle_SCRIPTS_DATA(NetworkConnection& connection, Netw
     #endif
 }
 
+void NetworkBase::Client_Handle_REGIONS(NetworkConnection& connection, NetworkPacket& packet)
+{
+    uint32_t tick;
+    uint32_t totalSize;
+    uint32_t offset;
+    uint32_t dataSize;
+
+    packet >> tick >> totalSize >> offset >> dataSize;
+
+    if (offset == 0)
+    {
+        _serverRegions = MemoryStream();
+    }
+
+    _serverRegions.SetPosition(offset);
+
+    const uint8_t* data = packet.Read(dataSize);
+    if (data == nullptr)
+    {
+        return;
+    }
+    _serverRegions.Write(data, dataSize);
+
+    if (_serverRegions.GetLength() == totalSize)
+    {
+        _regionsResyncs[tick] = std::move(_serverRegions);
+        _serverRegions = MemoryStream();
+    }
+}
+
 void NetworkBase::Client_Handle_GAMESTATE(NetworkConnection& connection, NetworkPacket& packet)
 {
     uint32_t tick;
@@ -2775,6 +3162,12 @@ void NetworkBase::Client_Handle_MAP([[maybe_unused]] NetworkConnection& connecti
         GameActions::SuspendQueue();
 
         _serverTickData.clear();
+        // Player updates received before the map are sent again after it, as logged by the snapshot.
+        _pendingPlayerLists.clear();
+        _pendingPlayerInfo.clear();
+        _regionsResyncs.clear();
+        _regionsToResync.clear();
+        _regionsResyncPending = false;
         _clientMapLoaded = false;
     }
     if (size > chunk_buffer.size())
@@ -2866,7 +3259,7 @@ bool NetworkBase::LoadMap(IStream* stream)
     return result;
 }
 
-bool NetworkBase::SaveMap(IStream* stream, const std::vector<const ObjectRepositoryItem*>& objects) const
+bool NetworkBase::SaveMap(IStream* stream, const std::vector<const ObjectRepositoryItem*>& objects, bool compress) const
 {
     bool result = false;
     PrepareMapForSave();
@@ -2874,6 +3267,7 @@ bool NetworkBase::SaveMap(IStream* stream, const std::vector<const ObjectReposit
     {
         auto exporter = std::make_unique<ParkFileExporter>();
         exporter->ExportObjectsList = objects;
+        exporter->Compress = compress;
 
         auto& gameState = getGameState();
         exporter->Export(gameState, *stream);
@@ -3081,12 +3475,15 @@ void NetworkBase::Client_Handle_TICK([[maybe_unused]] NetworkConnection& connect
     tickData.srand0 = srand0;
     tickData.tick = serverTick;
 
-    if (flags & NETWORK_TICK_FLAG_CHECKSUMS)
+    if (flags & NETWORK_TICK_FLAG_REGION_CHECKSUMS)
     {
-        auto text = packet.ReadString();
-        if (!text.empty())
+        uint16_t numChecksums{};
+        packet >> numChecksums;
+        for (uint16_t i = 0; i < numChecksums; i++)
         {
-            tickData.spriteHash = text;
+            NetworkRegions::RegionChecksum regionChecksum{};
+            packet >> regionChecksum.Region >> regionChecksum.Checksum;
+            tickData.regionChecksums.push_back(regionChecksum);
         }
     }
 
@@ -2,10 +2,12 @@
 
 #include "../System.hpp"
 #include "../actions/GameAction.h"
+#include "../core/BackgroundWorker.hpp"
 #include "../object/Object.h"
 #include "NetworkConnection.h"
 #include "NetworkGroup.h"
 #include "NetworkPlayer.h"
+#include "NetworkRegions.h"
 #include "NetworkServerAdvertiser.h"
 #include "NetworkTypes.h"
 #include "NetworkUser.h"
@@ -79,7 +81,8 @@ public: // Server
     void RemovePlayer(std::unique_ptr<NetworkConnection>& connection);
     void UpdateServer();
     void ServerClientDisconnected(std::unique_ptr<NetworkConnection>& connection);
-    bool SaveMap(OpenRCT2::IStream* stream, const std::vector<const ObjectRepositoryItem*>& objects) const;
+    bool SaveMap(
+        OpenRCT2::IStream* stream, const std::vector<const ObjectRepositoryItem*>& objects, bool compress = true) const;
     std::vector<uint8_t> SaveForNetwork(const std::vector<const ObjectRepositoryItem*>& objects) const;
     std::string MakePlayerNameUnique(const std::string& name);
 
@@ -102,10 +105,12 @@ public: // Server
     void ServerSendEventPlayerDisconnected(const char* playerName, const char* reason);
     void ServerSendObjectsList(NetworkConnection& connection, const std::vector<const ObjectRepositoryItem*>& objects) const;
     void ServerSendScripts(NetworkConnection& connection);
+    void ServerSendRegions(NetworkConnection& connection, const std::vector<uint32_t>& regions);
 
     // Handlers
     void ServerHandleRequestGamestate(NetworkConnection& connection, NetworkPacket& packet);
     void ServerHandleHeartbeat(NetworkConnection& connection, NetworkPacket& packet);
+    void ServerHandleRequestRegions(NetworkConnection& connection, NetworkPacket& packet);
     void ServerHandleAuth(NetworkConnection& connection, NetworkPacket& packet);
     void ServerClientJoined(std::string_view name, const std::string& keyhash, NetworkConnection& connection);
     void ServerHandleChat(NetworkConnection& connection, NetworkPacket& packet);
@@ -124,9 +129,12 @@ public: // Client
     void ProcessPlayerInfo();
     void ProcessDisconnectedClients();
     static const char* FormatChat(NetworkPlayer* fromplayer, const char* text);
-    void SendPacketToClients(const NetworkPacket& packet, bool front = false, bool gameCmd = false) const;
+    void SendPacketToClients(const NetworkPacket& packet, bool front = false, bool gameCmd = false);
     bool CheckSRAND(uint32_t tick, uint32_t srand0);
     bool CheckDesynchronizaton();
+    bool RequestRegionsResync(uint32_t tick);
+    bool SendRegionsResyncRequest(uint32_t tick);
+    bool ApplyRegionsResync(uint32_t tick);
     void RequestStateSnapshot();
     bool IsDesynchronised() const noexcept;
     NetworkServerState GetServerState() const noexcept;
@@ -136,6 +144,7 @@ public: // Client
 
     // Packet dispatchers.
     void Client_Send_RequestGameState(uint32_t tick);
+    void Client_Send_RequestRegions(const std::vector<uint32_t>& regions);
     void Client_Send_TOKEN();
     void Client_Send_AUTH(
         const std::string& name, const std::string& password, const std::string& pubkey, const std::vector<uint8_t>& signature);
@@ -166,6 +175,7 @@ public: // Client
     void Client_Handle_SCRIPTS_HEADER(NetworkConnection& connection, NetworkPacket& packet);
     void Client_Handle_SCRIPTS_DATA(NetworkConnection& connection, NetworkPacket& packet);
     void Client_Handle_GAMESTATE(NetworkConnection& connection, NetworkPacket& packet);
+    void Client_Handle_REGIONS(NetworkConnection& connection, NetworkPacket& packet);
 
     std::vector<uint8_t> _challenge;
     std::map<uint32_t, GameAction::Callback_t> _gameActionCallbacks;
@@ -206,6 +216,38 @@ private: // Server Data
     uint16_t listening_port = 0;
     bool _playerListInvalidated = false;
 
+    /**
+     * A saved map that is sent to every client requesting the same objects shortly after it was taken, with the
+     * packets broadcast since then so that they catch up with the game.
+     */
+    struct MapSnapshot
+    {
+        struct LoggedPacket
+        {
+            NetworkCommand Command;
+            NetworkPacketBuffer Buffer;
+        };
+
+        std::vector<const ObjectRepositoryItem*> Objects;
+        uint32_t Tick{};
+        uint32_t CreationTime{};
+        // The map packets, empty until the map has been compressed on a background thread.
+        std::vector<NetworkPacketBuffer> MapPackets;
+        bool IsReady{};
+        std::vector<LoggedPacket> Packets;
+        std::vector<NetworkConnection*> PendingConnections;
+        OpenRCT2::BackgroundWorker::Job Job;
+    };
+
+    std::vector<std::unique_ptr<MapSnapshot>> _mapSnapshots;
+
+    MapSnapshot* GetMapSnapshot(const std::vector<const ObjectRepositoryItem*>& objects);
+    void ServerSendMapSnapshot(NetworkConnection& connection, const MapSnapshot& snapshot);
+    void UpdateMapSnapshots();
+    void UpdateRegionsRequests();
+    void ServerServeRegionsRequest(NetworkConnection& connection);
+    void ClearMapSnapshots();
+
 private: // Client Data
     struct PlayerListUpdate
     {
@@ -216,7 +258,7 @@ private: // Client Data
     {
         uint32_t srand0;
         uint32_t tick;
-        std::string spriteHash;
+        std::vector<OpenRCT2::NetworkRegions::RegionChecksum> regionChecksums;
     };
 
     struct ServerScriptsData
@@ -231,12 +273,17 @@ private: // Client Data
     std::map<uint32_t, PlayerListUpdate> _pendingPlayerLists;
     std::multimap<uint32_t, NetworkPlayer> _pendingPlayerInfo;
     std::map<uint32_t, ServerTickData> _serverTickData;
+    std::vector<uint32_t> _mismatchedRegions;
+    std::vector<uint32_t> _regionsResyncRequests;
+    std::map<uint32_t, OpenRCT2::MemoryStream> _regionsResyncs;
+    std::vector<uint32_t> _regionsToResync;
     std::vector<ObjectEntryDescriptor> _missingObjects;
     std::string _host;
     std::string _chatLogPath;
     std::string _chatLogFilenameFormat = "%Y%m%d-%H%M%S.txt";
     std::string _password;
     OpenRCT2::MemoryStream _serverGameState;
+    OpenRCT2::MemoryStream _serverRegions;
     NetworkServerState _serverState;
     uint32_t _lastSentHeartbeat = 0;
     uint32_t last_ping_sent_time = 0;
@@ -248,6 +295,7 @@ private: // Client Data
     SocketStatus _lastConnectStatus = SocketStatus::Closed;
     bool _requireReconnect = false;
     bool _clientMapLoaded = false;
+    bool _regionsResyncPending = false;
     ServerScriptsData _serverScriptsData{};
 };
 
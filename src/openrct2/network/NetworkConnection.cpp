@@ -11,14 +11,14 @@
 
     #include "NetworkConnection.h"
 
+    #include "../Diagnostic.h"
+    #include "../config/Config.h"
     #include "../core/String.hpp"
     #include "../localisation/Formatting.h"
     #include "../platform/Platform.h"
     #include "Network.h"
     #include "Socket.h"
 
-    #include <sfl/small_vector.hpp>
-
 using namespace OpenRCT2;
 
 static constexpr size_t kNetworkDisconnectReasonBufSize = 256;
@@ -103,46 +103,68 @@ NetworkReadPacket NetworkConnection::ReadPacket()
     return NetworkReadPacket::MoreData;
 }
 
-static sfl::small_vector<uint8_t, 512> serializePacket(const NetworkPacket& packet)
+void NetworkConnection::QueuePacket(const NetworkPacket& packet, bool front)
 {
-    // NOTE: For compatibility reasons for the master server we need to add sizeof(Header.Id) to the size.
-    // Previously the Id field was not part of the header rather part of the body.
-    const auto bodyLength = packet.Data.size() + sizeof(packet.Header.Id);
-
-    Guard::Assert(bodyLength <= std::numeric_limits<uint16_t>::max(), "Packet size too large");
-
-    auto header = packet.Header;
-    header.Size = static_cast<uint16_t>(bodyLength);
-    header.Size = Convert::HostToNetwork(header.Size);
-    header.Id = ByteSwapBE(header.Id);
-
-    sfl::small_vector<uint8_t, 512> buffer;
-    buffer.reserve(sizeof(header) + packet.Data.size());
-
-    buffer.insert(buffer.end(), reinterpret_cast<uint8_t*>(&header), reinterpret_cast<uint8_t*>(&header) + sizeof(header));
-    buffer.insert(buffer.end(), packet.Data.begin(), packet.Data.end());
-
-    return buffer;
+    if (AuthStatus == NetworkAuth::Ok || !packet.CommandRequiresAuth())
+    {
+        QueuePacket(packet, packet.Serialise(), front);
+    }
 }
 
-void NetworkConnection::QueuePacket(const NetworkPacket& packet, bool front)
+void NetworkConnection::QueuePacket(const NetworkPacket& packet, const NetworkPacketBuffer& buffer, bool front)
 {
-    if (AuthStatus == NetworkAuth::Ok || !packet.CommandRequiresAuth())
+    if ((AuthStatus == NetworkAuth::Ok || !packet.CommandRequiresAuth()) && CanQueue(packet, buffer->size()))
     {
-        const auto payload = serializePacket(packet);
         if (front)
         {
-            _outboundBuffer.insert(_outboundBuffer.begin(), payload.begin(), payload.end());
+            // A packet that is partly sent has to be finished first.
+            auto it = _outboundQueue.begin();
+            if (it != _outboundQueue.end() && it->BytesSent > 0)
+            {
+                it++;
+            }
+            _outboundQueue.insert(it, { buffer });
         }
         else
         {
-            _outboundBuffer.insert(_outboundBuffer.end(), payload.begin(), payload.end());
+            _outboundQueue.push_back({ buffer });
         }
+        Stats.bytesQueued += buffer->size();
 
         RecordPacketStats(packet, true);
     }
 }
 
+bool NetworkConnection::CanQueue(const NetworkPacket& packet, size_t size)
+{
+    const auto& config = Config::Get().network;
+    if (config.SendBacklogLimit <= 0)
+    {
+        return true;
+    }
+
+    const auto limit = static_cast<uint64_t>(config.SendBacklogLimit) * 1024 * 1024;
+    if (Stats.bytesQueued + size <= limit)
+    {
+        return true;
+    }
+
+    if (config.SendBacklogPolicy == SendBacklogPolicy::DropOptional && packet.CommandIsOptional())
+    {
+        // Keep the connection, but leave out what it can do without until the backlog is sent. Data it can not do
+        // without still disconnects it below, rather than letting the backlog grow without limit.
+        return false;
+    }
+
+    if (!ShouldDisconnect)
+    {
+        LOG_WARNING("Disconnecting %s, more than %d MiB waiting to be sent.", Socket->GetHostName(), config.SendBacklogLimit);
+        SetLastDisconnectReason("Too much data waiting to be sent.");
+        Disconnect();
+    }
+    return false;
+}
+
 void NetworkConnection::Disconnect() noexcept
 {
     ShouldDisconnect = true;
@@ -155,16 +177,41 @@ bool NetworkConnection::IsValid() const
 
 void NetworkConnection::SendQueuedData()
 {
-    if (_outboundBuffer.empty())
+    while (!_outboundQueue.empty())
     {
-        return;
-    }
+        // Hand as many queued packets as possible to the socket at once.
+        NetworkSendBuffer buffers[kMaxSendBuffers];
+        size_t count = 0;
+        size_t batchSize = 0;
+        for (auto it = _outboundQueue.begin(); it != _outboundQueue.end() && count < kMaxSendBuffers; it++, count++)
+        {
+            const auto& buffer = *it->Buffer;
+            buffers[count] = { buffer.data() + it->BytesSent, buffer.size() - it->BytesSent };
+            batchSize += buffers[count].Size;
+        }
 
-    const auto bytesSent = Socket->SendData(_outboundBuffer.data(), _outboundBuffer.size());
+        auto bytesSent = Socket->SendData(buffers, count);
+        Stats.bytesQueued -= bytesSent;
+        const bool sentAll = bytesSent == batchSize;
 
-    if (bytesSent > 0)
-    {
-        _outboundBuffer.erase(_outboundBuffer.begin(), _outboundBuffer.begin() + bytesSent);
+        while (bytesSent > 0)
+        {
+            auto& outbound = _outboundQueue.front();
+            const auto remaining = outbound.Buffer->size() - outbound.BytesSent;
+            if (bytesSent < remaining)
+            {
+                outbound.BytesSent += bytesSent;
+                break;
+            }
+            bytesSent -= remaining;
+            _outboundQueue.pop_front();
+        }
+
+        if (!sentAll)
+        {
+            // The socket can not take any more for now.
+            return;
+        }
     }
 }
 
@@ -16,6 +16,7 @@
     #include "NetworkTypes.h"
     #include "Socket.h"
 
+    #include <deque>
     #include <memory>
     #include <string_view>
     #include <vector>
@@ -35,12 +36,18 @@ public:
     NetworkKey Key;
     std::vector<uint8_t> Challenge;
     std::vector<const ObjectRepositoryItem*> RequestedObjects;
+    // Regions a desynced client waits for, and the ticks recent requests were served at to limit how often that is.
+    std::vector<uint32_t> RequestedRegions;
+    std::vector<uint32_t> RegionsResyncTicks;
+    bool RegionsRequested = false;
     bool ShouldDisconnect = false;
 
     NetworkConnection() noexcept;
 
     NetworkReadPacket ReadPacket();
     void QueuePacket(const NetworkPacket& packet, bool front = false);
+    // Queues the packet as serialised into buffer, which may be queued on other connections as well.
+    void QueuePacket(const NetworkPacket& packet, const NetworkPacketBuffer& buffer, bool front = false);
 
     // This will not immediately disconnect the client. The disconnect
     // will happen post-tick.
@@ -56,10 +63,18 @@ public:
     void SetLastDisconnectReason(const StringId string_id, void* args = nullptr);
 
 private:
-    std::vector<uint8_t> _outboundBuffer;
+    struct OutboundPacket
+    {
+        NetworkPacketBuffer Buffer;
+        size_t BytesSent{};
+    };
+
+    std::deque<OutboundPacket> _outboundQueue;
     uint32_t _lastPacketTime = 0;
     std::string _lastDisconnectReason;
 
+    // Applies the send backlog limit to a packet of the given size, which may disconnect.
+    bool CanQueue(const NetworkPacket& packet, size_t size);
     void RecordPacketStats(const NetworkPacket& packet, bool sending);
 };
 
@@ -11,10 +11,15 @@
 
     #include "NetworkPacket.h"
 
+    #include "../core/Guard.hpp"
     #include "NetworkTypes.h"
+    #include "Socket.h"
 
+    #include <limits>
     #include <memory>
 
+using namespace OpenRCT2;
+
 NetworkPacket::NetworkPacket(NetworkCommand id) noexcept
     : Header{ 0, id }
 {
@@ -61,6 +66,19 @@ bool NetworkPacket::CommandRequiresAuth() const noexcept
     }
 }
 
+bool NetworkPacket::CommandIsOptional() const noexcept
+{
+    switch (GetCommand())
+    {
+        case NetworkCommand::Ping:
+        case NetworkCommand::PingList:
+        case NetworkCommand::Heartbeat:
+            return true;
+        default:
+            return false;
+    }
+}
+
 void NetworkPacket::Write(const void* bytes, size_t size)
 {
     const uint8_t* src = reinterpret_cast<const uint8_t*>(bytes);
@@ -73,6 +91,28 @@ void NetworkPacket::WriteString(std::string_view s)
     Data.push_back(0);
 }
 
+NetworkPacketBuffer NetworkPacket::Serialise() const
+{
+    // NOTE: For compatibility reasons for the master server we need to add sizeof(Header.Id) to the size.
+    // Previously the Id field was not part of the header rather part of the body.
+    const auto bodyLength = Data.size() + sizeof(Header.Id);
+
+    Guard::Assert(bodyLength <= std::numeric_limits<uint16_t>::max(), "Packet size too large");
+
+    auto header = Header;
+    header.Size = static_cast<uint16_t>(bodyLength);
+    header.Size = Convert::HostToNetwork(header.Size);
+    header.Id = ByteSwapBE(header.Id);
+
+    auto buffer = std::make_shared<std::vector<uint8_t>>();
+    buffer->reserve(sizeof(header) + Data.size());
+
+    buffer->insert(buffer->end(), reinterpret_cast<uint8_t*>(&header), reinterpret_cast<uint8_t*>(&header) + sizeof(header));
+    buffer->insert(buffer->end(), Data.begin(), Data.end());
+
+    return buffer;
+}
+
 const uint8_t* NetworkPacket::Read(size_t size)
 {
     if (BytesRead + size > Data.size())
@@ -25,6 +25,10 @@ struct PacketHeader
 static_assert(sizeof(PacketHeader) == 6);
 #pragma pack(pop)
 
+// A packet as it is sent, header included. Never modified once made, so a broadcast packet is shared by all the
+// connections it is queued on.
+using NetworkPacketBuffer = std::shared_ptr<const std::vector<uint8_t>>;
+
 struct NetworkPacket final
 {
     NetworkPacket() noexcept = default;
@@ -37,6 +41,8 @@ struct NetworkPacket final
 
     void Clear() noexcept;
     bool CommandRequiresAuth() const noexcept;
+    // Whether the packet can be left out without breaking the session, such as pings.
+    bool CommandIsOptional() const noexcept;
 
     const uint8_t* Read(size_t size);
     std::string_view ReadString();
@@ -44,6 +50,8 @@ struct NetworkPacket final
     void Write(const void* bytes, size_t size);
     void WriteString(std::string_view s);
 
+    NetworkPacketBuffer Serialise() const;
+
     template<typename T>
     NetworkPacket& operator>>(T& value)
     {
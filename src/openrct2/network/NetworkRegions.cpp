@@ -0,0 +1,503 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2025 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#ifndef DISABLE_NETWORK
+
+    #include "NetworkRegions.h"
+
+    #include "../GameState.h"
+    #include "../core/ChecksumStream.h"
+    #include "../core/DataSerialiser.h"
+    #include "../core/MemoryStream.h"
+    #include "../entity/EntityRegistry.h"
+    #include "../entity/EntityTweener.h"
+    #include "../entity/Guest.h"
+    #include "../entity/Litter.h"
+    #include "../entity/PatrolArea.h"
+    #include "../entity/Staff.h"
+    #include "../ride/Vehicle.h"
+    #include "../scenario/Scenario.h"
+    #include "../world/Map.h"
+    #include "../world/MapAnimation.h"
+    #include "../world/tile_element/TileElement.h"
+    #include "../world/tile_element/TrackElement.h"
+
+    #include <cstring>
+    #include <stdexcept>
+    #include <unordered_map>
+
+namespace OpenRCT2::NetworkRegions
+{
+    static constexpr uint32_t kNumEntityGroups = (kMaxEntities + kEntityGroupSize - 1) / kEntityGroupSize;
+
+    static TileCoordsXY GetNumBlocks()
+    {
+        const auto& mapSize = getGameState().mapSize;
+        return { (mapSize.x + kBlockSize - 1) / kBlockSize, (mapSize.y + kBlockSize - 1) / kBlockSize };
+    }
+
+    static uint32_t GetNumTileRegions()
+    {
+        const auto numBlocks = GetNumBlocks();
+        return static_cast<uint32_t>(numBlocks.x * numBlocks.y);
+    }
+
+    static uint64_t GetValue(const std::array<std::byte, 20>& checksum)
+    {
+        uint64_t value;
+        std::memcpy(&value, checksum.data(), sizeof(value));
+        return value;
+    }
+
+    // Clears the state that differs between machines without being a desync: the last element flag moved by ghosts
+    // and the highlight the ride construction window blinks on the selected track piece.
+    static TileElement GetComparableElement(const TileElement& element)
+    {
+        auto copy = element;
+        copy.SetLastForTile(false);
+        if (auto* trackElement = copy.AsTrack(); trackElement != nullptr)
+            trackElement->SetHighlight(false);
+        return copy;
+    }
+
+    template<typename TFunc>
+    static void ForEachTileInBlock(uint32_t region, TFunc&& func)
+    {
+        const auto blocksPerRow = static_cast<uint32_t>(GetNumBlocks().x);
+        const auto blockX = static_cast<int32_t>(region % blocksPerRow);
+        const auto blockY = static_cast<int32_t>(region / blocksPerRow);
+        const auto& mapSize = getGameState().mapSize;
+        const auto endX = std::min((blockX + 1) * kBlockSize, mapSize.x);
+        const auto endY = std::min((blockY + 1) * kBlockSize, mapSize.y);
+        for (int32_t y = blockY * kBlockSize; y < endY; y++)
+        {
+            for (int32_t x = blockX * kBlockSize; x < endX; x++)
+            {
+                func(TileCoordsXY{ x, y });
+            }
+        }
+    }
+
+    template<typename TFunc>
+    static void ForEachEntityInGroup(uint32_t group, TFunc&& func)
+    {
+        const auto end = std::min<uint32_t>((group + 1) * kEntityGroupSize, kMaxEntities);
+        for (auto index = group * kEntityGroupSize; index < end; index++)
+        {
+            auto* entity = GetEntity(EntityId::FromUnderlying(index));
+            if (entity != nullptr)
+                func(*entity);
+        }
+    }
+
+    static uint64_t GetBlockChecksum(uint32_t region)
+    {
+        std::array<std::byte, 20> checksum{};
+        ChecksumStream stream(checksum);
+
+        ForEachTileInBlock(region, [&stream](const TileCoordsXY& coords) {
+            const auto* element = MapGetFirstElementAt(coords);
+            if (element == nullptr)
+                return;
+
+            do
+            {
+                // Ghosts only exist on the machine of the player placing them.
+                if (!element->IsGhost())
+                {
+                    const auto copy = GetComparableElement(*element);
+                    stream.Write(&copy, sizeof(copy));
+                }
+            } while (!(element++)->IsLastForTile());
+
+            // Separate the tiles, so elements moving to a neighbouring tile change the checksum.
+            const uint8_t tileEnd = 0xFF;
+            stream.Write(&tileEnd, sizeof(tileEnd));
+        });
+        return GetValue(checksum);
+    }
+
+    struct TileData
+    {
+        TileCoordsXY Coords;
+        std::vector<TileElement> Elements;
+    };
+    using TileBlockData = std::vector<TileData>;
+
+    struct EntityData
+    {
+        EntityId Id;
+        EntityType Type = EntityType::Null;
+        MemoryStream Data;
+    };
+
+    static bool IsSynchronised(EntityType type)
+    {
+        return type == EntityType::Guest || type == EntityType::Staff || type == EntityType::Vehicle
+            || type == EntityType::Litter;
+    }
+
+    static void SerialiseEntity(EntityBase& entity, DataSerialiser& ds)
+    {
+        if (auto* guest = entity.As<Guest>(); guest != nullptr)
+            guest->Serialise(ds);
+        else if (auto* staff = entity.As<Staff>(); staff != nullptr)
+            staff->Serialise(ds);
+        else if (auto* vehicle = entity.As<Vehicle>(); vehicle != nullptr)
+            vehicle->Serialise(ds);
+        else if (auto* litter = entity.As<Litter>(); litter != nullptr)
+            litter->Serialise(ds);
+    }
+
+    static uint64_t GetEntityGroupChecksum(uint32_t group)
+    {
+        std::array<std::byte, 20> checksum{};
+        ChecksumStream stream(checksum);
+        DataSerialiser ds(true, stream);
+
+        // The same entities as GetAllEntitiesChecksum, the others are not kept in sync.
+        ForEachEntityInGroup(group, [&ds](EntityBase& entity) { SerialiseEntity(entity, ds); });
+        return GetValue(checksum);
+    }
+
+    // Serialise leaves out the state that is not compared, but a recreated entity still needs it.
+    static void WriteEntity(EntityBase& entity, DataSerialiser& ds)
+    {
+        SerialiseEntity(entity, ds);
+        ds << entity.SpriteData.Width << entity.SpriteData.HeightMin << entity.SpriteData.HeightMax;
+        if (auto* peep = entity.As<Peep>(); peep != nullptr)
+        {
+            std::string name = peep->Name != nullptr ? peep->Name : "";
+            ds << name;
+        }
+        if (auto* staff = entity.As<Staff>(); staff != nullptr)
+        {
+            auto patrolArea = staff->PatrolInfo != nullptr ? staff->PatrolInfo->ToVector() : std::vector<TileCoordsXY>();
+            auto numTiles = static_cast<uint32_t>(patrolArea.size());
+            ds << numTiles;
+            for (auto& tile : patrolArea)
+            {
+                ds << tile;
+            }
+        }
+    }
+
+    static void ApplyEntity(EntityData& data)
+    {
+        auto* entity = GetEntity(data.Id);
+        if (entity->Type != EntityType::Null && entity->Type != data.Type
+            && (IsSynchronised(entity->Type) || IsSynchronised(data.Type)))
+        {
+            EntityRemove(entity);
+        }
+
+        // Entities that are not kept in sync are left alone, the server cannot be trusted to have the same ones.
+        if (!IsSynchronised(data.Type))
+            return;
+
+        if (entity->Type == EntityType::Null)
+        {
+            entity = CreateEntityAt(data.Id, data.Type);
+            if (entity == nullptr)
+                return;
+        }
+
+        auto* peep = entity->As<Peep>();
+        if (peep != nullptr)
+        {
+            // Loading drops the name without freeing it.
+            peep->SetName({});
+        }
+
+        data.Data.SetPosition(0);
+        DataSerialiser ds(false, data.Data);
+        SerialiseEntity(*entity, ds);
+        ds << entity->SpriteData.Width << entity->SpriteData.HeightMin << entity->SpriteData.HeightMax;
+        if (peep != nullptr)
+        {
+            std::string name;
+            ds << name;
+            peep->SetName(name);
+        }
+        if (auto* staff = entity->As<Staff>(); staff != nullptr)
+        {
+            uint32_t numTiles{};
+            ds << numTiles;
+            std::vector<TileCoordsXY> patrolArea(numTiles);
+            for (auto& tile : patrolArea)
+            {
+                ds << tile;
+            }
+            staff->ClearPatrolArea();
+            if (!patrolArea.empty())
+            {
+                staff->PatrolInfo = new PatrolArea();
+                staff->PatrolInfo->Union(patrolArea);
+            }
+        }
+        EntityTweener::Get().RemoveEntity(entity);
+    }
+
+    static void ApplyTileBlocks(const std::vector<TileBlockData>& tileBlocks)
+    {
+        if (tileBlocks.empty())
+            return;
+
+        std::unordered_map<uint32_t, const TileData*> replacements;
+        for (const auto& block : tileBlocks)
+        {
+            for (const auto& tile : block)
+            {
+                replacements[tile.Coords.y * kMaximumMapSizeTechnical + tile.Coords.x] = &tile;
+            }
+        }
+
+        auto& gameState = getGameState();
+        std::vector<TileElement> newElements;
+        newElements.reserve(gameState.tileElements.size());
+        for (int32_t y = 0; y < kMaximumMapSizeTechnical; y++)
+        {
+            for (int32_t x = 0; x < kMaximumMapSizeTechnical; x++)
+            {
+                const auto* element = MapGetFirstElementAt(TileCoordsXY{ x, y });
+                if (element == nullptr)
+                    throw std::runtime_error("Tile index is incomplete");
+
+                auto it = replacements.find(y * kMaximumMapSizeTechnical + x);
+                if (it == replacements.end())
+                {
+                    do
+                    {
+                        newElements.push_back(*element);
+                    } while (!(element++)->IsLastForTile());
+                    continue;
+                }
+
+                // Keep the local ghosts, so construction previews can still be removed.
+                const auto first = newElements.size();
+                newElements.insert(newElements.end(), it->second->Elements.begin(), it->second->Elements.end());
+                do
+                {
+                    if (element->IsGhost())
+                        newElements.push_back(*element);
+                } while (!(element++)->IsLastForTile());
+
+                for (auto i = first; i < newElements.size(); i++)
+                {
+                    newElements[i].SetLastForTile(false);
+                }
+                newElements.back().SetLastForTile(true);
+            }
+        }
+        SetTileElements(gameState, std::move(newElements));
+
+        for (const auto& block : tileBlocks)
+        {
+            for (const auto& tile : block)
+            {
+                MapAnimations::MarkTileForUpdate(tile.Coords);
+                MapAnimations::MarkTileForInvalidation(tile.Coords);
+            }
+        }
+    }
+
+    uint32_t GetNumRegions()
+    {
+        return GetNumTileRegions() + kNumEntityGroups;
+    }
+
+    uint32_t GetTileRegion(const TileCoordsXY& coords)
+    {
+        const auto blocksPerRow = static_cast<uint32_t>(GetNumBlocks().x);
+        return static_cast<uint32_t>(coords.y / kBlockSize) * blocksPerRow + static_cast<uint32_t>(coords.x / kBlockSize);
+    }
+
+    uint32_t GetEntityRegion(EntityId id)
+    {
+        return GetNumTileRegions() + id.ToUnderlying() / kEntityGroupSize;
+    }
+
+    uint64_t GetChecksum(uint32_t region)
+    {
+        const auto numTileRegions = GetNumTileRegions();
+        if (region < numTileRegions)
+            return GetBlockChecksum(region);
+        return GetEntityGroupChecksum(region - numTileRegions);
+    }
+
+    std::vector<RegionChecksum> GetTickChecksums(uint32_t tick)
+    {
+        std::vector<RegionChecksum> result;
+        const auto numRegions = GetNumRegions();
+        for (auto region = tick % kSweepTicks; region < numRegions; region += kSweepTicks)
+        {
+            result.push_back({ region, GetChecksum(region) });
+        }
+        return result;
+    }
+
+    std::string GetName(uint32_t region)
+    {
+        const auto numTileRegions = GetNumTileRegions();
+        if (region < numTileRegions)
+        {
+            const auto blocksPerRow = static_cast<uint32_t>(GetNumBlocks().x);
+            const auto x = static_cast<int32_t>(region % blocksPerRow) * kBlockSize;
+            const auto y = static_cast<int32_t>(region / blocksPerRow) * kBlockSize;
+            return "tiles " + std::to_string(x) + "," + std::to_string(y) + " to " + std::to_string(x + kBlockSize - 1)
+                + "," + std::to_string(y + kBlockSize - 1);
+        }
+
+        const auto first = (region - numTileRegions) * kEntityGroupSize;
+        return "entities " + std::to_string(first) + " to " + std::to_string(first + kEntityGroupSize - 1);
+    }
+
+    void WriteRegions(DataSerialiser& ds, const std::vector<uint32_t>& regions)
+    {
+        auto mapSize = getGameState().mapSize;
+        auto numRegions = static_cast<uint32_t>(regions.size());
+        ds << mapSize << numRegions;
+
+        const auto numTileRegions = GetNumTileRegions();
+        for (auto region : regions)
+        {
+            ds << region;
+            if (region < numTileRegions)
+            {
+                ForEachTileInBlock(region, [&ds](const TileCoordsXY& coords) {
+                    std::vector<TileElement> elements;
+                    const auto* element = MapGetFirstElementAt(coords);
+                    if (element != nullptr)
+                    {
+                        do
+                        {
+                            if (!element->IsGhost())
+                                elements.push_back(GetComparableElement(*element));
+                        } while (!(element++)->IsLastForTile());
+                    }
+                    ds << elements;
+                });
+            }
+            else
+            {
+                ForEachEntityInGroup(region - numTileRegions, [&ds](EntityBase& entity) {
+                    auto type = entity.Type;
+                    ds << type;
+                    if (IsSynchronised(type))
+                    {
+                        MemoryStream data;
+                        DataSerialiser entityDs(true, data);
+                        WriteEntity(entity, entityDs);
+                        ds << data;
+                    }
+                });
+            }
+        }
+    }
+
+    void ReadRegions(DataSerialiser& ds)
+    {
+        TileCoordsXY mapSize;
+        uint32_t numRegions{};
+        ds << mapSize << numRegions;
+        if (mapSize != getGameState().mapSize)
+            throw std::runtime_error("Map size differs from the server");
+
+        // Read everything before touching the park, so a malformed packet leaves it as it was.
+        std::vector<TileBlockData> tileBlocks;
+        std::vector<EntityData> entities;
+        const auto numTileRegions = GetNumTileRegions();
+        for (uint32_t i = 0; i < numRegions; i++)
+        {
+            uint32_t region{};
+            ds << region;
+            if (region >= GetNumRegions())
+                throw std::runtime_error("Invalid region");
+
+            if (region < numTileRegions)
+            {
+                auto& block = tileBlocks.emplace_back();
+                ForEachTileInBlock(region, [&ds, &block](const TileCoordsXY& coords) {
+                    auto& tile = block.emplace_back();
+                    tile.Coords = coords;
+                    ds << tile.Elements;
+                    if (tile.Elements.empty())
+                        throw std::runtime_error("Tile without elements");
+                });
+            }
+            else
+            {
+                ForEachEntityInGroup(region - numTileRegions, [&ds, &entities](EntityBase& entity) {
+                    auto& data = entities.emplace_back();
+                    data.Id = entity.Id;
+                    ds << data.Type;
+                    if (IsSynchronised(data.Type))
+                        ds << data.Data;
+                });
+            }
+        }
+
+        ApplyTileBlocks(tileBlocks);
+        for (auto& data : entities)
+        {
+            ApplyEntity(data);
+        }
+        if (!entities.empty())
+        {
+            ResetEntitySpatialIndices();
+            UpdateConsolidatedPatrolAreas();
+        }
+    }
+
+    void WriteResync(DataSerialiser& ds, const std::vector<uint32_t>& regions)
+    {
+        auto randState = ScenarioRandState();
+        ds << randState.s0 << randState.s1;
+
+        auto numRegions = GetNumRegions();
+        ds << numRegions;
+        for (uint32_t region = 0; region < numRegions; region++)
+        {
+            auto checksum = GetChecksum(region);
+            ds << checksum;
+        }
+
+        WriteRegions(ds, regions);
+    }
+
+    std::vector<uint32_t> ReadResync(DataSerialiser& ds)
+    {
+        uint32_t s0{};
+        uint32_t s1{};
+        uint32_t numRegions{};
+        ds << s0 << s1 << numRegions;
+        if (numRegions != GetNumRegions())
+            throw std::runtime_error("Number of regions differs from the server");
+
+        std::vector<uint64_t> checksums(numRegions);
+        for (auto& checksum : checksums)
+        {
+            ds << checksum;
+        }
+
+        ReadRegions(ds);
+        ScenarioRandSeed(s0, s1);
+
+        // The server took the checksums together with the regions, so they compare with the park as it is now.
+        std::vector<uint32_t> diverged;
+        for (uint32_t region = 0; region < numRegions; region++)
+        {
+            if (GetChecksum(region) != checksums[region])
+                diverged.push_back(region);
+        }
+        return diverged;
+    }
+} // namespace OpenRCT2::NetworkRegions
+
+#endif // DISABLE_NETWORK
@@ -0,0 +1,75 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2025 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#ifndef DISABLE_NETWORK
+
+    #include "../Identifiers.h"
+    #include "../world/Location.hpp"
+
+    #include <cstdint>
+    #include <string>
+    #include <vector>
+
+class DataSerialiser;
+
+/**
+ * Splits the game state compared between server and clients into regions: the blocks of kBlockSize x kBlockSize
+ * tiles of the map, followed by the groups of kEntityGroupSize entity ids. Every tick a different slice of the
+ * regions is checksummed, so each region is checked once every kSweepTicks ticks at a small cost per tick, and a
+ * mismatch tells which part of the park diverged. The sweep is shorter than the 100 ticks between the full checksums
+ * it replaced, so a desync is not found any later than before.
+ */
+namespace OpenRCT2::NetworkRegions
+{
+    constexpr int32_t kBlockSize = 16;
+    constexpr uint32_t kEntityGroupSize = 256;
+    constexpr uint32_t kSweepTicks = 64;
+
+    struct RegionChecksum
+    {
+        uint32_t Region;
+        uint64_t Checksum;
+    };
+
+    uint32_t GetNumRegions();
+
+    // The region of the block holding the given tile.
+    uint32_t GetTileRegion(const TileCoordsXY& coords);
+
+    // The region of the group holding the given entity id.
+    uint32_t GetEntityRegion(EntityId id);
+
+    // Checksums the tile elements or entities of a region as they are now.
+    uint64_t GetChecksum(uint32_t region);
+
+    // Checksums the regions checked on the given tick.
+    std::vector<RegionChecksum> GetTickChecksums(uint32_t tick);
+
+    // Describes the tiles or entities of a region, for logging.
+    std::string GetName(uint32_t region);
+
+    // Writes the tile elements and entities of the regions as they are now, leaving out what the checksums leave out.
+    void WriteRegions(DataSerialiser& ds, const std::vector<uint32_t>& regions);
+
+    // Replaces the tile elements and entities of the regions written by WriteRegions. Throws if the data does not fit
+    // this park, in which case nothing has been changed yet.
+    void ReadRegions(DataSerialiser& ds);
+
+    // Writes the reply to a client asking for the given regions: the random state, the checksums of every region and
+    // the regions themselves, all as they are now.
+    void WriteResync(DataSerialiser& ds, const std::vector<uint32_t>& regions);
+
+    // Applies a reply written by WriteResync and returns the regions that still differ from the server's, so that a
+    // client can ask for all of them at once. Throws like ReadRegions.
+    std::vector<uint32_t> ReadResync(DataSerialiser& ds);
+} // namespace OpenRCT2::NetworkRegions
+
+#endif // DISABLE_NETWORK
@@ -21,7 +21,7 @@ enum
 
 enum
 {
-    NETWORK_TICK_FLAG_CHECKSUMS = 1 << 0,
+    NETWORK_TICK_FLAG_REGION_CHECKSUMS = 1 << 0,
 };
 
 enum
@@ -83,6 +83,8 @@ enum class NetworkCommand : uint32_t
     ScriptsHeader,
     ScriptsData,
     Heartbeat,
+    RequestRegions,
+    Regions,
     Max,
     Invalid = static_cast<uint32_t>(-1),
 };
@@ -145,4 +147,6 @@ struct NetworkStats
 {
     uint64_t bytesReceived[EnumValue(NetworkStatisticsGroup::Max)];
     uint64_t bytesSent[EnumValue(NetworkStatisticsGroup::Max)];
+    // Bytes queued to be sent that the socket has not taken yet.
+    uint64_t bytesQueued;
 };
@@ -11,6 +11,7 @@
 
     #include "../Diagnostic.h"
 
+    #include <algorithm>
     #include <atomic>
     #include <chrono>
     #include <cmath>
@@ -55,6 +56,7 @@
     #include <sys/select.h>
     #include <sys/socket.h>
     #include <sys/time.h>
+    #include <sys/uio.h>
     #include <unistd.h>
 
     using SOCKET = int32_t;
@@ -572,6 +574,53 @@ public:
         return totalSent;
     }
 
+    size_t SendData(const NetworkSendBuffer* buffers, size_t count) override
+    {
+        if (_status != SocketStatus::Connected)
+        {
+            throw std::runtime_error("Socket not connected.");
+        }
+
+        count = std::min(count, kMaxSendBuffers);
+        if (count == 0)
+        {
+            return 0;
+        }
+
+    #ifdef _WIN32
+        WSABUF wsaBuffers[kMaxSendBuffers];
+        for (size_t i = 0; i < count; i++)
+        {
+            wsaBuffers[i].buf = static_cast<CHAR*>(const_cast<void*>(buffers[i].Data));
+            wsaBuffers[i].len = static_cast<ULONG>(buffers[i].Size);
+        }
+
+        DWORD sentBytes = 0;
+        if (WSASend(_socket, wsaBuffers, static_cast<DWORD>(count), &sentBytes, 0, nullptr, nullptr) == SOCKET_ERROR)
+        {
+            return 0;
+        }
+        return sentBytes;
+    #else
+        iovec ioBuffers[kMaxSendBuffers];
+        for (size_t i = 0; i < count; i++)
+        {
+            ioBuffers[i].iov_base = const_cast<void*>(buffers[i].Data);
+            ioBuffers[i].iov_len = buffers[i].Size;
+        }
+
+        msghdr message{};
+        message.msg_iov = ioBuffers;
+        message.msg_iovlen = count;
+        auto sentBytes = sendmsg(_socket, &message, FLAG_NO_PIPE);
+        if (sentBytes == SOCKET_ERROR)
+        {
+            return 0;
+        }
+        return static_cast<size_t>(sentBytes);
+    #endif
+    }
+
     NetworkReadPacket ReceiveData(void* buffer, size_t size, size_t* sizeReceived) override
     {
         if (_status != SocketStatus::Connected)
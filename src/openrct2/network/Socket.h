@@ -43,6 +43,18 @@ struct INetworkEndpoint
     virtual std::string GetHostname() const = 0;
 };
 
+// The most buffers passed to a single vectored send, well within IOV_MAX on all platforms.
+constexpr size_t kMaxSendBuffers = 64;
+
+/**
+ * A block of memory to send as part of a vectored send.
+ */
+struct NetworkSendBuffer
+{
+    const void* Data;
+    size_t Size;
+};
+
 /**
  * Represents a TCP socket / connection or listener.
  */
@@ -64,6 +76,11 @@ public:
     virtual void ConnectAsync(const std::string& address, uint16_t port) = 0;
 
     virtual size_t SendData(const void* buffer, size_t size) = 0;
+    /**
+     * Sends as much of the buffers, in order, as the socket takes without blocking, in a single system call.
+     * Only the first kMaxSendBuffers buffers are used. Returns the number of bytes sent.
+     */
+    virtual size_t SendData(const NetworkSendBuffer* buffers, size_t count) = 0;
     virtual NetworkReadPacket ReceiveData(void* buffer, size_t size, size_t* sizeReceived) = 0;
 
     virtual void SetNoDelay(bool noDelay) = 0;
@@ -15,11 +15,13 @@
 #include "../audio/Audio.h"
 #include "../core/Console.hpp"
 #include "../core/EnumUtils.hpp"
-#include "../core/JobPool.h"
 #include "../core/Memory.hpp"
+#include "../core/TaskScheduler.h"
 #include "../localisation/StringIds.h"
+#include "../paint/PaintCache.h"
 #include "../ride/Ride.h"
 #include "../ride/RideAudio.h"
+#include "../world/SurroundingsIndex.h"
 #include "../ui/WindowManager.h"
 #include "BannerSceneryEntry.h"
 #include "LargeSceneryObject.h"
@@ -516,6 +518,11 @@ private:
                 sgObject->UpdateEntryIndexes();
             }
         }
+
+        // Path additions are counted differently depending on whether their object is loaded.
+        SurroundingsIndex::InvalidateAll();
+        // Retained paint refers to the images of the objects that were loaded.
+        PaintCache::InvalidateAll();
     }
 
     ObjectEntryIndex GetPrimarySceneryGroupEntryIndex(Object* loadedObject)
@@ -637,20 +644,32 @@ private:
             numProcessed++;
         };
 
-        auto completionFn = [&]() {
-            if (reportProgress && (numProcessed % 100) == 0)
-                ReportProgress(numProcessed, numRequired);
+        auto lastReported = 0;
+        auto reportFn = [&]() {
+            if (!reportProgress)
+                return;
+
+            int32_t processed;
+            {
+                std::lock_guard<std::mutex> guard(commonMutex);
+                processed = numProcessed;
+            }
+            if (processed - lastReported >= 100)
+            {
+                lastReported = processed;
+                ReportProgress(processed, numRequired);
+            }
         };
 
         // Dispatch loading the objects
-        JobPool jobs{};
+        TaskGroup jobs;
         for (auto* object : objectsToLoad)
         {
-            jobs.AddTask([object, &loadSingleObject]() { loadSingleObject(object); }, completionFn);
+            jobs.Run([object, &loadSingleObject]() { loadSingleObject(object); });
         }
 
         // Wait until all jobs are fully completed
-        jobs.Join();
+        jobs.Wait(reportFn);
 
         // Assign the loaded objects to the required objects
         for (auto& requiredObject : requiredObjects)
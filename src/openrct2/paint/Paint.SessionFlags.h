@@ -15,4 +15,6 @@ namespace OpenRCT2::PaintSessionFlags
 {
     constexpr uint8_t PassedSurface = 1u << 0;
     constexpr uint8_t IsTrackPiecePreview = 1u << 1;
+    // Set by elements that look different from one frame to the next, so the tile can not be retained.
+    constexpr uint8_t IsAnimated = 1u << 2;
 } // namespace OpenRCT2::PaintSessionFlags
@@ -22,13 +22,17 @@
 #include "../paint/Painter.h"
 #include "../platform/Memory.h"
 #include "../profiling/Profiling.h"
+#include "../world/Map.h"
+#include "../world/TileHeightMap.h"
 #include "Boundbox.h"
 #include "Paint.Entity.h"
+#include "VirtualFloor.h"
 #include "tile_element/Paint.TileElement.h"
 
 #include <algorithm>
 #include <array>
 #include <cassert>
+#include <vector>
 
 using namespace OpenRCT2;
 using namespace OpenRCT2::Numerics;
@@ -58,6 +62,7 @@ bool gShowDirtyVisuals;
 bool gPaintBoundingBoxes;
 bool gPaintBlockedTiles;
 bool gPaintStableSort;
+bool gPaintCullByHeight = true;
 
 static void PaintPSImageWithBoundingBoxes(PaintSession& session, PaintStruct* ps, ImageId imageId, int32_t x, int32_t y);
 static ImageId PaintPSColourifyImage(const PaintStruct* ps, ImageId imageId, uint32_t viewFlags);
@@ -88,7 +93,7 @@ static int32_t RemapPositionToQuadrant(const PaintStruct& ps, uint8_t rotation)
     return 0;
 }
 
-static void PaintSessionAddPSToQuadrant(PaintSession& session, PaintStruct* ps)
+void PaintSessionAddPSToQuadrant(PaintSession& session, PaintStruct* ps)
 {
     const auto positionHash = RemapPositionToQuadrant(*ps, session.CurrentRotation);
 
@@ -267,6 +272,50 @@ static PaintStruct* CreateNormalPaintStructHeight(
     return ps;
 }
 
+static Profiling::Counter _heightCulledTilesCounter("Tiles culled by height");
+
+/**
+ * Tells which tiles are too far below the area being painted for their elements to show, going by the height map
+ * instead of their elements. Uses the same test as PaintTileElementBase, so it only saves looking at the elements.
+ */
+class TileHeightCulling
+{
+    const PaintSession& _session;
+    int32_t _bottom;
+    int32_t _minZ{};
+    bool _arrow;
+
+public:
+    explicit TileHeightCulling(const PaintSession& session)
+        : _session(session)
+        , _bottom(session.DPI.WorldY() + session.DPI.WorldHeight())
+        , _arrow((gMapSelectFlags & MAP_SELECT_FLAG_ENABLE_ARROW) != 0)
+    {
+        // Tiles on the virtual floor are painted at least as tall as the floor.
+        if (Config::Get().general.VirtualFloorStyle != VirtualFloorStyles::Off && VirtualFloorIsEnabled())
+        {
+            _minZ = VirtualFloorGetHeight();
+        }
+    }
+
+    bool IsBelow(const CoordsXY& mapTile) const
+    {
+        if (!gPaintCullByHeight)
+            return false;
+
+        // Blank tiles outside the map and the construction arrow are painted regardless of the tile elements.
+        if (MapIsEdge(mapTile) || (_arrow && mapTile == CoordsXY(gMapSelectArrowPosition)))
+            return false;
+
+        // The back corner of the tile is 16 pixels above its centre.
+        const auto screenMinY = Translate3DTo2DWithZ(_session.CurrentRotation, { mapTile.ToTileCentre(), 0 }).y - 16;
+        const auto tileCoords = TileCoordsXY(mapTile);
+        if (screenMinY - (std::max(TileHeightMap::GetBlockMaxZ(tileCoords), _minZ) + 32) >= _bottom)
+            return true;
+        return screenMinY - (std::max(TileHeightMap::GetTileMaxZ(tileCoords), _minZ) + 32) >= _bottom;
+    }
+};
+
 template<uint8_t direction>
 void PaintSessionGenerateRotate(PaintSession& session)
 {
@@ -291,16 +340,25 @@ void PaintSessionGenerateRotate(PaintSession& session)
     };
     constexpr CoordsXY nextVerticalTile = CoordsXY{ 32, 32 }.Rotate(direction);
 
+    // Entities are not part of the height map and may be anywhere above their tile, so they are always set up.
+    const TileHeightCulling culling(session);
+    uint64_t culledTiles = 0;
     for (; numVerticalTiles > 0; --numVerticalTiles)
     {
-        TileElementPaintSetup(session, mapTile);
+        if (!culling.IsBelow(mapTile))
+            TileElementPaintSetup(session, mapTile);
+        else
+            culledTiles++;
         EntityPaintSetup(session, mapTile);
 
         const auto loc1 = mapTile + adjacentTiles[0];
         EntityPaintSetup(session, loc1);
 
         const auto loc2 = mapTile + adjacentTiles[1];
-        TileElementPaintSetup(session, loc2);
+        if (!culling.IsBelow(loc2))
+            TileElementPaintSetup(session, loc2);
+        else
+            culledTiles++;
         EntityPaintSetup(session, loc2);
 
         const auto loc3 = mapTile + adjacentTiles[2];
@@ -308,6 +366,7 @@ void PaintSessionGenerateRotate(PaintSession& session)
 
         mapTile += nextVerticalTile;
     }
+    _heightCulledTilesCounter.Add(culledTiles);
 }
 
 /**
@@ -316,6 +375,8 @@ void PaintSessionGenerateRotate(PaintSession& session)
  */
 void PaintSessionGenerate(PaintSession& session)
 {
+    PROFILED_FUNCTION();
+
     switch (DirectionFlipXAxis(session.CurrentRotation))
     {
         case 0:
@@ -565,7 +626,183 @@ static void PaintStructsSortQuadrantStable(PaintStruct* parent, PaintStruct* chi
     }
 }
 
+// Copy of a node taking part in the sorting of a quadrant.
+struct BoundedSortNode
+{
+    PaintStructBoundBox Bounds;
+    uint8_t SortFlags;
+};
+
+// Range of the starting coordinates of the neighbours in a run of nodes, to skip runs none of which can be moved.
+struct BoundedSortBlock
+{
+    int32_t MinX;
+    int32_t MaxX;
+    int32_t MinY;
+    int32_t MaxY;
+    int32_t MinZ;
+};
+
+static constexpr size_t kBoundedSortBlockSize = 16;
+// Quadrants with fewer nodes are sorted faster by walking the list.
+static constexpr size_t kBoundedSortMinNodes = 256;
+
+// Returns false if CheckBoundingBox fails for every neighbour in the block.
+template<uint8_t TRotation>
+static bool CheckBoundingBoxBlock(const PaintStructBoundBox& initialBBox, const BoundedSortBlock& block)
+{
+    if (initialBBox.z_end < block.MinZ)
+        return false;
+
+    if constexpr (TRotation == 0)
+        return initialBBox.y_end >= block.MinY && initialBBox.x_end >= block.MinX;
+    else if constexpr (TRotation == 1)
+        return initialBBox.y_end >= block.MinY && initialBBox.x_end < block.MaxX;
+    else if constexpr (TRotation == 2)
+        return initialBBox.y_end < block.MaxY && initialBBox.x_end < block.MaxX;
+    else
+        return initialBBox.y_end < block.MaxY && initialBBox.x_end >= block.MinX;
+}
+
+static void BoundedSortUpdateBlocks(
+    const std::vector<BoundedSortNode>& nodes, const std::vector<uint32_t>& order, std::vector<BoundedSortBlock>& blocks,
+    size_t begin, size_t end)
+{
+    for (auto blockIndex = begin / kBoundedSortBlockSize; blockIndex * kBoundedSortBlockSize < end; blockIndex++)
+    {
+        BoundedSortBlock block = { INT32_MAX, INT32_MIN, INT32_MAX, INT32_MIN, INT32_MAX };
+        const auto blockEnd = std::min(order.size(), (blockIndex + 1) * kBoundedSortBlockSize);
+        for (auto i = blockIndex * kBoundedSortBlockSize; i < blockEnd; i++)
+        {
+            const auto& node = nodes[order[i]];
+            if (!(node.SortFlags & PaintSortFlags::Neighbour))
+                continue;
+
+            block.MinX = std::min(block.MinX, node.Bounds.x);
+            block.MaxX = std::max(block.MaxX, node.Bounds.x);
+            block.MinY = std::min(block.MinY, node.Bounds.y);
+            block.MaxY = std::max(block.MaxY, node.Bounds.y);
+            block.MinZ = std::min(block.MinZ, node.Bounds.z);
+        }
+        blocks[blockIndex] = block;
+    }
+}
+
+// Sorts the nodes following psQuadrantEntry into the same order as PaintStructsSortQuadrantLegacy or
+// PaintStructsSortQuadrantStable would. The order is kept in an array split into blocks, and each visited node is
+// only compared with the nodes of blocks that hold a neighbour it could be moved behind. This is still quadratic in the
+// number of nodes, skipping blocks only saves up to a factor of the block size over walking the list. Returns false
+// without sorting if there are too few nodes for this to pay off.
 template<bool TStableSort, uint8_t TRotation>
+static bool PaintStructsSortQuadrantBounded(PaintStruct* psQuadrantEntry)
+{
+    size_t numNodes = 0;
+    for (auto* ps = psQuadrantEntry->NextQuadrantEntry;
+         ps != nullptr && !(ps->SortFlags & PaintSortFlags::OutsideQuadrant) && numNodes < kBoundedSortMinNodes;
+         ps = ps->NextQuadrantEntry)
+    {
+        numNodes++;
+    }
+    if (numNodes < kBoundedSortMinNodes)
+        return false;
+
+    // Only used by the thread arranging the session, so the buffers are reused between quadrants.
+    static thread_local std::vector<PaintStruct*> paintStructs;
+    static thread_local std::vector<BoundedSortNode> nodes;
+    static thread_local std::vector<uint32_t> order;
+    static thread_local std::vector<BoundedSortBlock> blocks;
+    static thread_local std::vector<size_t> moved;
+    static thread_local std::vector<uint32_t> reordered;
+
+    paintStructs.clear();
+    nodes.clear();
+    order.clear();
+    PaintStruct* psEnd = psQuadrantEntry->NextQuadrantEntry;
+    for (; psEnd != nullptr && !(psEnd->SortFlags & PaintSortFlags::OutsideQuadrant); psEnd = psEnd->NextQuadrantEntry)
+    {
+        order.push_back(static_cast<uint32_t>(nodes.size()));
+        paintStructs.push_back(psEnd);
+        nodes.push_back({ psEnd->Bounds, psEnd->SortFlags });
+    }
+
+    blocks.resize((order.size() + kBoundedSortBlockSize - 1) / kBoundedSortBlockSize);
+    BoundedSortUpdateBlocks(nodes, order, blocks, 0, order.size());
+
+    size_t pendingSearchStart = 0;
+    for (;;)
+    {
+        auto childIndex = pendingSearchStart;
+        while (childIndex < order.size() && !(nodes[order[childIndex]].SortFlags & PaintSortFlags::PendingVisit))
+            childIndex++;
+        if (childIndex == order.size())
+            break;
+
+        auto& child = nodes[order[childIndex]];
+        child.SortFlags &= ~PaintSortFlags::PendingVisit;
+        const auto initialBBox = child.Bounds;
+
+        moved.clear();
+        for (auto i = childIndex + 1; i < order.size();)
+        {
+            if (i % kBoundedSortBlockSize == 0
+                && !CheckBoundingBoxBlock<TRotation>(initialBBox, blocks[i / kBoundedSortBlockSize]))
+            {
+                i += kBoundedSortBlockSize;
+                continue;
+            }
+
+            const auto& node = nodes[order[i]];
+            if ((node.SortFlags & PaintSortFlags::Neighbour) && CheckBoundingBox<TRotation>(initialBBox, node.Bounds))
+                moved.push_back(i);
+            i++;
+        }
+
+        // The search for the next node to visit restarts at the moved nodes, now in front of the child.
+        pendingSearchStart = childIndex;
+        if (moved.empty())
+            continue;
+
+        // Nodes past the last moved one keep their position.
+        const auto end = moved.back() + 1;
+        reordered.clear();
+        // The stable sort keeps the moved nodes in order, the legacy sort moves each one to the front in turn.
+        if constexpr (TStableSort)
+        {
+            for (auto index : moved)
+                reordered.push_back(order[index]);
+        }
+        else
+        {
+            for (auto it = moved.rbegin(); it != moved.rend(); it++)
+                reordered.push_back(order[*it]);
+        }
+        reordered.push_back(order[childIndex]);
+        for (auto i = childIndex + 1, nextMoved = size_t{ 0 }; i < end; i++)
+        {
+            if (i == moved[nextMoved])
+            {
+                nextMoved++;
+                continue;
+            }
+            reordered.push_back(order[i]);
+        }
+        std::copy(reordered.begin(), reordered.end(), order.begin() + childIndex);
+        BoundedSortUpdateBlocks(nodes, order, blocks, childIndex, end);
+    }
+
+    auto* ps = psQuadrantEntry;
+    for (auto index : order)
+    {
+        auto* next = paintStructs[index];
+        next->SortFlags = nodes[index].SortFlags;
+        ps->NextQuadrantEntry = next;
+        ps = next;
+    }
+    ps->NextQuadrantEntry = psEnd;
+    return true;
+}
+
+template<bool TStableSort, bool TBoundedSort, uint8_t TRotation>
 static PaintStruct* PaintArrangeStructsHelperRotation(PaintStruct* psQuadrantEntry, uint16_t quadrantIndex, uint8_t flag)
 {
     // We keep track of the first node in the quadrant so the next call with a higher quadrant index
@@ -576,6 +813,12 @@ static PaintStruct* PaintArrangeStructsHelperRotation(PaintStruct* psQuadrantEnt
     // sorting relevancy.
     PaintStructsInitializeSort(psQuadrantEntry, quadrantIndex, flag);
 
+    if constexpr (TBoundedSort)
+    {
+        if (PaintStructsSortQuadrantBounded<TStableSort, TRotation>(psQuadrantEntry))
+            return psQuadrantEntry;
+    }
+
     // Iterate all nodes in the current list and re-order them based on
     // the current rotation and their bounding box.
     for (auto* ps = psQuadrantEntry; ps != nullptr;)
@@ -626,7 +869,7 @@ static void PaintStructsLinkQuadrants(PaintSessionCore& session, PaintStruct& ps
     } while (++quadrantIndex <= session.QuadrantFrontIndex);
 }
 
-template<bool TStableSort, int TRotation>
+template<bool TStableSort, bool TBoundedSort, int TRotation>
 static void PaintSessionArrangeImpl(PaintSessionCore& session)
 {
     uint32_t quadrantIndex = session.QuadrantBackIndex;
@@ -641,12 +884,12 @@ static void PaintSessionArrangeImpl(PaintSessionCore& session)
     PaintStruct psHead{};
     PaintStructsLinkQuadrants(session, psHead);
 
-    PaintStruct* psNextQuadrant = PaintArrangeStructsHelperRotation<TStableSort, TRotation>(
+    PaintStruct* psNextQuadrant = PaintArrangeStructsHelperRotation<TStableSort, TBoundedSort, TRotation>(
         &psHead, session.QuadrantBackIndex, PaintSortFlags::Neighbour);
 
     while (++quadrantIndex < session.QuadrantFrontIndex)
     {
-        psNextQuadrant = PaintArrangeStructsHelperRotation<TStableSort, TRotation>(
+        psNextQuadrant = PaintArrangeStructsHelperRotation<TStableSort, TBoundedSort, TRotation>(
             psNextQuadrant, quadrantIndex, PaintSortFlags::None);
     }
 
@@ -656,17 +899,31 @@ static void PaintSessionArrangeImpl(PaintSessionCore& session)
 using PaintArrangeWithRotation = void (*)(PaintSessionCore& session);
 
 constexpr std::array _paintArrangeFuncsLegacy = {
-    PaintSessionArrangeImpl<false, 0>,
-    PaintSessionArrangeImpl<false, 1>,
-    PaintSessionArrangeImpl<false, 2>,
-    PaintSessionArrangeImpl<false, 3>,
+    PaintSessionArrangeImpl<false, false, 0>,
+    PaintSessionArrangeImpl<false, false, 1>,
+    PaintSessionArrangeImpl<false, false, 2>,
+    PaintSessionArrangeImpl<false, false, 3>,
 };
 
 constexpr std::array _paintArrangeFuncsStable = {
-    PaintSessionArrangeImpl<true, 0>,
-    PaintSessionArrangeImpl<true, 1>,
-    PaintSessionArrangeImpl<true, 2>,
-    PaintSessionArrangeImpl<true, 3>,
+    PaintSessionArrangeImpl<true, false, 0>,
+    PaintSessionArrangeImpl<true, false, 1>,
+    PaintSessionArrangeImpl<true, false, 2>,
+    PaintSessionArrangeImpl<true, false, 3>,
+};
+
+constexpr std::array _paintArrangeFuncsLegacyBounded = {
+    PaintSessionArrangeImpl<false, true, 0>,
+    PaintSessionArrangeImpl<false, true, 1>,
+    PaintSessionArrangeImpl<false, true, 2>,
+    PaintSessionArrangeImpl<false, true, 3>,
+};
+
+constexpr std::array _paintArrangeFuncsStableBounded = {
+    PaintSessionArrangeImpl<true, true, 0>,
+    PaintSessionArrangeImpl<true, true, 1>,
+    PaintSessionArrangeImpl<true, true, 2>,
+    PaintSessionArrangeImpl<true, true, 3>,
 };
 
 /**
@@ -676,11 +933,15 @@ constexpr std::array _paintArrangeFuncsStable = {
 void PaintSessionArrange(PaintSessionCore& session)
 {
     PROFILED_FUNCTION();
+    // Both sorts give the same order with or without bounding the comparisons, the option allows comparing them.
+    const bool boundedSort = Config::Get().general.BoundedPaintSort;
     if (gPaintStableSort)
     {
-        return _paintArrangeFuncsStable[session.CurrentRotation](session);
+        const auto& funcs = boundedSort ? _paintArrangeFuncsStableBounded : _paintArrangeFuncsStable;
+        return funcs[session.CurrentRotation](session);
     }
-    return _paintArrangeFuncsLegacy[session.CurrentRotation](session);
+    const auto& funcs = boundedSort ? _paintArrangeFuncsLegacyBounded : _paintArrangeFuncsLegacy;
+    return funcs[session.CurrentRotation](session);
 }
 
 static inline void PaintAttachedPS(RenderTarget& rt, PaintStruct* ps, uint32_t viewFlags)
@@ -187,12 +187,34 @@ struct PaintNodeStorage
         fixedPaintEntries.clear();
         dynamicPaintEntries.reset();
     }
+
+    size_t size() const
+    {
+        return fixedPaintEntries.size() + (dynamicPaintEntries.has_value() ? dynamicPaintEntries->size() : 0);
+    }
+
+    // Entries are numbered in the order they were allocated.
+    PaintEntry& operator[](size_t index)
+    {
+        if (index < fixedPaintEntries.size())
+        {
+            return fixedPaintEntries[index];
+        }
+        return (*dynamicPaintEntries)[index - fixedPaintEntries.size()];
+    }
 };
 
+namespace OpenRCT2::PaintCache
+{
+    struct Column;
+}
+
 struct PaintSession : public PaintSessionCore
 {
     RenderTarget DPI;
     PaintNodeStorage paintEntries;
+    // The retained tile paint of the viewport column being painted, nullptr when tiles are always painted anew.
+    OpenRCT2::PaintCache::Column* CacheColumn;
 
     PaintStruct* AllocateNormalPaintEntry() noexcept
     {
@@ -257,6 +279,8 @@ extern bool gPaintBoundingBoxes;
 extern bool gPaintBlockedTiles;
 extern bool gPaintWidePathsAsGhost;
 extern bool gPaintStableSort;
+// Skips tiles the height map shows to be below the painted area, can be turned off to paint every tile.
+extern bool gPaintCullByHeight;
 
 PaintStruct* PaintAddImageAsParent(
     PaintSession& session, const ImageId image_id, const CoordsXYZ& offset, const BoundBoxXYZ& boundBox);
@@ -307,6 +331,7 @@ void PaintFloatingMoneyEffect(
     PaintSession& session, money64 amount, StringId string_id, int32_t y, int32_t z, int8_t y_offsets[], int32_t offset_x,
     uint32_t rotation);
 
+void PaintSessionAddPSToQuadrant(PaintSession& session, PaintStruct* ps);
 PaintSession* PaintSessionAlloc(RenderTarget& rt, uint32_t viewFlags, uint8_t rotation);
 void PaintSessionFree(PaintSession* session);
 void PaintSessionGenerate(PaintSession& session);
@@ -0,0 +1,699 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2025 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "PaintCache.h"
+
+#include "../config/Config.h"
+#include "../drawing/LightFX.h"
+#include "../interface/Viewport.h"
+#include "../profiling/Profiling.h"
+#include "../ride/TrackDesign.h"
+#include "../world/Map.h"
+#include "../world/tile_element/TileElement.h"
+#include "Paint.SessionFlags.h"
+#include "Paint.h"
+#include "tile_element/Paint.TileElement.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace OpenRCT2::PaintCache
+{
+    // Columns of views that have not been painted for the longest time are dropped beyond this.
+    static constexpr size_t kMaxColumns = 256;
+    // Tiles retained by all columns are kept within this many bytes, least recently painted columns are dropped first.
+    static constexpr size_t kMemoryBudget = 64 * 1024 * 1024;
+    // A column that has retained this many bytes is cleared, most of its tiles will have been scrolled out of view.
+    static constexpr size_t kMaxColumnSize = kMemoryBudget / 16;
+    // Estimated size of the hash map node and allocator bookkeeping of a retained tile.
+    static constexpr size_t kTileOverhead = 64;
+    // Tiles painting more than this are painted anew, links between retained structs are stored as int16_t.
+    static constexpr size_t kMaxEntriesPerTile = 4096;
+
+    static constexpr int16_t kNone = -1;
+    // The pointer was left as it was before the tile was painted.
+    static constexpr int16_t kUnchanged = -2;
+
+    struct RetainedPaintStruct
+    {
+        PaintStruct ps;
+        int16_t children;
+        int16_t attached;
+        int16_t element;
+    };
+
+    struct RetainedAttachedPaintStruct
+    {
+        AttachedPaintStruct ps;
+        int16_t next;
+    };
+
+    struct RetainedTile
+    {
+        const TileElement* firstElement{};
+        std::vector<TileElement> elements;
+
+        // Tiles that can not be retained keep their elements, so they are not recorded again until they change.
+        bool isRetained{};
+
+        // Paint functions may link to the previous paint struct, so the tile is only replayed when these match.
+        bool lastPSWasNull{};
+        bool lastAttachedPSWasNull{};
+        bool woodenSupportsPrependToWasNull{};
+
+        std::vector<RetainedPaintStruct> paintStructs;
+        std::vector<RetainedAttachedPaintStruct> attachedPaintStructs;
+        // Paint structs added to the quadrants, in the order they were added.
+        std::vector<int16_t> quadrantEntries;
+
+        // Session state after the tile was painted, as indices of the retained structs or elements of the tile.
+        int16_t lastPS{};
+        int16_t lastAttachedPS{};
+        int16_t woodenSupportsPrependTo{};
+        int16_t currentlyDrawnTileElement{};
+        int16_t surface{};
+        int16_t pathElementOnSameHeight{};
+        int16_t trackElementOnSameHeight{};
+        CoordsXY spritePosition;
+        ImageId trackColours;
+        ImageId supportColours;
+        uint8_t flags{};
+        ViewportInteractionItem interactionType{};
+    };
+
+    struct ColumnKey
+    {
+        int32_t cullingX;
+        int32_t cullingY;
+        int32_t cullingWidth;
+        int32_t cullingHeight;
+        uint32_t viewFlags;
+        ZoomLevel zoom;
+        uint8_t rotation;
+
+        bool operator==(const ColumnKey& other) const
+        {
+            return cullingX == other.cullingX && cullingY == other.cullingY && cullingWidth == other.cullingWidth
+                && cullingHeight == other.cullingHeight && viewFlags == other.viewFlags && zoom == other.zoom
+                && rotation == other.rotation;
+        }
+    };
+
+    struct Column
+    {
+        ColumnKey key;
+        uint32_t generation{};
+        uint64_t lastUsed{};
+        bool inUse{};
+        std::unordered_map<uint32_t, RetainedTile> tiles;
+        // Bytes used by the tiles, only changed by the thread painting the column.
+        size_t size{};
+        // The part of the size that is included in the size of all columns, only changed while holding the mutex.
+        size_t countedSize{};
+    };
+
+    static std::mutex _mutex;
+    static std::vector<std::unique_ptr<Column>> _columns;
+    static uint64_t _acquireCount;
+    static std::atomic<uint32_t> _generation{ 0 };
+    static uint8_t _lastSettings;
+    static size_t _size;
+
+    void InvalidateAll()
+    {
+        _generation.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    static bool CanRetainTiles(const PaintSession& session)
+    {
+        // Highlights follow the cursor and debug overlays are drawn from state outside of the tile elements.
+        if (gMapSelectFlags & (MAP_SELECT_FLAG_ENABLE | MAP_SELECT_FLAG_ENABLE_CONSTRUCT))
+            return false;
+        if (session.SelectedElement != nullptr || gTrackDesignSaveMode)
+            return false;
+        if (session.ViewFlags & VIEWPORT_FLAG_CLIP_VIEW)
+            return false;
+        if (gShowSupportSegmentHeights || gPaintBlockedTiles || gPaintWidePathsAsGhost)
+            return false;
+        // Painting tiles places lights as well.
+        if (Drawing::LightFx::IsAvailable())
+            return false;
+        return true;
+    }
+
+    // The options paint functions read straight from the configuration.
+    static uint8_t GetSettings()
+    {
+        const auto& general = Config::Get().general;
+        uint8_t settings = 0;
+        if (general.LandscapeSmoothing)
+            settings |= 1u << 0;
+        if (general.TransparentWater)
+            settings |= 1u << 1;
+        if (general.UpperCaseBanners)
+            settings |= 1u << 2;
+        return settings;
+    }
+
+    Column* AcquireColumn(const PaintSession& session)
+    {
+        if (!CanRetainTiles(session))
+            return nullptr;
+
+        const auto& rt = session.DPI;
+        const ColumnKey key = {
+            rt.cullingX,       rt.cullingY,  rt.cullingWidth,         rt.cullingHeight,
+            session.ViewFlags, rt.zoom_level, session.CurrentRotation,
+        };
+
+        std::lock_guard lock(_mutex);
+        _acquireCount++;
+
+        const auto settings = GetSettings();
+        if (settings != _lastSettings)
+        {
+            _lastSettings = settings;
+            InvalidateAll();
+        }
+
+        auto it = std::find_if(_columns.begin(), _columns.end(), [&](const auto& column) { return column->key == key; });
+        Column* column = nullptr;
+        if (it != _columns.end())
+        {
+            column = it->get();
+            // Two views painting the same area at the same time simply do not retain anything.
+            if (column->inUse)
+                return nullptr;
+        }
+        else
+        {
+            if (_columns.size() >= kMaxColumns)
+            {
+                auto oldest = std::min_element(_columns.begin(), _columns.end(), [](const auto& a, const auto& b) {
+                    return !a->inUse && (b->inUse || a->lastUsed < b->lastUsed);
+                });
+                if ((*oldest)->inUse)
+                    return nullptr;
+                _size -= (*oldest)->countedSize;
+                _columns.erase(oldest);
+            }
+            column = _columns.emplace_back(std::make_unique<Column>()).get();
+            column->key = key;
+            column->generation = _generation.load(std::memory_order_relaxed);
+        }
+
+        const auto generation = _generation.load(std::memory_order_relaxed);
+        if (column->generation != generation || column->size >= kMaxColumnSize)
+        {
+            _size -= column->countedSize;
+            column->tiles.clear();
+            column->size = 0;
+            column->countedSize = 0;
+            column->generation = generation;
+        }
+        column->lastUsed = _acquireCount;
+        column->inUse = true;
+        return column;
+    }
+
+    void ReleaseColumn(Column* column)
+    {
+        if (column == nullptr)
+            return;
+
+        std::lock_guard lock(_mutex);
+        column->inUse = false;
+        _size = _size - column->countedSize + column->size;
+        column->countedSize = column->size;
+
+        while (_size > kMemoryBudget)
+        {
+            auto oldest = std::min_element(_columns.begin(), _columns.end(), [](const auto& a, const auto& b) {
+                return !a->inUse && (b->inUse || a->lastUsed < b->lastUsed);
+            });
+            if ((*oldest)->inUse)
+                break;
+            _size -= (*oldest)->countedSize;
+            _columns.erase(oldest);
+        }
+    }
+
+    static size_t GetTileSize(const RetainedTile& tile)
+    {
+        return sizeof(RetainedTile) + kTileOverhead + tile.elements.capacity() * sizeof(TileElement)
+            + tile.paintStructs.capacity() * sizeof(RetainedPaintStruct)
+            + tile.attachedPaintStructs.capacity() * sizeof(RetainedAttachedPaintStruct)
+            + tile.quadrantEntries.capacity() * sizeof(int16_t);
+    }
+
+    static uint32_t GetTileKey(const CoordsXY& mapPos)
+    {
+        const auto tilePos = TileCoordsXY(mapPos);
+        return (static_cast<uint32_t>(tilePos.x) << 16) | static_cast<uint16_t>(tilePos.y);
+    }
+
+    static bool HasSameElements(const RetainedTile& tile, const TileElement* firstElement)
+    {
+        if (tile.firstElement != firstElement)
+            return false;
+
+        const auto* element = firstElement;
+        for (const auto& retainedElement : tile.elements)
+        {
+            if (std::memcmp(&retainedElement, element, sizeof(TileElement)) != 0)
+                return false;
+            if (element->IsLastForTile())
+                return &retainedElement == &tile.elements.back();
+            element++;
+        }
+        return false;
+    }
+
+    template<typename T>
+    static T* GetRetainedPointer(int16_t index, T* unchanged, T* const* structs)
+    {
+        if (index == kUnchanged)
+            return unchanged;
+        if (index == kNone)
+            return nullptr;
+        return structs[index];
+    }
+
+    static const TileElement* GetRetainedElement(int16_t index, const TileElement* unchanged, const TileElement* firstElement)
+    {
+        if (index == kUnchanged)
+            return unchanged;
+        if (index == kNone)
+            return nullptr;
+        return firstElement + index;
+    }
+
+    static void ReplayTile(PaintSession& session, const RetainedTile& tile, const TileElement* firstElement)
+    {
+        // Only used by the thread painting the column, so the buffers are reused between tiles.
+        static thread_local std::vector<PaintStruct*> paintStructs;
+        static thread_local std::vector<AttachedPaintStruct*> attachedPaintStructs;
+
+        paintStructs.clear();
+        attachedPaintStructs.clear();
+
+        for (const auto& retained : tile.attachedPaintStructs)
+        {
+            auto* ps = session.paintEntries.allocate()->AsAttached();
+            *ps = retained.ps;
+            attachedPaintStructs.push_back(ps);
+        }
+        for (const auto& retained : tile.attachedPaintStructs)
+        {
+            auto* ps = attachedPaintStructs[&retained - tile.attachedPaintStructs.data()];
+            ps->NextEntry = GetRetainedPointer<AttachedPaintStruct>(retained.next, nullptr, attachedPaintStructs.data());
+        }
+
+        auto* element = const_cast<TileElement*>(firstElement);
+        for (const auto& retained : tile.paintStructs)
+        {
+            auto* ps = session.paintEntries.allocate()->AsBasic();
+            *ps = retained.ps;
+            ps->Element = retained.element == kNone ? nullptr : element + retained.element;
+            ps->Entity = session.CurrentlyDrawnEntity;
+            ps->Attached = GetRetainedPointer<AttachedPaintStruct>(retained.attached, nullptr, attachedPaintStructs.data());
+            paintStructs.push_back(ps);
+        }
+        for (const auto& retained : tile.paintStructs)
+        {
+            auto* ps = paintStructs[&retained - tile.paintStructs.data()];
+            ps->Children = GetRetainedPointer<PaintStruct>(retained.children, nullptr, paintStructs.data());
+        }
+
+        for (auto index : tile.quadrantEntries)
+        {
+            PaintSessionAddPSToQuadrant(session, paintStructs[index]);
+        }
+
+        session.LastPS = GetRetainedPointer(tile.lastPS, session.LastPS, paintStructs.data());
+        session.LastAttachedPS = GetRetainedPointer(tile.lastAttachedPS, session.LastAttachedPS, attachedPaintStructs.data());
+        session.WoodenSupportsPrependTo = GetRetainedPointer(
+            tile.woodenSupportsPrependTo, session.WoodenSupportsPrependTo, paintStructs.data());
+        session.CurrentlyDrawnTileElement = const_cast<TileElement*>(
+            GetRetainedElement(tile.currentlyDrawnTileElement, session.CurrentlyDrawnTileElement, firstElement));
+        session.Surface = reinterpret_cast<const SurfaceElement*>(
+            GetRetainedElement(tile.surface, reinterpret_cast<const TileElement*>(session.Surface), firstElement));
+        session.PathElementOnSameHeight = GetRetainedElement(
+            tile.pathElementOnSameHeight, session.PathElementOnSameHeight, firstElement);
+        session.TrackElementOnSameHeight = GetRetainedElement(
+            tile.trackElementOnSameHeight, session.TrackElementOnSameHeight, firstElement);
+        session.SpritePosition = tile.spritePosition;
+        session.TrackColours = tile.trackColours;
+        session.SupportColours = tile.supportColours;
+        session.Flags = tile.flags;
+        session.InteractionType = tile.interactionType;
+    }
+
+    bool TryPaintTile(PaintSession& session, const TileElement* firstElement, TileRecording& recording)
+    {
+        auto* column = session.CacheColumn;
+        if (column == nullptr)
+            return false;
+
+        const auto it = column->tiles.find(GetTileKey(session.MapPosition));
+        if (it != column->tiles.end() && HasSameElements(it->second, firstElement))
+        {
+            const auto& tile = it->second;
+            if (!tile.isRetained)
+                return false;
+
+            if (tile.lastPSWasNull == (session.LastPS == nullptr)
+                && tile.lastAttachedPSWasNull == (session.LastAttachedPS == nullptr)
+                && tile.woodenSupportsPrependToWasNull == (session.WoodenSupportsPrependTo == nullptr))
+            {
+                ReplayTile(session, tile, firstElement);
+                return true;
+            }
+        }
+
+        recording.column = column;
+        recording.firstElement = firstElement;
+        recording.firstEntry = session.paintEntries.size();
+        recording.lastPS = session.LastPS;
+        recording.lastAttachedPS = session.LastAttachedPS;
+        recording.woodenSupportsPrependTo = session.WoodenSupportsPrependTo;
+        recording.lastPSString = session.LastPSString;
+        recording.currentlyDrawnEntity = session.CurrentlyDrawnEntity;
+        recording.currentlyDrawnTileElement = session.CurrentlyDrawnTileElement;
+        recording.surface = session.Surface;
+        recording.pathElementOnSameHeight = session.PathElementOnSameHeight;
+        recording.trackElementOnSameHeight = session.TrackElementOnSameHeight;
+        return false;
+    }
+
+    /**
+     * Works out how the paint structs painted for a tile link to each other. Fails if they link to structs painted
+     * before the tile, or the other way around, as these links would be lost when the tile is replayed.
+     */
+    class TileRecorder
+    {
+    public:
+        TileRecorder(PaintSession& session, const TileRecording& recording, RetainedTile& tile)
+            : _session(session)
+            , _recording(recording)
+            , _tile(tile)
+        {
+            const auto& first = *recording.firstElement;
+            _numElements = 1;
+            for (const auto* element = &first; !element->IsLastForTile(); element++)
+            {
+                _numElements++;
+            }
+        }
+
+        bool Record()
+        {
+            auto& entries = _session.paintEntries;
+            const auto numEntries = entries.size() - _recording.firstEntry;
+            if (numEntries > kMaxEntriesPerTile)
+                return false;
+
+            _entries.clear();
+            for (size_t i = 0; i < numEntries; i++)
+            {
+                _entries.push_back({ &entries[_recording.firstEntry + i], kNone, false });
+            }
+            std::sort(_entries.begin(), _entries.end(), [](const auto& a, const auto& b) { return a.entry < b.entry; });
+
+            FindQuadrantEntries();
+
+            // Visiting a struct adds its children and attached structs, so this reaches everything linked to the
+            // quadrant entries. Anything left over was linked to a struct painted before the tile.
+            for (size_t i = 0; i < _tile.paintStructs.size(); i++)
+            {
+                if (!VisitPaintStruct(i))
+                    return false;
+            }
+            if (_tile.paintStructs.size() + _tile.attachedPaintStructs.size() != numEntries)
+                return false;
+
+            return RecordSessionState();
+        }
+
+    private:
+        struct Entry
+        {
+            const PaintEntry* entry;
+            int16_t index;
+            bool isAttached;
+        };
+
+        Entry* FindEntry(const void* ptr)
+        {
+            auto it = std::lower_bound(_entries.begin(), _entries.end(), ptr, [](const Entry& a, const void* b) {
+                return static_cast<const void*>(a.entry) < b;
+            });
+            if (it == _entries.end() || it->entry != ptr)
+                return nullptr;
+            return &*it;
+        }
+
+        void FindQuadrantEntries()
+        {
+            // The structs added to the quadrants by the tile are at the front of their quadrant lists.
+            for (size_t i = 0; i < _entries.size(); i++)
+            {
+                const auto& candidate = *reinterpret_cast<const PaintStruct*>(_entries[i].entry);
+                const auto quadrantIndex = candidate.QuadrantIndex;
+                if (quadrantIndex >= MaxPaintQuadrants)
+                    continue;
+
+                const auto firstInQuadrant = _tile.quadrantEntries.size();
+                for (auto* ps = _session.Quadrants[quadrantIndex]; ps != nullptr; ps = ps->NextQuadrantEntry)
+                {
+                    auto* entry = FindEntry(ps);
+                    if (entry == nullptr || entry->index != kNone)
+                        break;
+
+                    entry->index = AddPaintStruct(*ps);
+                    _tile.quadrantEntries.push_back(entry->index);
+                }
+                std::reverse(_tile.quadrantEntries.begin() + firstInQuadrant, _tile.quadrantEntries.end());
+            }
+        }
+
+        int16_t AddPaintStruct(const PaintStruct& ps)
+        {
+            auto& retained = _tile.paintStructs.emplace_back();
+            retained.ps = ps;
+            retained.ps.NextQuadrantEntry = nullptr;
+            retained.children = kNone;
+            retained.attached = kNone;
+            retained.element = kNone;
+            return static_cast<int16_t>(_tile.paintStructs.size() - 1);
+        }
+
+        int16_t AddAttachedPaintStruct(const AttachedPaintStruct& ps)
+        {
+            auto& retained = _tile.attachedPaintStructs.emplace_back();
+            retained.ps = ps;
+            retained.next = kNone;
+            return static_cast<int16_t>(_tile.attachedPaintStructs.size() - 1);
+        }
+
+        int16_t GetElementIndex(const TileElement* element) const
+        {
+            if (element == nullptr)
+                return kNone;
+            if (element < _recording.firstElement || element >= _recording.firstElement + _numElements)
+                return kUnchanged;
+            return static_cast<int16_t>(element - _recording.firstElement);
+        }
+
+        // Returns the index of the struct a link of a retained struct points to, which must not have been seen yet.
+        template<bool TIsAttached, typename T>
+        bool GetLinkIndex(const T* ptr, int16_t& index)
+        {
+            index = kNone;
+            if (ptr == nullptr)
+                return true;
+
+            auto* entry = FindEntry(ptr);
+            if (entry == nullptr || entry->index != kNone)
+                return false;
+
+            entry->isAttached = TIsAttached;
+            if constexpr (TIsAttached)
+                entry->index = AddAttachedPaintStruct(*ptr);
+            else
+                entry->index = AddPaintStruct(*ptr);
+            index = entry->index;
+            return true;
+        }
+
+        bool VisitPaintStruct(size_t index)
+        {
+            // Adding structs may move the retained structs, so copy what is needed first.
+            const auto ps = _tile.paintStructs[index].ps;
+            if (ps.Entity != _recording.currentlyDrawnEntity)
+                return false;
+
+            const auto element = GetElementIndex(ps.Element);
+            if (element == kUnchanged)
+                return false;
+
+            int16_t children;
+            int16_t attached;
+            if (!GetLinkIndex<false>(ps.Children, children) || !GetLinkIndex<true>(ps.Attached, attached))
+                return false;
+
+            auto& retained = _tile.paintStructs[index];
+            retained.children = children;
+            retained.attached = attached;
+            retained.element = element;
+            retained.ps.Children = nullptr;
+            retained.ps.Attached = nullptr;
+
+            for (auto next = attached; next != kNone;)
+            {
+                auto& retainedAttached = _tile.attachedPaintStructs[next];
+                int16_t following;
+                if (!GetLinkIndex<true>(retainedAttached.ps.NextEntry, following))
+                    return false;
+
+                // Reference again, adding the next struct may have moved this one.
+                _tile.attachedPaintStructs[next].next = following;
+                _tile.attachedPaintStructs[next].ps.NextEntry = nullptr;
+                next = following;
+            }
+            return true;
+        }
+
+        template<bool TIsAttached>
+        bool GetStateIndex(const void* ptr, const void* before, int16_t& index)
+        {
+            if (ptr == nullptr)
+            {
+                index = kNone;
+                return true;
+            }
+            auto* entry = FindEntry(ptr);
+            if (entry != nullptr && entry->index != kNone && entry->isAttached == TIsAttached)
+            {
+                index = entry->index;
+                return true;
+            }
+            index = kUnchanged;
+            return ptr == before;
+        }
+
+        bool GetStateElementIndex(const TileElement* element, const TileElement* before, int16_t& index)
+        {
+            index = GetElementIndex(element);
+            return index != kUnchanged || element == before;
+        }
+
+        bool RecordSessionState()
+        {
+            const auto& session = _session;
+            if (session.LastPSString != _recording.lastPSString
+                || session.CurrentlyDrawnEntity != _recording.currentlyDrawnEntity)
+                return false;
+
+            _tile.lastPSWasNull = _recording.lastPS == nullptr;
+            _tile.lastAttachedPSWasNull = _recording.lastAttachedPS == nullptr;
+            _tile.woodenSupportsPrependToWasNull = _recording.woodenSupportsPrependTo == nullptr;
+
+            if (!GetStateIndex<false>(session.LastPS, _recording.lastPS, _tile.lastPS)
+                || !GetStateIndex<true>(session.LastAttachedPS, _recording.lastAttachedPS, _tile.lastAttachedPS)
+                || !GetStateIndex<false>(
+                    session.WoodenSupportsPrependTo, _recording.woodenSupportsPrependTo, _tile.woodenSupportsPrependTo))
+                return false;
+
+            if (!GetStateElementIndex(
+                    session.CurrentlyDrawnTileElement, _recording.currentlyDrawnTileElement, _tile.currentlyDrawnTileElement)
+                || !GetStateElementIndex(
+                    reinterpret_cast<const TileElement*>(session.Surface),
+                    reinterpret_cast<const TileElement*>(_recording.surface), _tile.surface)
+                || !GetStateElementIndex(
+                    session.PathElementOnSameHeight, _recording.pathElementOnSameHeight, _tile.pathElementOnSameHeight)
+                || !GetStateElementIndex(
+                    session.TrackElementOnSameHeight, _recording.trackElementOnSameHeight, _tile.trackElementOnSameHeight))
+                return false;
+
+            _tile.spritePosition = session.SpritePosition;
+            _tile.trackColours = session.TrackColours;
+            _tile.supportColours = session.SupportColours;
+            _tile.flags = session.Flags;
+            _tile.interactionType = session.InteractionType;
+            return true;
+        }
+
+        PaintSession& _session;
+        const TileRecording& _recording;
+        RetainedTile& _tile;
+        size_t _numElements;
+
+        // Sorted by address, only used while recording a tile.
+        static thread_local std::vector<Entry> _entries;
+    };
+
+    thread_local std::vector<TileRecorder::Entry> TileRecorder::_entries;
+
+    static void RecordTile(PaintSession& session, const TileRecording& recording, RetainedTile& tile)
+    {
+        tile.firstElement = recording.firstElement;
+        const auto* element = recording.firstElement;
+        do
+        {
+            tile.elements.push_back(*element);
+        } while (!(element++)->IsLastForTile());
+
+        // Elements painted before the surface see the surface and neighbouring elements of the previous tile.
+        const auto& first = *recording.firstElement;
+        if (first.GetType() != TileElementType::Surface || first.IsInvisible() || first.GetBaseZ() == 0)
+            return;
+
+        TileRecorder recorder(session, recording, tile);
+        tile.isRetained = recorder.Record();
+        if (!tile.isRetained)
+        {
+            tile.paintStructs = {};
+            tile.attachedPaintStructs = {};
+            tile.quadrantEntries = {};
+        }
+    }
+
+    void EndTile(PaintSession& session, const TileRecording& recording)
+    {
+        PROFILED_FUNCTION();
+
+        auto* column = recording.column;
+        if (column == nullptr)
+            return;
+
+        const auto key = GetTileKey(session.MapPosition);
+        auto it = column->tiles.find(key);
+        if (it != column->tiles.end())
+            column->size -= GetTileSize(it->second);
+
+        // Animated tiles are painted anew every frame, so there is no point in keeping their elements.
+        if (session.Flags & PaintSessionFlags::IsAnimated)
+        {
+            if (it != column->tiles.end())
+                column->tiles.erase(it);
+            return;
+        }
+
+        auto& tile = it != column->tiles.end() ? it->second : column->tiles[key];
+        tile = RetainedTile{};
+        RecordTile(session, recording, tile);
+        column->size += GetTileSize(tile);
+    }
+} // namespace OpenRCT2::PaintCache
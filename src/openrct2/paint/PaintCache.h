@@ -0,0 +1,70 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2025 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+struct PaintSession;
+struct PaintStruct;
+struct AttachedPaintStruct;
+struct PaintStringStruct;
+struct EntityBase;
+struct SurfaceElement;
+struct TileElement;
+
+/**
+ * Retains the paint structs generated for the tile elements of each tile, per viewport column, so tiles that did not
+ * change since the previous frame are copied into the session instead of running their paint functions again.
+ * A tile is painted anew when its elements differ from the ones it was recorded with, after any game action and
+ * other changes that can affect many tiles, and every frame while it holds animated elements.
+ */
+namespace OpenRCT2::PaintCache
+{
+    struct Column;
+
+    /**
+     * What a tile being painted normally needs to know to retain its paint structs once its elements are done.
+     */
+    struct TileRecording
+    {
+        Column* column{};
+        const TileElement* firstElement{};
+        size_t firstEntry{};
+        PaintStruct* lastPS{};
+        AttachedPaintStruct* lastAttachedPS{};
+        PaintStruct* woodenSupportsPrependTo{};
+        PaintStringStruct* lastPSString{};
+        EntityBase* currentlyDrawnEntity{};
+        const TileElement* currentlyDrawnTileElement{};
+        const SurfaceElement* surface{};
+        const TileElement* pathElementOnSameHeight{};
+        const TileElement* trackElementOnSameHeight{};
+    };
+
+    // Drops everything retained, for changes that can affect the paint of any tile.
+    void InvalidateAll();
+
+    /**
+     * Returns the retained paint for the column painted by the session, or nullptr if tiles have to be painted anew
+     * this frame, such as while a tool highlights parts of the map. Must be released once the column is generated.
+     */
+    Column* AcquireColumn(const PaintSession& session);
+    void ReleaseColumn(Column* column);
+
+    /**
+     * Adds the retained paint structs of the tile starting at firstElement to the session and returns true, or
+     * returns false and sets up recording if the tile elements have to be painted.
+     */
+    bool TryPaintTile(PaintSession& session, const TileElement* firstElement, TileRecording& recording);
+
+    // Retains what was painted for the tile since TryPaintTile returned false.
+    void EndTile(PaintSession& session, const TileRecording& recording);
+} // namespace OpenRCT2::PaintCache
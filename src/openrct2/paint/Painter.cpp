@@ -184,6 +184,7 @@ PaintSession* Painter::CreateSession(RenderTarget& rt, uint32_t viewFlags, uint8
     session->CurrentlyDrawnEntity = nullptr;
     session->CurrentlyDrawnTileElement = nullptr;
     session->Surface = nullptr;
+    session->CacheColumn = nullptr;
     session->SelectedElement = OpenRCT2::TileInspector::GetSelectedElement();
 
     return session;
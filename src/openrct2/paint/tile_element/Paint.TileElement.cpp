@@ -30,6 +30,7 @@
 #include "../../world/tile_element/TileElement.h"
 #include "../Paint.SessionFlags.h"
 #include "../Paint.h"
+#include "../PaintCache.h"
 #include "../VirtualFloor.h"
 #include "Paint.Surface.h"
 #include "Segment.h"
@@ -209,7 +210,13 @@ static void PaintTileElementBase(PaintSession& session, const CoordsXY& origCoor
 
     session.SpritePosition.x = coords.x;
     session.SpritePosition.y = coords.y;
-    session.Flags &= ~PaintSessionFlags::PassedSurface;
+    session.Flags &= ~(PaintSessionFlags::PassedSurface | PaintSessionFlags::IsAnimated);
+
+    PaintCache::TileRecording cacheRecording;
+    if (!partOfVirtualFloor && PaintCache::TryPaintTile(session, tile_element, cacheRecording))
+    {
+        return;
+    }
 
     int32_t previousBaseZ = 0;
     do
@@ -300,6 +307,8 @@ static void PaintTileElementBase(PaintSession& session, const CoordsXY& origCoor
         VirtualFloorPaint(session);
     }
 
+    PaintCache::EndTile(session, cacheRecording);
+
     if (!gShowSupportSegmentHeights)
     {
         return;
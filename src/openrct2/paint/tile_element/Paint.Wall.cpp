@@ -26,6 +26,7 @@
 #include "../../world/Scenery.h"
 #include "../../world/TileInspector.h"
 #include "../../world/tile_element/WallElement.h"
+#include "../Paint.SessionFlags.h"
 #include "Paint.TileElement.h"
 
 using namespace OpenRCT2;
@@ -139,7 +140,12 @@ static void PaintWallWall(
 {
     PROFILED_FUNCTION();
 
-    auto frameNum = (wallEntry.flags2 & WALL_SCENERY_2_ANIMATED) ? (getGameState().currentTicks & 7) * 2 : 0;
+    uint32_t frameNum = 0;
+    if (wallEntry.flags2 & WALL_SCENERY_2_ANIMATED)
+    {
+        session.Flags |= PaintSessionFlags::IsAnimated;
+        frameNum = (getGameState().currentTicks & 7) * 2;
+    }
     auto imageIndex = wallEntry.image + imageOffset + frameNum;
     PaintAddImageAsParent(session, imageTemplate.WithIndex(imageIndex), offset, boundBox);
     if ((wallEntry.flags & WALL_SCENERY_HAS_GLASS) && !isGhost)
@@ -15,6 +15,7 @@
 #include "../../../world/Map.h"
 #include "../../../world/tile_element/TileElement.h"
 #include "../../../world/tile_element/TrackElement.h"
+#include "../../Paint.SessionFlags.h"
 #include "../../Paint.h"
 #include "../../support/MetalSupports.h"
 #include "../../support/WoodenSupports.h"
@@ -87,6 +88,13 @@ const uint32_t chairlift_bullwheel_frames[] = {
     SPR_CHAIRLIFT_BULLWHEEL_FRAME_4,
 };
 
+static ImageId ChairliftPaintUtilGetBullwheelImage(PaintSession& session, const Ride& ride)
+{
+    // The bullwheel turns while the ride runs, so the tile has to be painted every frame.
+    session.Flags |= PaintSessionFlags::IsAnimated;
+    return session.TrackColours.WithIndex(chairlift_bullwheel_frames[ride.chairliftBullwheelRotation / 16384]);
+}
+
 static void ChairliftPaintUtilDrawSupports(PaintSession& session, int32_t segments, uint16_t height, SupportType supportType)
 {
     bool success = false;
@@ -243,7 +251,7 @@ static void ChairliftPaintStationNeSw(
         imageId = session.TrackColours.WithIndex(SPR_FENCE_METAL_SW);
         PaintAddImageAsParent(session, imageId, { 0, 0, height }, { { 30, 2, height + 4 }, { 1, 28, 27 } });
 
-        imageId = session.TrackColours.WithIndex(chairlift_bullwheel_frames[ride.chairliftBullwheelRotation / 16384]);
+        imageId = ChairliftPaintUtilGetBullwheelImage(session, ride);
         PaintAddImageAsParent(session, imageId, { 0, 0, height }, { { 14, 14, height + 4 }, { 4, 4, 19 } });
 
         imageId = session.TrackColours.WithIndex(SPR_CHAIRLIFT_STATION_END_CAP_NE);
@@ -253,7 +261,7 @@ static void ChairliftPaintStationNeSw(
     }
     else if ((direction == 2 && isStart) || (direction == 0 && isEnd))
     {
-        imageId = session.TrackColours.WithIndex(chairlift_bullwheel_frames[ride.chairliftBullwheelRotation / 16384]);
+        imageId = ChairliftPaintUtilGetBullwheelImage(session, ride);
         PaintAddImageAsParent(session, imageId, { 0, 0, height }, { { 14, 14, height + 4 }, { 4, 4, 19 } });
 
         imageId = session.TrackColours.WithIndex(SPR_CHAIRLIFT_STATION_END_CAP_SW);
@@ -333,7 +341,7 @@ static void ChairliftPaintStationSeNw(
     bool drawLeftColumn = true;
     if ((direction == 1 && isStart) || (direction == 3 && isEnd))
     {
-        imageId = session.TrackColours.WithIndex(chairlift_bullwheel_frames[ride.chairliftBullwheelRotation / 16384]);
+        imageId = ChairliftPaintUtilGetBullwheelImage(session, ride);
         PaintAddImageAsParent(session, imageId, { 0, 0, height }, { { 14, 14, height + 4 }, { 4, 4, 19 } });
 
         imageId = session.TrackColours.WithIndex(SPR_CHAIRLIFT_STATION_END_CAP_SE);
@@ -346,7 +354,7 @@ static void ChairliftPaintStationSeNw(
         imageId = session.TrackColours.WithIndex(SPR_FENCE_METAL_SE);
         PaintAddImageAsParent(session, imageId, { 0, 0, height }, { { 2, 30, height + 4 }, { 28, 1, 27 } });
 
-        imageId = session.TrackColours.WithIndex(chairlift_bullwheel_frames[ride.chairliftBullwheelRotation / 16384]);
+        imageId = ChairliftPaintUtilGetBullwheelImage(session, ride);
 
         auto bb = BoundBoxXYZ{ { 14, 14, height + 4 }, { 4, 4, 19 } };
         PaintAddImageAsParent(session, imageId, { 0, 0, height }, bb);
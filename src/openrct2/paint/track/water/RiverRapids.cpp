@@ -15,6 +15,7 @@
 #include "../../../ride/TrackPaint.h"
 #include "../../../ride/Vehicle.h"
 #include "../../../world/Map.h"
+#include "../../Paint.SessionFlags.h"
 #include "../../Paint.h"
 #include "../../support/WoodenSupports.h"
 #include "../../support/WoodenSupports.hpp"
@@ -526,6 +527,7 @@ static void PaintRiverRapidsTrackWaterfall(
 {
     ImageId imageId;
 
+    session.Flags |= PaintSessionFlags::IsAnimated;
     uint16_t frameNum = (getGameState().currentTicks / 2) & 7;
 
     if (direction & 1)
@@ -597,6 +599,7 @@ static void PaintRiverRapidsTrackRapids(
 {
     ImageId imageId;
 
+    session.Flags |= PaintSessionFlags::IsAnimated;
     uint16_t frameNum = (getGameState().currentTicks / 2) & 7;
 
     if (direction & 1)
@@ -649,6 +652,7 @@ static void PaintRiverRapidsTrackWhirlpool(
 {
     ImageId imageId;
 
+    session.Flags |= PaintSessionFlags::IsAnimated;
     uint8_t frameNum = (getGameState().currentTicks / 4) % 16;
 
     if (direction & 1)
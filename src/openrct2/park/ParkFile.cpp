@@ -106,6 +106,7 @@ namespace OpenRCT2
         ObjectList RequiredObjects;
         std::vector<const ObjectRepositoryItem*> ExportObjectsList;
         bool OmitTracklessRides{};
+        bool Compress{ true };
 
     private:
         std::unique_ptr<OrcaStream> _os;
@@ -184,6 +185,10 @@ namespace OpenRCT2
             header.Magic = kParkFileMagic;
             header.TargetVersion = kParkFileCurrentVersion;
             header.MinVersion = kParkFileMinVersion;
+            if (!Compress)
+            {
+                header.Compression = OrcaStream::CompressionType::none;
+            }
 
             ReadWriteAuthoringChunk(os);
             ReadWriteObjectsChunk(os);
@@ -2714,6 +2719,7 @@ void ParkFileExporter::Export(GameState_t& gameState, IStream& stream)
 {
     auto parkFile = std::make_unique<OpenRCT2::ParkFile>();
     parkFile->ExportObjectsList = ExportObjectsList;
+    parkFile->Compress = Compress;
     parkFile->Save(gameState, stream);
 }
 
@@ -59,6 +59,8 @@ class ParkFileExporter
 {
 public:
     std::vector<const ObjectRepositoryItem*> ExportObjectsList;
+    // Leaves the chunk data uncompressed, to be compressed later with OrcaStream::Compress.
+    bool Compress = true;
 
     void Export(OpenRCT2::GameState_t& gameState, std::string_view path);
     void Export(OpenRCT2::GameState_t& gameState, OpenRCT2::IStream& stream);
@@ -11,25 +11,33 @@
 
 #include "../Diagnostic.h"
 #include "../GameState.h"
+#include "../config/Config.h"
 #include "../core/Guard.hpp"
+#include "../core/TaskScheduler.h"
+#include "../entity/EntityList.h"
 #include "../entity/Guest.h"
 #include "../entity/Staff.h"
 #include "../profiling/Profiling.h"
+#include "../ride/Ride.h"
 #include "../ride/RideData.h"
 #include "../ride/Station.h"
 #include "../ride/Track.h"
 #include "../world/Entrance.h"
 #include "../world/Footpath.h"
+#include "../world/FootpathGraph.h"
 #include "../world/tile_element/BannerElement.h"
 #include "../world/tile_element/EntranceElement.h"
 #include "../world/tile_element/PathElement.h"
 #include "../world/tile_element/TileElement.h"
 #include "../world/tile_element/TrackElement.h"
 
+#include <algorithm>
 #include <bit>
 #include <bitset>
 #include <cassert>
 #include <cstring>
+#include <optional>
+#include <vector>
 
 namespace OpenRCT2::PathFinding
 {
@@ -44,6 +52,12 @@ namespace OpenRCT2::PathFinding
     static constexpr uint8_t kMaxJunctions = std::max({ kMaxJunctionsStaff, kMaxJunctionsGuest, kMaxJunctionsGuestWithMap,
                                                         kMaxJunctionsGuestLeavingPark, kMaxJunctionsGuestLeavingParkLost });
 
+    // Guests this close (in world units) to their destination are expected to choose a direction this tick.
+    static constexpr int32_t kSpeculationDistance = 4;
+    // Below this many searches running them ahead on worker threads is not worth the overhead.
+    static constexpr size_t kMinSpeculativeSearches = 32;
+    static constexpr size_t kSpeculativeSearchesPerJob = 16;
+
     struct PathFindingState
     {
         int8_t junctionCount;
@@ -52,6 +66,8 @@ namespace OpenRCT2::PathFinding
         // TODO: Move them, those are query parameters not really state, but for now its easier to pass it down.
         bool ignoreForeignQueues;
         RideId queueRideIndex;
+        // The junctions the peep remembers walking through while heading for the goal.
+        const std::array<TileCoordsXYZD, 4>* peepHistory;
         // A junction history for the peep path finding heuristic search.
         struct
         {
@@ -186,7 +202,7 @@ namespace OpenRCT2::PathFinding
     /**
      * Gets the connected edges of a path that are permitted (i.e. no 'no entry' signs)
      */
-    static int32_t PathGetPermittedEdges(bool ignoreBanners, const PathElement* pathElement)
+    int32_t PathGetPermittedEdges(bool ignoreBanners, const PathElement* pathElement)
     {
         return BannerClearPathEdges(ignoreBanners, pathElement, pathElement->GetEdgesAndCorners()) & 0x0F;
     }
@@ -562,12 +578,12 @@ namespace OpenRCT2::PathFinding
      *
      *  rct2: 0x0069A60A
      */
-    static uint8_t PeepPathfindGetMaxNumberJunctions(Peep& peep)
+    static uint8_t PeepPathfindGetMaxNumberJunctions(const Peep& peep)
     {
         if (peep.Is<Staff>())
             return kMaxJunctionsStaff;
 
-        auto* guest = peep.As<Guest>();
+        const auto* guest = peep.As<Guest>();
         if (guest == nullptr)
             return kMaxJunctionsStaff;
 
@@ -1073,7 +1089,7 @@ namespace OpenRCT2::PathFinding
                     bool pathLoop = false;
                     /* Check the peep.PathfindHistory to see if this junction has
                      * already been visited by the peep while heading for this goal. */
-                    for (auto& pathfindHistory : peep.PathfindHistory)
+                    for (auto& pathfindHistory : *state.peepHistory)
                     {
                         if (pathfindHistory == loc)
                         {
@@ -1223,31 +1239,11 @@ namespace OpenRCT2::PathFinding
     }
 
     /**
-     * Returns:
-     *   -1   - no direction chosen
-     *   0..3 - chosen direction
-     *
-     *  rct2: 0x0069A5F0
+     * Gets the first path element at the location along with the permitted edges of all the path elements there.
+     * Returns nullptr if there is no path at the location.
      */
-    Direction ChooseDirection(
-        const TileCoordsXYZ& loc, const TileCoordsXYZ& goal, Peep& peep, bool ignoreForeignQueues, RideId queueRideIndex)
+    static TileElement* GetPathElementsAt(const TileCoordsXYZ& loc, bool ignoreBanners, uint8_t& permittedEdges, bool& isThin)
     {
-        PROFILED_FUNCTION();
-
-        PathFindingState state{};
-
-        state.ignoreForeignQueues = ignoreForeignQueues;
-        state.queueRideIndex = queueRideIndex;
-
-        // The max number of thin junctions searched - a per-search-path limit.
-        state.maxJunctions = PeepPathfindGetMaxNumberJunctions(peep);
-
-        /* The max number of tiles to check - a whole-search limit.
-         * Mainly to limit the performance impact of the path finding. */
-        int32_t maxTilesChecked = (peep.Is<Staff>()) ? 50000 : 15000;
-
-        LogPathfinding(&peep, "Choose direction for goal %d,%d,%d from %d,%d,%d", goal.x, goal.y, goal.z, loc.x, loc.y, loc.z);
-
         // Get the path element at this location
         TileElement* destTileElement = MapGetFirstElementAt(loc);
         /* Where there are multiple matching map elements placed with zero
@@ -1268,8 +1264,8 @@ namespace OpenRCT2::PathFinding
         TileElement* firstTileElement = nullptr;
 
         bool found = false;
-        uint8_t permittedEdges = 0;
-        bool isThin = false;
+        permittedEdges = 0;
+        isThin = false;
         do
         {
             if (destTileElement == nullptr)
@@ -1293,15 +1289,26 @@ namespace OpenRCT2::PathFinding
             isThin = isThin || PathIsThinJunction(destTileElement->AsPath(), loc);
 
             // Collect the permitted edges of ALL matching path elements at this location.
-            permittedEdges |= PathGetPermittedEdges(peep.Is<Staff>(), destTileElement->AsPath());
+            permittedEdges |= PathGetPermittedEdges(ignoreBanners, destTileElement->AsPath());
         } while (!(destTileElement++)->IsLastForTile());
         // Peep is not on a path.
         if (!found)
-            return kInvalidDirection;
+            return nullptr;
 
         permittedEdges &= 0xF;
+        return firstTileElement;
+    }
+
+    /**
+     * Gets the edges the peep has not yet tried at the location according to its junction history, and resets the
+     * goal and history when heading for a new goal.
+     */
+    static uint32_t GetUntriedEdges(
+        const Peep& peep, TileCoordsXYZD& pathfindGoal, std::array<TileCoordsXYZD, 4>& history, const TileCoordsXYZ& loc,
+        const TileCoordsXYZ& goal, uint8_t permittedEdges, bool isThin)
+    {
         uint32_t edges = permittedEdges;
-        if (isThin && peep.PathfindGoal == goal)
+        if (isThin && pathfindGoal == goal)
         {
             /* Use of peep.PathfindHistory[]:
              * When walking to a goal, the peep PathfindHistory stores
@@ -1318,7 +1325,7 @@ namespace OpenRCT2::PathFinding
             /* If the peep remembers walking through this junction
              * previously while heading for its goal, retrieve the
              * directions it has not yet tried. */
-            for (auto& pathfindHistory : peep.PathfindHistory)
+            for (auto& pathfindHistory : history)
             {
                 if (pathfindHistory == loc)
                 {
@@ -1358,168 +1365,299 @@ namespace OpenRCT2::PathFinding
 
         /* If this is a new goal for the peep. Store it and reset the peep's
          * PathfindHistory. */
-        if (!DirectionValid(peep.PathfindGoal.direction) || peep.PathfindGoal != goal)
+        if (!DirectionValid(pathfindGoal.direction) || pathfindGoal != goal)
         {
-            peep.PathfindGoal = { goal, 0 };
+            pathfindGoal = { goal, 0 };
 
             // Clear pathfinding history
             TileCoordsXYZD nullPos;
             nullPos.SetNull();
 
-            std::fill(std::begin(peep.PathfindHistory), std::end(peep.PathfindHistory), nullPos);
+            std::fill(std::begin(history), std::end(history), nullPos);
 
             LogPathfinding(&peep, "New goal; clearing pf_history.");
         }
 
-        // Peep has tried all edges.
-        if (edges == 0)
-            return kInvalidDirection;
 
-        int32_t chosenEdge = Numerics::bitScanForward(edges);
+        return edges;
+    }
 
-        // Peep has multiple edges still to try.
-        if (edges & ~(1 << chosenEdge))
+    struct SearchQuery
+    {
+        TileCoordsXYZ loc;
+        TileCoordsXYZ goal;
+        uint32_t edges;
+        uint8_t maxJunctions;
+        bool ignoreForeignQueues;
+        RideId queueRideIndex;
+        std::array<TileCoordsXYZD, 4> history;
+    };
+
+    static bool IsSameSearch(const SearchQuery& a, const SearchQuery& b)
+    {
+        if (a.loc != b.loc || a.goal != b.goal || a.edges != b.edges || a.maxJunctions != b.maxJunctions
+            || a.ignoreForeignQueues != b.ignoreForeignQueues || a.queueRideIndex != b.queueRideIndex)
+            return false;
+
+        for (size_t i = 0; i < a.history.size(); i++)
         {
-            uint8_t bestJunctions = 0;
-            TileCoordsXYZ bestJunctionList[16];
-            uint8_t bestDirectionList[16];
-            TileCoordsXYZ bestXYZ;
+            if (a.history[i] != b.history[i] || a.history[i].direction != b.history[i].direction)
+                return false;
+        }
+        return true;
+    }
 
-            uint16_t bestScore = 0xFFFF;
-            uint8_t bestSub = 0xFF;
+    /**
+     * Runs the heuristic search down each of the edges of the query and returns the edge with the best result, or
+     * kInvalidDirection if no search path gets anywhere. Only reads the map and the peep, so searches for different
+     * peeps can run on worker threads while the game state is not being changed.
+     */
+    static Direction SearchBestEdge(const SearchQuery& query, const Peep& peep, TileElement* firstTileElement)
+    {
+        const auto& loc = query.loc;
+        const auto& goal = query.goal;
 
-            LogPathfinding(
-                &peep, "Pathfind start for goal %d,%d,%d from %d,%d,%d", goal.x, goal.y, goal.z, loc.x, loc.y, loc.z);
-
-            /* Call the search heuristic on each edge, keeping track of the
-             * edge that gives the best (i.e. smallest) value (best_score)
-             * or for different edges with equal value, the edge with the
-             * least steps (best_sub). */
-            int32_t numEdges = std::popcount(edges);
-            for (int32_t testEdge = chosenEdge; testEdge != -1; testEdge = Numerics::bitScanForward(edges))
-            {
-                edges &= ~(1 << testEdge);
-                uint8_t height = loc.z;
+        PathFindingState state{};
 
-                if (firstTileElement->AsPath()->IsSloped() && firstTileElement->AsPath()->GetSlopeDirection() == testEdge)
-                {
-                    height += 0x2;
-                }
+        state.ignoreForeignQueues = query.ignoreForeignQueues;
+        state.queueRideIndex = query.queueRideIndex;
+        state.peepHistory = &query.history;
 
-                /* Divide the maxTilesChecked global search limit
-                 * between the remaining edges to ensure the search
-                 * covers all of the remaining edges. */
-                state.countTilesChecked = maxTilesChecked / numEdges;
-                state.junctionCount = state.maxJunctions;
+        // The max number of thin junctions searched - a per-search-path limit.
+        state.maxJunctions = query.maxJunctions;
 
-                // Initialise _peepPathFindHistory.
+        /* The max number of tiles to check - a whole-search limit.
+         * Mainly to limit the performance impact of the path finding. */
+        int32_t maxTilesChecked = (peep.Is<Staff>()) ? 50000 : 15000;
 
-                for (auto& entry : state.history)
-                {
-                    entry.location.SetNull();
-                    entry.direction = kInvalidDirection;
-                }
+        uint32_t edges = query.edges;
+        int32_t chosenEdge = Numerics::bitScanForward(edges);
 
-                /* The pathfinding will only use elements
-                 * 1.._peepPathFindMaxJunctions, so the starting point
-                 * is placed in element 0 */
-                state.history[0].location = loc;
-                state.history[0].direction = 0xF;
-
-                uint16_t score = 0xFFFF;
-                /* Variable endXYZ contains the end location of the
-                 * search path. */
-                TileCoordsXYZ endXYZ;
-                endXYZ.x = 0;
-                endXYZ.y = 0;
-                endXYZ.z = 0;
-
-                uint8_t endSteps = 255;
-
-                /* Variable endJunctions is the number of junctions
-                 * passed through in the search path.
-                 * Variables endJunctionList and endDirectionList
-                 * contain the junctions and corresponding directions
-                 * of the search path.
-                 * In the future these could be used to visualise the
-                 * pathfinding on the map. */
-                uint8_t endJunctions = 0;
-                TileCoordsXYZ endJunctionList[16];
-                uint8_t endDirectionList[16] = { 0 };
-
-                bool inPatrolArea = false;
-                auto* staff = peep.As<Staff>();
-                if (staff != nullptr && staff->IsMechanic())
-                {
-                    /* Mechanics are the only staff type that
-                     * pathfind to a destination. Determine if the
-                     * mechanic is in their patrol area. */
-                    inPatrolArea = staff->IsLocationInPatrol(peep.NextLoc);
-                }
+        uint8_t bestJunctions = 0;
+        TileCoordsXYZ bestJunctionList[16];
+        uint8_t bestDirectionList[16];
+        TileCoordsXYZ bestXYZ;
 
-                LogPathfinding(
-                    &peep, "Pathfind searching in direction: %d from %d,%d,%d", testEdge, loc.x >> 5, loc.y >> 5, loc.z);
+        uint16_t bestScore = 0xFFFF;
+        uint8_t bestSub = 0xFF;
 
-                PeepPathfindHeuristicSearch(
-                    state, { loc.x, loc.y, height }, goal, peep, firstTileElement, inPatrolArea, 0, &score, testEdge,
-                    &endJunctions, endJunctionList, endDirectionList, &endXYZ, &endSteps);
+        LogPathfinding(
+            &peep, "Pathfind start for goal %d,%d,%d from %d,%d,%d", goal.x, goal.y, goal.z, loc.x, loc.y, loc.z);
 
-                if constexpr (kLogPathfinding)
+        /* Call the search heuristic on each edge, keeping track of the
+         * edge that gives the best (i.e. smallest) value (best_score)
+         * or for different edges with equal value, the edge with the
+         * least steps (best_sub). */
+        int32_t numEdges = std::popcount(edges);
+        for (int32_t testEdge = chosenEdge; testEdge != -1; testEdge = Numerics::bitScanForward(edges))
+        {
+            edges &= ~(1 << testEdge);
+            uint8_t height = loc.z;
+
+            if (firstTileElement->AsPath()->IsSloped() && firstTileElement->AsPath()->GetSlopeDirection() == testEdge)
+            {
+                height += 0x2;
+            }
+
+            /* Divide the maxTilesChecked global search limit
+             * between the remaining edges to ensure the search
+             * covers all of the remaining edges. */
+            state.countTilesChecked = maxTilesChecked / numEdges;
+            state.junctionCount = state.maxJunctions;
+
+            // Initialise _peepPathFindHistory.
+
+            for (auto& entry : state.history)
+            {
+                entry.location.SetNull();
+                entry.direction = kInvalidDirection;
+            }
+
+            /* The pathfinding will only use elements
+             * 1.._peepPathFindMaxJunctions, so the starting point
+             * is placed in element 0 */
+            state.history[0].location = loc;
+            state.history[0].direction = 0xF;
+
+            uint16_t score = 0xFFFF;
+            /* Variable endXYZ contains the end location of the
+             * search path. */
+            TileCoordsXYZ endXYZ;
+            endXYZ.x = 0;
+            endXYZ.y = 0;
+            endXYZ.z = 0;
+
+            uint8_t endSteps = 255;
+
+            /* Variable endJunctions is the number of junctions
+             * passed through in the search path.
+             * Variables endJunctionList and endDirectionList
+             * contain the junctions and corresponding directions
+             * of the search path.
+             * In the future these could be used to visualise the
+             * pathfinding on the map. */
+            uint8_t endJunctions = 0;
+            TileCoordsXYZ endJunctionList[16];
+            uint8_t endDirectionList[16] = { 0 };
+
+            bool inPatrolArea = false;
+            auto* staff = peep.As<Staff>();
+            if (staff != nullptr && staff->IsMechanic())
+            {
+                /* Mechanics are the only staff type that
+                 * pathfind to a destination. Determine if the
+                 * mechanic is in their patrol area. */
+                inPatrolArea = staff->IsLocationInPatrol(peep.NextLoc);
+            }
+
+            LogPathfinding(
+                &peep, "Pathfind searching in direction: %d from %d,%d,%d", testEdge, loc.x >> 5, loc.y >> 5, loc.z);
+
+            PeepPathfindHeuristicSearch(
+                state, { loc.x, loc.y, height }, goal, peep, firstTileElement, inPatrolArea, 0, &score, testEdge,
+                &endJunctions, endJunctionList, endDirectionList, &endXYZ, &endSteps);
+
+            if constexpr (kLogPathfinding)
+            {
+                LogPathfinding(
+                    &peep, "Pathfind test edge: %d score: %d steps: %d end: %d,%d,%d junctions: %d", testEdge, score,
+                    endSteps, endXYZ.x, endXYZ.y, endXYZ.z, endJunctions);
+                for (uint8_t listIdx = 0; listIdx < endJunctions; listIdx++)
                 {
                     LogPathfinding(
-                        &peep, "Pathfind test edge: %d score: %d steps: %d end: %d,%d,%d junctions: %d", testEdge, score,
-                        endSteps, endXYZ.x, endXYZ.y, endXYZ.z, endJunctions);
-                    for (uint8_t listIdx = 0; listIdx < endJunctions; listIdx++)
-                    {
-                        LogPathfinding(
-                            &peep, "Junction#%d %d,%d,%d Direction %d", listIdx + 1, endJunctionList[listIdx].x,
-                            endJunctionList[listIdx].y, endJunctionList[listIdx].z, endDirectionList[listIdx]);
-                    }
+                        &peep, "Junction#%d %d,%d,%d Direction %d", listIdx + 1, endJunctionList[listIdx].x,
+                        endJunctionList[listIdx].y, endJunctionList[listIdx].z, endDirectionList[listIdx]);
                 }
+            }
 
-                if (score < bestScore || (score == bestScore && endSteps < bestSub))
-                {
-                    chosenEdge = testEdge;
-                    bestScore = score;
-                    bestSub = endSteps;
+            if (score < bestScore || (score == bestScore && endSteps < bestSub))
+            {
+                chosenEdge = testEdge;
+                bestScore = score;
+                bestSub = endSteps;
 
-                    if constexpr (kLogPathfinding)
+                if constexpr (kLogPathfinding)
+                {
+                    bestJunctions = endJunctions;
+                    for (uint8_t index = 0; index < endJunctions; index++)
                     {
-                        bestJunctions = endJunctions;
-                        for (uint8_t index = 0; index < endJunctions; index++)
-                        {
-                            bestJunctionList[index].x = endJunctionList[index].x;
-                            bestJunctionList[index].y = endJunctionList[index].y;
-                            bestJunctionList[index].z = endJunctionList[index].z;
-                            bestDirectionList[index] = endDirectionList[index];
-                        }
-                        bestXYZ.x = endXYZ.x;
-                        bestXYZ.y = endXYZ.y;
-                        bestXYZ.z = endXYZ.z;
+                        bestJunctionList[index].x = endJunctionList[index].x;
+                        bestJunctionList[index].y = endJunctionList[index].y;
+                        bestJunctionList[index].z = endJunctionList[index].z;
+                        bestDirectionList[index] = endDirectionList[index];
                     }
+                    bestXYZ.x = endXYZ.x;
+                    bestXYZ.y = endXYZ.y;
+                    bestXYZ.z = endXYZ.z;
                 }
             }
+        }
+
+        /* Check if the heuristic search failed. e.g. all connected
+         * paths are within the search limits and none reaches the
+         * goal. */
+        if (bestScore == 0xFFFF)
+        {
+            LogPathfinding(&peep, "Pathfind heuristic search failed.");
+            return kInvalidDirection;
+        }
 
-            /* Check if the heuristic search failed. e.g. all connected
-             * paths are within the search limits and none reaches the
-             * goal. */
-            if (bestScore == 0xFFFF)
+        if constexpr (kLogPathfinding)
+        {
+            LogPathfinding(&peep, "Pathfind best edge %d with score %d steps %d", chosenEdge, bestScore, bestSub);
+            for (uint8_t listIdx = 0; listIdx < bestJunctions; listIdx++)
             {
-                LogPathfinding(&peep, "Pathfind heuristic search failed.");
-                return kInvalidDirection;
+                LogPathfinding(
+                    &peep, "Junction#%d %d,%d,%d Direction %d", listIdx + 1, bestJunctionList[listIdx].x,
+                    bestJunctionList[listIdx].y, bestJunctionList[listIdx].z, bestDirectionList[listIdx]);
             }
+            LogPathfinding(&peep, "End at %d,%d,%d", bestXYZ.x, bestXYZ.y, bestXYZ.z);
+        }
 
-            if constexpr (kLogPathfinding)
+        return chosenEdge;
+    }
+
+    struct SpeculativeSearch
+    {
+        EntityId peepId;
+        SearchQuery query;
+        Direction result;
+    };
+
+    // Searches run ahead of the guest updates on worker threads, sorted by guest id.
+    static std::vector<SpeculativeSearch> _speculativeSearches;
+    static size_t _numSpeculativeSearchesUsed = 0;
+
+    static const SpeculativeSearch* GetSpeculativeSearch(EntityId peepId)
+    {
+        auto it = std::lower_bound(
+            _speculativeSearches.begin(), _speculativeSearches.end(), peepId,
+            [](const SpeculativeSearch& search, EntityId id) { return search.peepId < id; });
+        if (it == _speculativeSearches.end() || it->peepId != peepId)
+            return nullptr;
+        return &*it;
+    }
+
+    /**
+     * Returns:
+     *   -1   - no direction chosen
+     *   0..3 - chosen direction
+     *
+     *  rct2: 0x0069A5F0
+     */
+    Direction ChooseDirection(
+        const TileCoordsXYZ& loc, const TileCoordsXYZ& goal, Peep& peep, bool ignoreForeignQueues, RideId queueRideIndex)
+    {
+        PROFILED_FUNCTION();
+
+        if (peep.Is<Guest>() && getGameState().cheats.guestAStarPathfinding)
+        {
+            // The graph search finds the shortest walk on its own, so the junction history is not needed. Keep the
+            // goal up to date as other code relies on it.
+            if (!DirectionValid(peep.PathfindGoal.direction) || peep.PathfindGoal != goal)
             {
-                LogPathfinding(&peep, "Pathfind best edge %d with score %d steps %d", chosenEdge, bestScore, bestSub);
-                for (uint8_t listIdx = 0; listIdx < bestJunctions; listIdx++)
-                {
-                    LogPathfinding(
-                        &peep, "Junction#%d %d,%d,%d Direction %d", listIdx + 1, bestJunctionList[listIdx].x,
-                        bestJunctionList[listIdx].y, bestJunctionList[listIdx].z, bestDirectionList[listIdx]);
-                }
-                LogPathfinding(&peep, "End at %d,%d,%d", bestXYZ.x, bestXYZ.y, bestXYZ.z);
+                peep.PathfindGoal = { goal, 0 };
+
+                TileCoordsXYZD nullPos;
+                nullPos.SetNull();
+                std::fill(std::begin(peep.PathfindHistory), std::end(peep.PathfindHistory), nullPos);
             }
+            return FootpathGraph::ChooseDirection(loc, goal, ignoreForeignQueues, queueRideIndex);
+        }
+
+        LogPathfinding(&peep, "Choose direction for goal %d,%d,%d from %d,%d,%d", goal.x, goal.y, goal.z, loc.x, loc.y, loc.z);
+
+        uint8_t permittedEdges = 0;
+        bool isThin = false;
+        TileElement* firstTileElement = GetPathElementsAt(loc, peep.Is<Staff>(), permittedEdges, isThin);
+        // Peep is not on a path.
+        if (firstTileElement == nullptr)
+            return kInvalidDirection;
+
+        uint32_t edges = GetUntriedEdges(peep, peep.PathfindGoal, peep.PathfindHistory, loc, goal, permittedEdges, isThin);
+
+        // Peep has tried all edges.
+        if (edges == 0)
+            return kInvalidDirection;
+
+        int32_t chosenEdge = Numerics::bitScanForward(edges);
+
+        // Peep has multiple edges still to try.
+        if (edges & ~(1 << chosenEdge))
+        {
+            const SearchQuery query{
+                loc, goal, edges, PeepPathfindGetMaxNumberJunctions(peep), ignoreForeignQueues, queueRideIndex, peep.PathfindHistory,
+            };
+            const auto* speculativeSearch = GetSpeculativeSearch(peep.Id);
+            const bool useSpeculativeSearch = speculativeSearch != nullptr && IsSameSearch(speculativeSearch->query, query);
+            const auto bestEdge = useSpeculativeSearch ? speculativeSearch->result
+                                                       : SearchBestEdge(query, peep, firstTileElement);
+            if (useSpeculativeSearch)
+                _numSpeculativeSearchesUsed++;
+            if (bestEdge == kInvalidDirection)
+                return kInvalidDirection;
+
+            chosenEdge = bestEdge;
         }
 
         if (isThin)
@@ -1663,32 +1801,38 @@ namespace OpenRCT2::PathFinding
      *
      *  rct2: 0x00695161
      */
-    int32_t GuestPathFindParkEntranceLeaving(Peep& peep, uint8_t edges)
+    /**
+     * Gets the park entrance a peep leaving the park should head for: the one chosen earlier if it still exists,
+     * otherwise the nearest one.
+     */
+    static std::optional<TileCoordsXYZ> GetParkExitGoal(const Peep& peep)
     {
-        TileCoordsXYZ entranceGoal{};
         if (peep.PeepFlags & PEEP_FLAGS_PARK_ENTRANCE_CHOSEN)
         {
-            entranceGoal = peep.PathfindGoal;
-            auto* entranceElement = MapGetParkEntranceElementAt(entranceGoal.ToCoordsXYZ(), false);
-            // If entrance no longer exists, choose a new one
-            if (entranceElement == nullptr)
-            {
-                peep.PeepFlags &= ~(PEEP_FLAGS_PARK_ENTRANCE_CHOSEN);
-            }
+            TileCoordsXYZ entranceGoal = peep.PathfindGoal;
+            if (MapGetParkEntranceElementAt(entranceGoal.ToCoordsXYZ(), false) != nullptr)
+                return entranceGoal;
         }
 
-        if (!(peep.PeepFlags & PEEP_FLAGS_PARK_ENTRANCE_CHOSEN))
-        {
-            auto chosenEntrance = GetNearestParkEntrance(peep.NextLoc);
+        auto chosenEntrance = GetNearestParkEntrance(peep.NextLoc);
+        if (!chosenEntrance.has_value())
+            return std::nullopt;
 
-            if (!chosenEntrance.has_value())
-                return GuestPathfindAimless(peep, edges);
+        return TileCoordsXYZ(*chosenEntrance);
+    }
 
-            peep.PeepFlags |= PEEP_FLAGS_PARK_ENTRANCE_CHOSEN;
-            entranceGoal = TileCoordsXYZ(*chosenEntrance);
+    int32_t GuestPathFindParkEntranceLeaving(Peep& peep, uint8_t edges)
+    {
+        // If the chosen entrance no longer exists, a new one is chosen.
+        auto entranceGoal = GetParkExitGoal(peep);
+        if (!entranceGoal.has_value())
+        {
+            peep.PeepFlags &= ~(PEEP_FLAGS_PARK_ENTRANCE_CHOSEN);
+            return GuestPathfindAimless(peep, edges);
         }
+        peep.PeepFlags |= PEEP_FLAGS_PARK_ENTRANCE_CHOSEN;
 
-        Direction chosenDirection = ChooseDirection(TileCoordsXYZ{ peep.NextLoc }, entranceGoal, peep, true, RideId::GetNull());
+        Direction chosenDirection = ChooseDirection(TileCoordsXYZ{ peep.NextLoc }, *entranceGoal, peep, true, RideId::GetNull());
         if (chosenDirection == kInvalidDirection)
             return GuestPathfindAimless(peep, edges);
 
@@ -1876,6 +2020,74 @@ namespace OpenRCT2::PathFinding
 
         return StationIndex::FromUnderlying(0);
     }
+    /**
+     * Gets the tile a guest heading for the ride should walk to: the end of the queue of the ride's closest
+     * entrance station.
+     */
+    static TileCoordsXYZ GetRideGoal(const Guest& guest, const Ride& ride)
+    {
+        TileCoordsXYZ loc{};
+
+        /* Find the ride's closest entrance station to the guest.
+         * At the same time, count how many entrance stations there are and
+         * which stations are entrance stations. */
+        auto bestScore = std::numeric_limits<int32_t>::max();
+        StationIndex closestStationNum = StationIndex::FromUnderlying(0);
+
+        int32_t numEntranceStations = 0;
+        BitSet<OpenRCT2::Limits::kMaxStationsPerRide> entranceStations = {};
+
+        for (const auto& station : ride.getStations())
+        {
+            // Skip if stationNum has no entrance (so presumably an exit only station)
+            if (station.Entrance.IsNull())
+                continue;
+
+            const auto stationIndex = ride.getStationIndex(&station);
+
+            numEntranceStations++;
+            entranceStations[stationIndex.ToUnderlying()] = true;
+
+            TileCoordsXYZD entranceLocation = station.Entrance;
+            auto score = CalculateHeuristicPathingScore(entranceLocation, TileCoordsXYZ{ guest.NextLoc });
+            if (score < bestScore)
+            {
+                bestScore = score;
+                closestStationNum = stationIndex;
+                continue;
+            }
+        }
+
+        // Ride has no stations with an entrance, so head to station 0.
+        if (numEntranceStations == 0)
+            closestStationNum = StationIndex::FromUnderlying(0);
+
+        if (numEntranceStations > 1 && (ride.departFlags & RIDE_DEPART_SYNCHRONISE_WITH_ADJACENT_STATIONS))
+        {
+            closestStationNum = GuestPathfindingSelectRandomStation(guest, numEntranceStations, entranceStations);
+        }
+
+        if (numEntranceStations == 0)
+        {
+            // closestStationNum is always 0 here.
+            const auto& closestStation = ride.getStation(closestStationNum);
+            auto entranceXY = TileCoordsXY(closestStation.Start);
+            loc.x = entranceXY.x;
+            loc.y = entranceXY.y;
+            loc.z = closestStation.Height;
+        }
+        else
+        {
+            TileCoordsXYZD entranceXYZD = ride.getStation(closestStationNum).Entrance;
+            loc.x = entranceXYZD.x;
+            loc.y = entranceXYZD.y;
+            loc.z = entranceXYZD.z;
+        }
+
+        GetRideQueueEnd(loc);
+        return loc;
+    }
+
     /**
      *
      *  rct2: 0x00694C35
@@ -2047,84 +2259,123 @@ namespace OpenRCT2::PathFinding
             return GuestPathfindAimless(peep, edges);
         }
 
-        /* Find the ride's closest entrance station to the peep.
-         * At the same time, count how many entrance stations there are and
-         * which stations are entrance stations. */
-        auto bestScore = std::numeric_limits<int32_t>::max();
-        StationIndex closestStationNum = StationIndex::FromUnderlying(0);
+        loc = GetRideGoal(peep, *ride);
 
-        int32_t numEntranceStations = 0;
-        BitSet<OpenRCT2::Limits::kMaxStationsPerRide> entranceStations = {};
+        direction = ChooseDirection(TileCoordsXYZ{ peep.NextLoc }, loc, peep, true, rideIndex);
 
-        for (const auto& station : ride->getStations())
+        if (direction == kInvalidDirection)
         {
-            // Skip if stationNum has no entrance (so presumably an exit only station)
-            if (station.Entrance.IsNull())
-                continue;
-
-            const auto stationIndex = ride->getStationIndex(&station);
+            /* Heuristic search failed for all directions.
+             * Reset the PathfindGoal - this means that the PathfindHistory
+             * will be reset in the next call to ChooseDirection().
+             * This lets the heuristic search "try again" in case the player has
+             * edited the path layout or the mechanic was already stuck in the
+             * save game (e.g. with a worse version of the pathfinding). */
+            peep.ResetPathfindGoal();
 
-            numEntranceStations++;
-            entranceStations[stationIndex.ToUnderlying()] = true;
+            LogPathfinding(&peep, "Completed CalculateNextDestination - failed to choose a direction == aimless.");
 
-            TileCoordsXYZD entranceLocation = station.Entrance;
-            auto score = CalculateHeuristicPathingScore(entranceLocation, TileCoordsXYZ{ peep.NextLoc });
-            if (score < bestScore)
-            {
-                bestScore = score;
-                closestStationNum = stationIndex;
-                continue;
-            }
+            return GuestPathfindAimless(peep, edges);
         }
 
-        // Ride has no stations with an entrance, so head to station 0.
-        if (numEntranceStations == 0)
-            closestStationNum = StationIndex::FromUnderlying(0);
+        LogPathfinding(&peep, "Completed CalculateNextDestination - direction chosen: %d.", direction);
 
-        if (numEntranceStations > 1 && (ride->departFlags & RIDE_DEPART_SYNCHRONISE_WITH_ADJACENT_STATIONS))
-        {
-            closestStationNum = GuestPathfindingSelectRandomStation(peep, numEntranceStations, entranceStations);
-        }
+        return PeepMoveOneTile(direction, peep);
+    }
 
-        if (numEntranceStations == 0)
+    /**
+     * Predicts the search the guest will run when it reaches its destination this tick, from the same inputs
+     * CalculateNextDestination and ChooseDirection use. Returns false if the guest will not need a search.
+     */
+    static bool SpeculateGuestSearch(const Guest& guest, SpeculativeSearch& search)
+    {
+        std::optional<TileCoordsXYZ> goal;
+        RideId queueRideIndex = RideId::GetNull();
+        if (guest.PeepFlags & PEEP_FLAGS_LEAVING_PARK)
         {
-            // closestStationNum is always 0 here.
-            const auto& closestStation = ride->getStation(closestStationNum);
-            auto entranceXY = TileCoordsXY(closestStation.Start);
-            loc.x = entranceXY.x;
-            loc.y = entranceXY.y;
-            loc.z = closestStation.Height;
+            goal = GetParkExitGoal(guest);
         }
         else
         {
-            TileCoordsXYZD entranceXYZD = ride->getStation(closestStationNum).Entrance;
-            loc.x = entranceXYZD.x;
-            loc.y = entranceXYZD.y;
-            loc.z = entranceXYZD.z;
+            auto ride = GetRide(guest.GuestHeadingToRideId);
+            if (ride == nullptr || ride->status != RideStatus::open)
+                return false;
+
+            goal = GetRideGoal(guest, *ride);
+            queueRideIndex = guest.GuestHeadingToRideId;
         }
+        if (!goal.has_value())
+            return false;
 
-        GetRideQueueEnd(loc);
+        const TileCoordsXYZ loc{ guest.NextLoc };
+        uint8_t permittedEdges = 0;
+        bool isThin = false;
+        TileElement* firstTileElement = GetPathElementsAt(loc, false, permittedEdges, isThin);
+        if (firstTileElement == nullptr)
+            return false;
 
-        direction = ChooseDirection(TileCoordsXYZ{ peep.NextLoc }, loc, peep, true, rideIndex);
+        // Work on copies, the guest applies the same changes itself when it gets to choose.
+        auto pathfindGoal = guest.PathfindGoal;
+        auto history = guest.PathfindHistory;
+        const auto edges = GetUntriedEdges(guest, pathfindGoal, history, loc, *goal, permittedEdges, isThin);
+        if (std::popcount(edges) < 2)
+            return false;
 
-        if (direction == kInvalidDirection)
+        search.query = { loc, *goal, edges, PeepPathfindGetMaxNumberJunctions(guest), true, queueRideIndex, history };
+        search.result = SearchBestEdge(search.query, guest, firstTileElement);
+        return true;
+    }
+
+    void SpeculateGuestSearches()
+    {
+        PROFILED_FUNCTION();
+
+        ClearGuestSearches();
+
+        if (!Config::Get().general.MultiThreading || getGameState().cheats.guestAStarPathfinding)
+            return;
+
+        // Only guests about to reach their destination heading for a ride or the park exit will search.
+        std::vector<const Guest*> guests;
+        for (const auto* guest : EntityList<Guest>())
         {
-            /* Heuristic search failed for all directions.
-             * Reset the PathfindGoal - this means that the PathfindHistory
-             * will be reset in the next call to ChooseDirection().
-             * This lets the heuristic search "try again" in case the player has
-             * edited the path layout or the mechanic was already stuck in the
-             * save game (e.g. with a worse version of the pathfinding). */
-            peep.ResetPathfindGoal();
+            if (guest->State != PeepState::Walking || guest->OutsideOfPark || !guest->IsActionWalking()
+                || guest->GetNextIsSurface())
+                continue;
+            if (!(guest->PeepFlags & PEEP_FLAGS_LEAVING_PARK) && guest->GuestHeadingToRideId.IsNull())
+                continue;
 
-            LogPathfinding(&peep, "Completed CalculateNextDestination - failed to choose a direction == aimless.");
+            const auto distance = std::abs(guest->x - guest->GetDestination().x)
+                + std::abs(guest->y - guest->GetDestination().y);
+            if (distance > guest->DestinationTolerance + kSpeculationDistance)
+                continue;
 
-            return GuestPathfindAimless(peep, edges);
+            guests.push_back(guest);
         }
+        if (guests.size() < kMinSpeculativeSearches)
+            return;
 
-        LogPathfinding(&peep, "Completed CalculateNextDestination - direction chosen: %d.", direction);
+        // Guests are updated in order of their id, so the list is already sorted.
+        _speculativeSearches.resize(guests.size());
+        TaskScheduler::Get().ParallelFor(0, guests.size(), kSpeculativeSearchesPerJob, [&guests](size_t i) {
+            auto& search = _speculativeSearches[i];
+            search.peepId = SpeculateGuestSearch(*guests[i], search) ? guests[i]->Id : EntityId::GetNull();
+        });
+
+        auto it = std::remove_if(_speculativeSearches.begin(), _speculativeSearches.end(), [](const SpeculativeSearch& search) {
+            return search.peepId.IsNull();
+        });
+        _speculativeSearches.erase(it, _speculativeSearches.end());
+    }
 
-        return PeepMoveOneTile(direction, peep);
+    void ClearGuestSearches()
+    {
+        _speculativeSearches.clear();
+    }
+
+    size_t GetNumSpeculativeSearchesUsed()
+    {
+        return _numSpeculativeSearchesUsed;
     }
 
 } // namespace OpenRCT2::PathFinding
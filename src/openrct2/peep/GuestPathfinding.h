@@ -17,6 +17,7 @@
 struct Peep;
 struct Guest;
 struct TileElement;
+struct PathElement;
 
 namespace OpenRCT2::PathFinding
 {
@@ -25,6 +26,22 @@ namespace OpenRCT2::PathFinding
 
     int32_t CalculateNextDestination(Guest& peep);
 
+    /**
+     * Runs the path searches of the guests about to choose a direction on worker threads. ChooseDirection uses a
+     * result only when the search it would run has exactly the same inputs, so the outcome is unchanged.
+     * Must be cleared with ClearGuestSearches before anything other than guests is updated.
+     */
+    void SpeculateGuestSearches();
+    void ClearGuestSearches();
+
+    // Number of searches ChooseDirection took from SpeculateGuestSearches since startup.
+    size_t GetNumSpeculativeSearchesUsed();
+
+    /**
+     * Gets the connected edges of a path that are permitted (i.e. no 'no entry' signs)
+     */
+    int32_t PathGetPermittedEdges(bool ignoreBanners, const PathElement* pathElement);
+
     int32_t GuestPathFindParkEntranceEntering(Peep& peep, uint8_t edges);
 
     int32_t GuestPathFindPeepSpawn(Peep& peep, uint8_t edges);
@@ -13,6 +13,8 @@
 #include <chrono>
 #include <fstream>
 #include <iomanip>
+#include <memory>
+#include <set>
 #include <stack>
 
 namespace OpenRCT2::Profiling
@@ -53,7 +55,146 @@ namespace OpenRCT2::Profiling
             }
         };
 
-        static thread_local std::stack<FunctionEntry> _callStack;
+        struct TraceEvent
+        {
+            const FunctionInternal* Func;
+            int64_t StartNs;
+            int64_t DurationNs;
+        };
+
+        // A slot of the ring buffer. The fields are atomics so the exporter may read a slot while the owning thread
+        // overwrites it, relaxed accesses compile to plain loads and stores.
+        struct TraceEventSlot
+        {
+            std::atomic<const FunctionInternal*> Func{};
+            std::atomic<int64_t> StartNs{};
+            std::atomic<int64_t> DurationNs{};
+        };
+
+        // Single producer ring buffer, only the owning thread writes events and publishes them
+        // by advancing WriteIndex. Buffers are recycled once their thread exits.
+        struct TraceBuffer
+        {
+            std::vector<TraceEventSlot> Events = std::vector<TraceEventSlot>(MaxTraceEventsPerThread);
+            std::atomic<uint64_t> WriteIndex{};
+            std::atomic<bool> InUse{};
+            size_t ThreadIndex{};
+        };
+
+        static const Tp _epoch = Clock::now();
+        static std::atomic<int64_t> _traceStartNs{};
+
+        // Bumped on reset so that threads forget which call edges they already recorded.
+        static std::atomic<uint32_t> _edgeGeneration{};
+
+        static std::mutex _traceBuffersMutex;
+        static std::vector<std::unique_ptr<TraceBuffer>> _traceBuffers;
+        static size_t _nextTraceThreadIndex{};
+
+        static TraceBuffer* AcquireTraceBuffer()
+        {
+            std::scoped_lock lock(_traceBuffersMutex);
+            TraceBuffer* buffer = nullptr;
+            for (auto& candidate : _traceBuffers)
+            {
+                if (!candidate->InUse)
+                {
+                    buffer = candidate.get();
+                    break;
+                }
+            }
+            if (buffer == nullptr)
+                buffer = _traceBuffers.emplace_back(std::make_unique<TraceBuffer>()).get();
+
+            // A recycled buffer still holds the events of the thread that exited, which must not show up as this one.
+            // The exporter only reads up to the write index and holds the lock, so resetting the index clears it.
+            buffer->WriteIndex.store(0, std::memory_order_relaxed);
+            buffer->ThreadIndex = _nextTraceThreadIndex++;
+            buffer->InUse = true;
+            return buffer;
+        }
+
+        struct ThreadState
+        {
+            std::stack<FunctionEntry> CallStack;
+            std::set<std::pair<const FunctionInternal*, const FunctionInternal*>> KnownEdges;
+            uint32_t EdgeGeneration{};
+            TraceBuffer* Trace{};
+
+            ~ThreadState()
+            {
+                if (Trace != nullptr)
+                    Trace->InUse = false;
+            }
+        };
+
+        static thread_local ThreadState _threadState;
+
+        static int64_t GetTimestampNs(const Tp& tp)
+        {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(tp - _epoch).count();
+        }
+
+        static void AtomicMin(std::atomic<double>& value, double sample)
+        {
+            // Zero means no sample has been recorded yet.
+            auto current = value.load(std::memory_order_relaxed);
+            while ((current == 0.0 || sample < current) && !value.compare_exchange_weak(current, sample))
+            {
+            }
+        }
+
+        static void AtomicMax(std::atomic<double>& value, double sample)
+        {
+            auto current = value.load(std::memory_order_relaxed);
+            while (sample > current && !value.compare_exchange_weak(current, sample))
+            {
+            }
+        }
+
+        static void RecordEdge(ThreadState& state, FunctionInternal* parent, FunctionInternal* func)
+        {
+            const auto generation = _edgeGeneration.load(std::memory_order_relaxed);
+            if (state.EdgeGeneration != generation)
+            {
+                state.KnownEdges.clear();
+                state.EdgeGeneration = generation;
+            }
+
+            // Only the first call per thread takes the locks, after that the edge is known. Look it up before inserting,
+            // inserting into the set allocates even when the edge is already there.
+            const std::pair<const FunctionInternal*, const FunctionInternal*> edge{ parent, func };
+            if (state.KnownEdges.find(edge) != state.KnownEdges.end())
+                return;
+            state.KnownEdges.insert(edge);
+
+            {
+                std::scoped_lock lock(parent->Mutex);
+                parent->Children.insert(func);
+            }
+            {
+                std::scoped_lock lock(func->Mutex);
+                func->Parents.insert(parent);
+            }
+        }
+
+        static void RecordTraceEvent(ThreadState& state, const FunctionInternal* func, const Tp& entryTime, const Tp& exitTime)
+        {
+            if (state.Trace == nullptr)
+                state.Trace = AcquireTraceBuffer();
+
+            auto& buffer = *state.Trace;
+            const auto index = buffer.WriteIndex.load(std::memory_order_relaxed);
+            auto& slot = buffer.Events[index % buffer.Events.size()];
+            // Pairs with the fence in the exporter: one that sees any of the new fields also sees the previous index,
+            // and knows this slot is being overwritten.
+            std::atomic_thread_fence(std::memory_order_release);
+            slot.Func.store(func, std::memory_order_relaxed);
+            slot.StartNs.store(GetTimestampNs(entryTime), std::memory_order_relaxed);
+            slot.DurationNs.store(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(exitTime - entryTime).count(), std::memory_order_relaxed);
+            buffer.WriteIndex.store(index + 1, std::memory_order_release);
+        }
 
         void FunctionEnter(Function& func)
         {
@@ -62,21 +203,24 @@ namespace OpenRCT2::Profiling
             auto& funcInternal = static_cast<FunctionInternal&>(func);
             funcInternal.CallCount++;
 
+            auto& callStack = _threadState.CallStack;
+
             FunctionInternal* parent = nullptr;
 
-            if (!_callStack.empty())
-                parent = _callStack.top().Func;
+            if (!callStack.empty())
+                parent = callStack.top().Func;
 
-            _callStack.emplace(parent, &funcInternal, entryTime);
+            callStack.emplace(parent, &funcInternal, entryTime);
         }
 
         void FunctionExit(Function& func)
         {
             const auto exitTime = Clock::now();
 
-            assert(!_callStack.empty());
+            auto& state = _threadState;
+            assert(!state.CallStack.empty());
 
-            auto& stackEntry = _callStack.top();
+            auto& stackEntry = state.CallStack.top();
 
             const auto deltaTime = exitTime - stackEntry.EntryTime;
 
@@ -90,28 +234,15 @@ namespace OpenRCT2::Profiling
             funcData->Samples[sampleEntryIdx] = elapsedTimeUs;
 
             if (stackEntry.Parent)
-            {
-                std::scoped_lock lock(stackEntry.Parent->Mutex);
-                stackEntry.Parent->Children.insert(funcData);
-            }
+                RecordEdge(state, stackEntry.Parent, funcData);
 
-            // This requires locking.
-            {
-                std::scoped_lock lock(funcData->Mutex);
+            AtomicMin(funcData->MinTimeUs, elapsedTimeUs);
+            AtomicMax(funcData->MaxTimeUs, elapsedTimeUs);
+            funcData->TotalTimeUs.fetch_add(elapsedTimeUs, std::memory_order_relaxed);
 
-                if (stackEntry.Parent)
-                    funcData->Parents.insert(stackEntry.Parent);
-
-                if (funcData->MinTimeUs == 0.0)
-                    funcData->MinTimeUs = elapsedTimeUs;
-                else
-                    funcData->MinTimeUs = std::min(elapsedTimeUs, funcData->MinTimeUs);
-
-                funcData->MaxTimeUs = std::max(elapsedTimeUs, funcData->MaxTimeUs);
-                funcData->TotalTimeUs += elapsedTimeUs;
-            }
+            RecordTraceEvent(state, funcData, stackEntry.EntryTime, exitTime);
 
-            _callStack.pop();
+            state.CallStack.pop();
         }
 
         std::vector<Function*>& GetRegistry()
@@ -120,13 +251,30 @@ namespace OpenRCT2::Profiling
             return Registry;
         }
 
+        static std::vector<Counter*>& GetCounterRegistry()
+        {
+            static std::vector<Counter*> Registry;
+            return Registry;
+        }
+
     } // namespace Detail
 
+    Counter::Counter(const char* name)
+        : _name(name)
+    {
+        Detail::GetCounterRegistry().push_back(this);
+    }
+
     const std::vector<Function*>& GetData()
     {
         return Detail::GetRegistry();
     }
 
+    const std::vector<Counter*>& GetCounters()
+    {
+        return Detail::GetCounterRegistry();
+    }
+
     void ResetData()
     {
         for (auto* func : Detail::GetRegistry())
@@ -137,10 +285,19 @@ namespace OpenRCT2::Profiling
             funcInternal->CallCount = 0;
             funcInternal->MinTimeUs = 0.0;
             funcInternal->MaxTimeUs = 0.0;
+            funcInternal->TotalTimeUs = 0.0;
             funcInternal->SampleIterator = 0;
             funcInternal->Children.clear();
             funcInternal->Parents.clear();
         }
+
+        for (auto* counter : Detail::GetCounterRegistry())
+        {
+            counter->Reset();
+        }
+
+        Detail::_edgeGeneration++;
+        Detail::_traceStartNs = Detail::GetTimestampNs(Detail::Clock::now());
     }
 
     bool ExportCSV(const std::string& filePath)
@@ -171,4 +328,91 @@ namespace OpenRCT2::Profiling
         return true;
     }
 
+    static void WriteJsonString(std::ostream& out, const char* str)
+    {
+        out << '"';
+        for (; *str != '\0'; str++)
+        {
+            if (*str == '"' || *str == '\\')
+                out << '\\';
+            out << *str;
+        }
+        out << '"';
+    }
+
+    bool ExportChromeTrace(const std::string& filePath)
+    {
+        std::ofstream out(filePath);
+        if (!out.is_open())
+            return false;
+
+        out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+        out << std::fixed << std::setprecision(3);
+
+        const auto traceStartNs = Detail::_traceStartNs.load();
+        bool first = true;
+
+        std::scoped_lock lock(Detail::_traceBuffersMutex);
+        for (const auto& buffer : Detail::_traceBuffers)
+        {
+            if (!first)
+                out << ",";
+            first = false;
+            out << "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << buffer->ThreadIndex
+                << ",\"args\":{\"name\":\"Thread " << buffer->ThreadIndex << "\"}}";
+
+            // Events past the capacity have been overwritten, only the most recent window is available.
+            const auto end = buffer->WriteIndex.load(std::memory_order_acquire);
+            const auto capacity = buffer->Events.size();
+            const auto begin = end > capacity ? end - capacity : 0;
+
+            // The owning thread keeps writing while the window is copied. Copy first, then drop the events whose
+            // slots it may have reused meanwhile, the slot of the event it is writing now included.
+            std::vector<Detail::TraceEvent> events;
+            events.reserve(end - begin);
+            for (auto i = begin; i < end; i++)
+            {
+                const auto& slot = buffer->Events[i % capacity];
+                events.push_back({
+                    slot.Func.load(std::memory_order_relaxed),
+                    slot.StartNs.load(std::memory_order_relaxed),
+                    slot.DurationNs.load(std::memory_order_relaxed),
+                });
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            const auto written = buffer->WriteIndex.load(std::memory_order_relaxed);
+            const auto firstIntact = written >= capacity ? written - capacity + 1 : 0;
+
+            for (auto i = begin; i < end; i++)
+            {
+                if (i < firstIntact)
+                    continue;
+
+                const auto& ev = events[i - begin];
+                if (ev.Func == nullptr || ev.StartNs < traceStartNs)
+                    continue;
+
+                out << ",\n{\"name\":";
+                WriteJsonString(out, ev.Func->GetName());
+                out << ",\"ph\":\"X\",\"pid\":0,\"tid\":" << buffer->ThreadIndex;
+                out << ",\"ts\":" << ev.StartNs / 1000.0 << ",\"dur\":" << ev.DurationNs / 1000.0 << "}";
+            }
+        }
+
+        // Counters are written as their totals at the end of the trace.
+        const auto endUs = Detail::GetTimestampNs(Detail::Clock::now()) / 1000.0;
+        for (const auto* counter : GetCounters())
+        {
+            if (!first)
+                out << ",";
+            first = false;
+            out << "\n{\"name\":";
+            WriteJsonString(out, counter->GetName());
+            out << ",\"ph\":\"C\",\"pid\":0,\"ts\":" << endUs << ",\"args\":{\"value\":" << counter->GetValue() << "}}";
+        }
+
+        out << "\n]}\n";
+        return true;
+    }
+
 } // namespace OpenRCT2::Profiling
@@ -53,10 +53,50 @@ namespace OpenRCT2::Profiling
         virtual std::vector<Function*> GetChildren() const = 0;
     };
 
+    /**
+     * A named count of events that are not function calls, such as cache hits. Like the function timings, it only
+     * counts while the profiler is enabled.
+     */
+    class Counter
+    {
+        const char* _name;
+        std::atomic<uint64_t> _value{};
+
+    public:
+        explicit Counter(const char* name);
+
+        const char* GetName() const noexcept
+        {
+            return _name;
+        }
+
+        uint64_t GetValue() const noexcept
+        {
+            return _value.load(std::memory_order_relaxed);
+        }
+
+        void Increment() noexcept
+        {
+            Add(1);
+        }
+
+        void Add(uint64_t amount) noexcept
+        {
+            if (IsEnabled())
+                _value.fetch_add(amount, std::memory_order_relaxed);
+        }
+
+        void Reset() noexcept
+        {
+            _value = 0;
+        }
+    };
+
     namespace Detail
     {
         static constexpr auto MaxSamplesSize = 1024;
         static constexpr auto MaxNameSize = 250;
+        static constexpr auto MaxTraceEventsPerThread = 65536;
 
         std::vector<Function*>& GetRegistry();
 
@@ -69,7 +109,7 @@ namespace OpenRCT2::Profiling
 
             virtual ~FunctionInternal() = default;
 
-            // Functions marked MT require locking, this is per function basis.
+            // Guards Parents and Children, timings are updated without locking.
             mutable std::mutex Mutex;
 
             std::array<char, MaxNameSize> Name{};
@@ -83,11 +123,11 @@ namespace OpenRCT2::Profiling
             // Used internally to write into Samples without a lock.
             std::atomic<size_t> SampleIterator{};
 
-            double MinTimeUs{};
+            std::atomic<double> MinTimeUs{};
 
-            double MaxTimeUs{};
+            std::atomic<double> MaxTimeUs{};
 
-            double TotalTimeUs{};
+            std::atomic<double> TotalTimeUs{};
 
             // Functions that called us.
             std::unordered_set<Function*> Parents;
@@ -120,20 +160,17 @@ namespace OpenRCT2::Profiling
 
             double getTotalTime() const override
             {
-                std::scoped_lock lock(Mutex);
-                return TotalTimeUs;
+                return TotalTimeUs.load();
             }
 
             double GetMinTime() const override
             {
-                std::scoped_lock lock(Mutex);
-                return MinTimeUs;
+                return MinTimeUs.load();
             }
 
             double GetMaxTime() const override
             {
-                std::scoped_lock lock(Mutex);
-                return MaxTimeUs;
+                return MaxTimeUs.load();
             }
         };
 
@@ -185,12 +222,18 @@ namespace OpenRCT2::Profiling
         }
     };
 
-    // Clears all the current data of each function.
+    // Clears all the current data of each function and counter.
     void ResetData();
 
     // Returns all functions.
     const std::vector<Function*>& GetData();
 
+    // Returns all counters.
+    const std::vector<Counter*>& GetCounters();
+
     bool ExportCSV(const std::string& filePath);
 
+    // Writes the most recent calls of every thread as a Chrome trace / Perfetto JSON timeline.
+    bool ExportChromeTrace(const std::string& filePath);
+
 } // namespace OpenRCT2::Profiling
@@ -1764,6 +1764,7 @@ void TrackPaintUtilLeftQuarterTurn1TilePaint(
 
 void TrackPaintUtilSpinningTunnelPaint(PaintSession& session, int8_t thickness, int16_t height, Direction direction)
 {
+    session.Flags |= PaintSessionFlags::IsAnimated;
     int32_t frame = (getGameState().currentTicks >> 2) & 3;
     auto colourFlags = session.SupportColours;
 
@@ -2039,6 +2040,12 @@ void PaintTrack(PaintSession& session, Direction direction, int32_t height, cons
         }
 
         const auto& rtd = GetRideTypeDescriptor(trackElement.GetRideType());
+        // Flat rides are drawn from their vehicles.
+        if (rtd.HasFlag(RtdFlag::isFlatRide) && !rtd.HasFlag(RtdFlag::isShopOrFacility))
+        {
+            session.Flags |= PaintSessionFlags::IsAnimated;
+        }
+
         bool isInverted = trackElement.IsInverted() && rtd.HasFlag(RtdFlag::hasInvertedVariant);
         const auto trackDrawerEntry = getTrackDrawerEntry(rtd, isInverted, TrackElementIsCovered(trackType));
 
@@ -19,9 +19,10 @@ namespace OpenRCT2::TrainManager
     {
         Entity = nullptr;
 
-        while (iter != end && Entity == nullptr)
+        EntityId id;
+        while (Entity == nullptr && cursor.TryNext(id))
         {
-            Entity = GetEntity<Vehicle>(*iter++);
+            Entity = GetEntity<Vehicle>(id);
             if (Entity != nullptr && !Entity->IsHead())
             {
                 Entity = nullptr;
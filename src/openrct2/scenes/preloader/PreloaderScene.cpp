@@ -15,6 +15,7 @@
 #include "../../GameState.h"
 #include "../../OpenRCT2.h"
 #include "../../audio/Audio.h"
+#include "../../core/Guard.hpp"
 #include "../../interface/Viewport.h"
 #include "../../localisation/StringIds.h"
 #include "../../ui/WindowManager.h"
@@ -26,7 +27,6 @@ using namespace OpenRCT2;
 
 PreloaderScene::PreloaderScene(IContext& context)
     : Scene(context)
-    , _jobs(1)
 {
 }
 
@@ -44,6 +44,15 @@ void PreloaderScene::Load()
     LOG_VERBOSE("PreloaderScene::Load() finished");
 }
 
+void PreloaderScene::AddJob(const std::function<void()>& fn)
+{
+    Guard::Assert(!_started, "PreloaderScene::AddJob called after the jobs started running");
+    if (_started)
+        return;
+
+    _jobs.push_back(fn);
+}
+
 void PreloaderScene::Tick()
 {
     gInUpdateCode = true;
@@ -55,10 +64,22 @@ void PreloaderScene::Tick()
 
     gInUpdateCode = false;
 
-    if (!_jobs.IsBusy())
+    if (!_started)
+    {
+        _started = true;
+        _tasks.Run(
+            [this]() {
+                for (const auto& job : _jobs)
+                {
+                    job();
+                }
+            });
+    }
+
+    if (!_tasks.IsBusy())
     {
         // Make sure the job is fully completed.
-        _jobs.Join();
+        _tasks.Wait();
 
         FinishScene();
     }
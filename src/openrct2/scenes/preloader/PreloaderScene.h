@@ -9,10 +9,13 @@
 
 #pragma once
 
-#include "../../core/JobPool.h"
+#include "../../core/TaskScheduler.h"
 #include "../../drawing/Drawing.h"
 #include "../Scene.h"
 
+#include <functional>
+#include <vector>
+
 namespace OpenRCT2
 {
     class PreloaderScene final : public Scene
@@ -23,12 +26,13 @@ namespace OpenRCT2
         void Load() override;
         void Tick() override;
         void Stop() override;
-        void AddJob(const std::function<void()>& fn)
-        {
-            _jobs.AddTask(fn);
-        }
+        // Jobs can only be added before the first tick, which starts running them.
+        void AddJob(const std::function<void()>& fn);
 
     private:
-        JobPool _jobs;
+        // Jobs run one after another in a single background task, later jobs depend on the earlier ones.
+        std::vector<std::function<void()>> _jobs;
+        TaskGroup _tasks;
+        bool _started = false;
     };
 } // namespace OpenRCT2
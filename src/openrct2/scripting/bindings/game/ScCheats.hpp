@@ -62,6 +62,8 @@ namespace OpenRCT2::Scripting
                 "enableChainLiftOnAllTrack");
             dukglue_register_property(ctx, &ScCheats::fastLiftHill_get, &ScCheats::fastLiftHill_set, "fastLiftHill");
             dukglue_register_property(ctx, &ScCheats::freezeWeather_get, &ScCheats::freezeWeather_set, "freezeWeather");
+            dukglue_register_property(
+                ctx, &ScCheats::guestAStarPathfinding_get, &ScCheats::guestAStarPathfinding_set, "guestAStarPathfinding");
             dukglue_register_property(
                 ctx, &ScCheats::ignoreResearchStatus_get, &ScCheats::ignoreResearchStatus_set, "ignoreResearchStatus");
             dukglue_register_property(
@@ -275,6 +277,17 @@ namespace OpenRCT2::Scripting
             getGameState().cheats.freezeWeather = value;
         }
 
+        bool guestAStarPathfinding_get()
+        {
+            return getGameState().cheats.guestAStarPathfinding;
+        }
+
+        void guestAStarPathfinding_set(bool value)
+        {
+            ThrowIfGameStateNotMutable();
+            getGameState().cheats.guestAStarPathfinding = value;
+        }
+
         bool ignoreResearchStatus_get()
         {
             return getGameState().cheats.ignoreResearchStatus;
@@ -164,6 +164,7 @@ namespace OpenRCT2::Scripting
             }
             obj.Set("bytesSent", DukValue::take_from_stack(_context));
         }
+        obj.Set("bytesQueued", networkStats.bytesQueued);
         return obj.Take();
     #else
         return ToDuk(_context, nullptr);
@@ -16,11 +16,15 @@
     #include "../../../entity/EntityRegistry.h"
     #include "../../../object/LargeSceneryEntry.h"
     #include "../../../object/WallSceneryEntry.h"
+    #include "../../../paint/PaintCache.h"
     #include "../../../ride/Ride.h"
     #include "../../../ride/RideData.h"
     #include "../../../ride/Track.h"
     #include "../../../world/Footpath.h"
+    #include "../../../world/FootpathGraph.h"
+    #include "../../../world/RideProximityIndex.h"
     #include "../../../world/Scenery.h"
+    #include "../../../world/SurroundingsIndex.h"
     #include "../../../world/tile_element/BannerElement.h"
     #include "../../../world/tile_element/EntranceElement.h"
     #include "../../../world/tile_element/LargeSceneryElement.h"
@@ -2143,6 +2147,10 @@ namespace OpenRCT2::Scripting
     void ScTileElement::Invalidate()
     {
         MapInvalidateTileFull(_coords);
+        RideProximityIndex::InvalidateTile(TileCoordsXY(_coords));
+        SurroundingsIndex::InvalidateTile(TileCoordsXY(_coords));
+        FootpathGraph::InvalidateTile(TileCoordsXY(_coords));
+        PaintCache::InvalidateAll();
     }
 
     const LargeSceneryElement* ScTileElement::GetOtherLargeSceneryElement(
@@ -33,6 +33,7 @@
 #include "../ride/RideData.h"
 #include "../ride/Track.h"
 #include "../ride/TrackData.h"
+#include "FootpathGraph.h"
 #include "Location.hpp"
 #include "MapAnimation.h"
 #include "tile_element/BannerElement.h"
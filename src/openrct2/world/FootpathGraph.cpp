@@ -0,0 +1,901 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2025 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "FootpathGraph.h"
+
+#include "../GameState.h"
+#include "../core/Numerics.hpp"
+#include "../peep/GuestPathfinding.h"
+#include "../profiling/Profiling.h"
+#include "../ride/Ride.h"
+#include "../ride/RideData.h"
+#include "Entrance.h"
+#include "Footpath.h"
+#include "Map.h"
+#include "TileElementsView.h"
+#include "tile_element/EntranceElement.h"
+#include "tile_element/PathElement.h"
+#include "tile_element/TileElement.h"
+#include "tile_element/TrackElement.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdlib>
+#include <limits>
+#include <map>
+#include <queue>
+#include <string>
+#include <tuple>
+#include <vector>
+
+using namespace OpenRCT2;
+
+namespace OpenRCT2::FootpathGraph
+{
+    constexpr uint32_t kNone = std::numeric_limits<uint32_t>::max();
+    // Marks a step target that is not a path but can be walked into, e.g. a ride entrance or a shop.
+    constexpr uint32_t kTerminalFlag = 0x80000000u;
+    constexpr size_t kMaxCachedGoals = 256;
+    constexpr uint8_t kUnknownDirection = 0xFE;
+
+    // Once this many tiles changed at once, rebuilding the whole graph is quicker than updating it.
+    constexpr size_t kMaxUpdatedTilesFraction = 16;
+    // Reported tiles kept before falling back to checking every tile.
+    constexpr size_t kMaxDirtyTiles = 4096;
+
+    struct Node
+    {
+        TileCoordsXYZ Location;
+        // Permitted edges of all path elements at this height.
+        uint8_t Edges{};
+        // Direction the path slopes up towards, kInvalidDirection if it is flat.
+        Direction SlopeDirection = kInvalidDirection;
+        bool IsJunction{};
+        bool InUse{};
+        // Ride of a queue that guests heading for another ride will not walk through.
+        RideId QueueRide = RideId::GetNull();
+        // The next node on the same tile, or kNone.
+        uint32_t NextOnTile = kNone;
+        // What a step in each direction leads to: a node index, a terminal index with kTerminalFlag set, or kNone.
+        std::array<uint32_t, kNumOrthogonalDirections> Next{ kNone, kNone, kNone, kNone };
+        // Junctions only: the link leaving in each direction.
+        std::array<uint32_t, kNumOrthogonalDirections> Links{ kNone, kNone, kNone, kNone };
+        // Other nodes: the links passing through this node and the number of steps along each link to get here.
+        std::array<uint32_t, 2> CorridorLinks{ kNone, kNone };
+        std::array<uint32_t, 2> CorridorSteps{};
+    };
+
+    struct Link
+    {
+        // The junction the link leaves and the direction it leaves in, kNone for an unused link.
+        uint32_t From = kNone;
+        Direction FirstDirection{};
+        // A junction node, a terminal index with kTerminalFlag set, or kNone if the path just ends.
+        uint32_t To = kNone;
+        uint32_t Length{};
+    };
+
+    struct GoalCache
+    {
+        uint32_t GoalNode = kNone;
+        // Links that pass through or end at the goal, with the number of steps along the link to the goal.
+        std::vector<std::pair<uint32_t, uint32_t>> LinkHits;
+        // First step towards the goal for each start node, kUnknownDirection until it has been searched for.
+        std::vector<uint8_t> Directions;
+    };
+
+    using GoalKey = std::tuple<int32_t, int32_t, int32_t, RideId, bool>;
+    // Estimated total cost, first direction, cost so far, node (kNone once the goal is reached).
+    using SearchEntry = std::tuple<uint32_t, Direction, uint32_t, uint32_t>;
+
+    // Nodes, links and terminals are reused through the free lists when tiles are updated.
+    static std::vector<Node> _nodes;
+    static std::vector<uint32_t> _freeNodes;
+    static uint32_t _numNodes;
+    // Index of the first node on each tile, or kNone.
+    static std::vector<uint32_t> _tileFirstNode;
+    static std::vector<Link> _links;
+    static std::vector<uint32_t> _freeLinks;
+    static std::vector<TileCoordsXYZ> _terminals;
+    static std::vector<uint32_t> _freeTerminals;
+    // Sorted by location key.
+    static std::vector<std::pair<uint64_t, uint32_t>> _terminalLinks;
+    static std::map<GoalKey, GoalCache> _goals;
+    static TileCoordsXY _mapSize;
+    static bool _needsRebuild = true;
+
+    // Hash of what the graph read from each tile, to find the tiles that changed since.
+    static std::vector<uint64_t> _tileHashes;
+    static std::vector<TileCoordsXY> _dirtyTiles;
+    static bool _checkAllTiles;
+
+    static std::vector<uint32_t> _searchStamps;
+    static std::vector<uint32_t> _searchCosts;
+    static std::vector<Direction> _searchDirections;
+    static uint32_t _searchStamp;
+
+    static uint64_t GetLocationKey(const TileCoordsXYZ& loc)
+    {
+        return (static_cast<uint64_t>(static_cast<uint16_t>(loc.x)) << 32)
+            | (static_cast<uint64_t>(static_cast<uint16_t>(loc.y)) << 16) | static_cast<uint16_t>(loc.z);
+    }
+
+    static bool IsOnMap(const TileCoordsXY& tile)
+    {
+        return tile.x >= 0 && tile.y >= 0 && tile.x < _mapSize.x && tile.y < _mapSize.y;
+    }
+
+    static size_t GetTileIndex(const TileCoordsXY& tile)
+    {
+        return static_cast<size_t>(tile.y) * _mapSize.x + tile.x;
+    }
+
+    static uint32_t FindNode(const TileCoordsXY& tile, int32_t z)
+    {
+        if (!IsOnMap(tile))
+            return kNone;
+
+        for (auto i = _tileFirstNode[GetTileIndex(tile)]; i != kNone; i = _nodes[i].NextOnTile)
+        {
+            if (_nodes[i].Location.z == z)
+                return i;
+        }
+        return kNone;
+    }
+
+    static bool IsShopOrFacility(const TrackElement& trackElement)
+    {
+        auto ride = GetRide(trackElement.GetRideIndex());
+        return ride != nullptr && ride->getRideTypeDescriptor().HasFlag(RtdFlag::isShopOrFacility);
+    }
+
+    /**
+     * Whether a guest stepping onto this element in the given direction has arrived somewhere, mirroring the
+     * non-path elements the classic search stops at.
+     */
+    static bool IsTerminal(const TileElement& tileElement, int32_t z, Direction direction)
+    {
+        if (tileElement.BaseHeight != z)
+            return false;
+
+        switch (tileElement.GetType())
+        {
+            case TileElementType::Track:
+                return IsShopOrFacility(*tileElement.AsTrack());
+            case TileElementType::Entrance:
+                switch (tileElement.AsEntrance()->GetEntranceType())
+                {
+                    case ENTRANCE_TYPE_RIDE_ENTRANCE:
+                    case ENTRANCE_TYPE_RIDE_EXIT:
+                        return tileElement.GetDirection() == direction;
+                    case ENTRANCE_TYPE_PARK_ENTRANCE:
+                        return true;
+                    default:
+                        return false;
+                }
+            default:
+                return false;
+        }
+    }
+
+    /**
+     * Hashes everything the nodes of a tile and the steps onto it are built from, so changes made in place, e.g.
+     * to path edges or banners, are found without every change having to report its tile.
+     */
+    static uint64_t GetTileHash(const TileCoordsXY& tile)
+    {
+        uint64_t hash = 0xCBF29CE484222325ull;
+        const auto add = [&hash](uint32_t value) { hash = (hash ^ value) * 0x100000001B3ull; };
+        for (const auto* tileElement : TileElementsView(tile.ToCoordsXY()))
+        {
+            if (tileElement->IsGhost())
+                continue;
+
+            switch (tileElement->GetType())
+            {
+                case TileElementType::Path:
+                {
+                    const auto* pathElement = tileElement->AsPath();
+                    add(0x100 | pathElement->BaseHeight);
+                    add(pathElement->IsSloped() ? pathElement->GetSlopeDirection() : kInvalidDirection);
+                    add(pathElement->IsQueue() && std::popcount(pathElement->GetEdges()) == 2
+                            ? pathElement->GetRideIndex().ToUnderlying()
+                            : RideId::GetNull().ToUnderlying());
+                    add(PathFinding::PathGetPermittedEdges(false, pathElement));
+                    break;
+                }
+                case TileElementType::Track:
+                    if (IsShopOrFacility(*tileElement->AsTrack()))
+                        add(0x200 | tileElement->BaseHeight);
+                    break;
+                case TileElementType::Entrance:
+                    add(0x300 | tileElement->BaseHeight);
+                    add(tileElement->AsEntrance()->GetEntranceType() << 8 | tileElement->GetDirection());
+                    break;
+                default:
+                    break;
+            }
+        }
+        return hash;
+    }
+
+    static uint32_t AddNode()
+    {
+        _numNodes++;
+        if (_freeNodes.empty())
+        {
+            _nodes.emplace_back();
+            return static_cast<uint32_t>(_nodes.size() - 1);
+        }
+
+        const auto index = _freeNodes.back();
+        _freeNodes.pop_back();
+        _nodes[index] = Node{};
+        return index;
+    }
+
+    static uint32_t AddTerminal(const TileCoordsXYZ& loc)
+    {
+        if (_freeTerminals.empty())
+        {
+            _terminals.push_back(loc);
+            return static_cast<uint32_t>(_terminals.size() - 1) | kTerminalFlag;
+        }
+
+        const auto index = _freeTerminals.back();
+        _freeTerminals.pop_back();
+        _terminals[index] = loc;
+        return index | kTerminalFlag;
+    }
+
+    static uint32_t FindStepTarget(const Node& node, Direction direction)
+    {
+        const auto tile = TileCoordsXY{ node.Location.x, node.Location.y } + TileDirectionDelta[direction];
+        if (!IsOnMap(tile))
+            return kNone;
+
+        const auto z = node.Location.z + (node.SlopeDirection == direction ? 2 : 0);
+        bool isTerminal = false;
+        const auto* tileElement = MapGetFirstElementAt(tile);
+        if (tileElement == nullptr)
+            return kNone;
+        do
+        {
+            if (tileElement->IsGhost())
+                continue;
+
+            if (tileElement->GetType() == TileElementType::Path)
+            {
+                if (FootpathIsZAndDirectionValid(*tileElement->AsPath(), z, direction))
+                    return FindNode(tile, tileElement->BaseHeight);
+            }
+            else if (IsTerminal(*tileElement, z, direction))
+            {
+                isTerminal = true;
+            }
+        } while (!(tileElement++)->IsLastForTile());
+
+        if (!isTerminal)
+            return kNone;
+
+        return AddTerminal(TileCoordsXYZ{ tile, z });
+    }
+
+    static void AddTileNodes(const TileCoordsXY& tile)
+    {
+        const auto tileIndex = GetTileIndex(tile);
+        for (auto* pathElement : TileElementsView<PathElement>(tile.ToCoordsXY()))
+        {
+            if (pathElement->IsGhost())
+                continue;
+
+            auto nodeIndex = FindNode(tile, pathElement->BaseHeight);
+            if (nodeIndex == kNone)
+            {
+                // As in the classic search, the first path element at a height decides the slope.
+                nodeIndex = AddNode();
+                auto& node = _nodes[nodeIndex];
+                node.Location = { tile, pathElement->BaseHeight };
+                node.InUse = true;
+                if (pathElement->IsSloped())
+                    node.SlopeDirection = pathElement->GetSlopeDirection();
+                if (pathElement->IsQueue() && std::popcount(pathElement->GetEdges()) == 2)
+                    node.QueueRide = pathElement->GetRideIndex();
+                node.NextOnTile = _tileFirstNode[tileIndex];
+                _tileFirstNode[tileIndex] = nodeIndex;
+            }
+            _nodes[nodeIndex].Edges |= PathFinding::PathGetPermittedEdges(false, pathElement);
+        }
+    }
+
+    static void ClearSteps(Node& node)
+    {
+        for (auto& next : node.Next)
+        {
+            if (next != kNone && (next & kTerminalFlag))
+                _freeTerminals.push_back(next & ~kTerminalFlag);
+            next = kNone;
+        }
+    }
+
+    static void RemoveTileNodes(const TileCoordsXY& tile)
+    {
+        auto& firstNode = _tileFirstNode[GetTileIndex(tile)];
+        for (auto i = firstNode; i != kNone; i = _nodes[i].NextOnTile)
+        {
+            ClearSteps(_nodes[i]);
+            _nodes[i].InUse = false;
+            _freeNodes.push_back(i);
+            _numNodes--;
+        }
+        firstNode = kNone;
+    }
+
+    static void UpdateSteps(uint32_t nodeIndex)
+    {
+        auto& node = _nodes[nodeIndex];
+        ClearSteps(node);
+        for (Direction direction = 0; direction < kNumOrthogonalDirections; direction++)
+        {
+            if (node.Edges & (1u << direction))
+                node.Next[direction] = FindStepTarget(node, direction);
+        }
+        node.IsJunction = std::popcount(node.Edges) != 2 || !node.QueueRide.IsNull();
+    }
+
+    // A path entered from a side without an edge leaves two ways to continue, so it has to be a junction.
+    static void UpdateEnteredFromSide(uint32_t nodeIndex)
+    {
+        auto& node = _nodes[nodeIndex];
+        for (Direction direction = 0; direction < kNumOrthogonalDirections; direction++)
+        {
+            if (node.Edges & (1u << DirectionReverse(direction)))
+                continue;
+
+            const auto from = TileCoordsXY{ node.Location.x, node.Location.y }
+                + TileDirectionDelta[DirectionReverse(direction)];
+            if (!IsOnMap(from))
+                continue;
+
+            for (auto i = _tileFirstNode[GetTileIndex(from)]; i != kNone; i = _nodes[i].NextOnTile)
+            {
+                if (_nodes[i].Next[direction] == nodeIndex)
+                    node.IsJunction = true;
+            }
+        }
+    }
+
+    static void AddLink(uint32_t from, Direction firstDirection)
+    {
+        uint32_t linkIndex;
+        if (_freeLinks.empty())
+        {
+            linkIndex = static_cast<uint32_t>(_links.size());
+            _links.emplace_back();
+        }
+        else
+        {
+            linkIndex = _freeLinks.back();
+            _freeLinks.pop_back();
+        }
+
+        auto& link = _links[linkIndex];
+        link = Link{ from, firstDirection };
+        _nodes[from].Links[firstDirection] = linkIndex;
+
+        auto current = from;
+        auto direction = firstDirection;
+        while (true)
+        {
+            const auto next = _nodes[current].Next[direction];
+            link.Length++;
+            if (next == kNone)
+                break;
+            if (next & kTerminalFlag)
+            {
+                link.To = next;
+                const std::pair<uint64_t, uint32_t> terminalLink{ GetLocationKey(_terminals[next & ~kTerminalFlag]),
+                                                                  linkIndex };
+                _terminalLinks.insert(
+                    std::lower_bound(_terminalLinks.begin(), _terminalLinks.end(), terminalLink), terminalLink);
+                break;
+            }
+
+            auto& nextNode = _nodes[next];
+            if (nextNode.IsJunction)
+            {
+                link.To = next;
+                break;
+            }
+            if (link.Length > _numNodes)
+                break;
+
+            for (size_t slot = 0; slot < nextNode.CorridorLinks.size(); slot++)
+            {
+                if (nextNode.CorridorLinks[slot] == kNone)
+                {
+                    nextNode.CorridorLinks[slot] = linkIndex;
+                    nextNode.CorridorSteps[slot] = link.Length;
+                    break;
+                }
+            }
+
+            direction = Numerics::bitScanForward(nextNode.Edges & ~(1u << DirectionReverse(direction)));
+            current = next;
+        }
+    }
+
+    static void AddLinks(uint32_t nodeIndex)
+    {
+        const auto& node = _nodes[nodeIndex];
+        if (!node.InUse || !node.IsJunction)
+            return;
+
+        for (Direction direction = 0; direction < kNumOrthogonalDirections; direction++)
+        {
+            if (node.Next[direction] != kNone && node.Links[direction] == kNone)
+                AddLink(nodeIndex, direction);
+        }
+    }
+
+    static void RemoveLink(uint32_t linkIndex)
+    {
+        auto& link = _links[linkIndex];
+
+        // Walk the link again to take it off the nodes it passes through, which sit at every step but the last.
+        auto current = link.From;
+        auto direction = link.FirstDirection;
+        for (uint32_t steps = 1; steps < link.Length; steps++)
+        {
+            current = _nodes[current].Next[direction];
+            auto& node = _nodes[current];
+            for (size_t slot = 0; slot < node.CorridorLinks.size(); slot++)
+            {
+                if (node.CorridorLinks[slot] == linkIndex)
+                {
+                    node.CorridorLinks[slot] = kNone;
+                    node.CorridorSteps[slot] = 0;
+                    break;
+                }
+            }
+            direction = Numerics::bitScanForward(node.Edges & ~(1u << DirectionReverse(direction)));
+        }
+
+        if (link.To != kNone && (link.To & kTerminalFlag))
+        {
+            const std::pair<uint64_t, uint32_t> terminalLink{ GetLocationKey(_terminals[link.To & ~kTerminalFlag]),
+                                                              linkIndex };
+            auto it = std::lower_bound(_terminalLinks.begin(), _terminalLinks.end(), terminalLink);
+            if (it != _terminalLinks.end() && *it == terminalLink)
+                _terminalLinks.erase(it);
+        }
+
+        _nodes[link.From].Links[link.FirstDirection] = kNone;
+        link = Link{};
+        _freeLinks.push_back(linkIndex);
+    }
+
+    static void ResetSearch()
+    {
+        _goals.clear();
+        _searchStamps.assign(_nodes.size(), 0);
+        _searchCosts.resize(_nodes.size());
+        _searchDirections.resize(_nodes.size());
+        _searchStamp = 0;
+    }
+
+    static void Rebuild()
+    {
+        PROFILED_FUNCTION();
+
+        _needsRebuild = false;
+        _mapSize = getGameState().mapSize;
+        _nodes.clear();
+        _freeNodes.clear();
+        _numNodes = 0;
+        _links.clear();
+        _freeLinks.clear();
+        _terminals.clear();
+        _freeTerminals.clear();
+        _terminalLinks.clear();
+        _dirtyTiles.clear();
+        _checkAllTiles = false;
+
+        const auto numTiles = static_cast<size_t>(_mapSize.x) * _mapSize.y;
+        _tileFirstNode.assign(numTiles, kNone);
+        _tileHashes.resize(numTiles);
+        for (int32_t y = 0; y < _mapSize.y; y++)
+        {
+            for (int32_t x = 0; x < _mapSize.x; x++)
+            {
+                AddTileNodes({ x, y });
+                _tileHashes[GetTileIndex({ x, y })] = GetTileHash({ x, y });
+            }
+        }
+
+        for (uint32_t i = 0; i < _nodes.size(); i++)
+            UpdateSteps(i);
+        for (uint32_t i = 0; i < _nodes.size(); i++)
+            UpdateEnteredFromSide(i);
+        for (uint32_t i = 0; i < _nodes.size(); i++)
+            AddLinks(i);
+
+        ResetSearch();
+    }
+
+    /**
+     * Rebuilds the nodes of the changed tiles, the steps and junctions of the nodes next to them, and the links
+     * running through any of those. Everything else keeps its index.
+     */
+    static void UpdateTiles(const std::vector<TileCoordsXY>& changedTiles)
+    {
+        PROFILED_FUNCTION();
+
+        std::vector<TileCoordsXY> affectedTiles;
+        for (const auto& tile : changedTiles)
+        {
+            affectedTiles.push_back(tile);
+            for (Direction direction = 0; direction < kNumOrthogonalDirections; direction++)
+            {
+                const auto neighbour = tile + TileDirectionDelta[direction];
+                if (IsOnMap(neighbour))
+                    affectedTiles.push_back(neighbour);
+            }
+        }
+        std::sort(affectedTiles.begin(), affectedTiles.end(), [](const TileCoordsXY& a, const TileCoordsXY& b) {
+            return GetTileIndex(a) < GetTileIndex(b);
+        });
+        affectedTiles.erase(std::unique(affectedTiles.begin(), affectedTiles.end()), affectedTiles.end());
+
+        const auto forEachNode = [](const std::vector<TileCoordsXY>& tiles, auto&& fn) {
+            for (const auto& tile : tiles)
+            {
+                for (auto i = _tileFirstNode[GetTileIndex(tile)]; i != kNone; i = _nodes[i].NextOnTile)
+                    fn(i);
+            }
+        };
+
+        // Links leaving, passing through or ending at an affected node, the last arriving from a neighbouring tile.
+        std::vector<uint32_t> staleLinks;
+        forEachNode(affectedTiles, [&staleLinks](uint32_t nodeIndex) {
+            const auto& node = _nodes[nodeIndex];
+            const auto addLinks = [&staleLinks](const Node& from, uint32_t to) {
+                for (auto linkIndex : from.Links)
+                {
+                    if (linkIndex != kNone && (to == kNone || _links[linkIndex].To == to))
+                        staleLinks.push_back(linkIndex);
+                }
+                for (auto linkIndex : from.CorridorLinks)
+                {
+                    if (linkIndex != kNone && (to == kNone || _links[linkIndex].To == to))
+                        staleLinks.push_back(linkIndex);
+                }
+            };
+            addLinks(node, kNone);
+            for (Direction direction = 0; direction < kNumOrthogonalDirections; direction++)
+            {
+                const auto from = TileCoordsXY{ node.Location.x, node.Location.y } + TileDirectionDelta[direction];
+                if (!IsOnMap(from))
+                    continue;
+                for (auto i = _tileFirstNode[GetTileIndex(from)]; i != kNone; i = _nodes[i].NextOnTile)
+                    addLinks(_nodes[i], nodeIndex);
+            }
+        });
+        std::sort(staleLinks.begin(), staleLinks.end());
+        staleLinks.erase(std::unique(staleLinks.begin(), staleLinks.end()), staleLinks.end());
+
+        std::vector<uint32_t> linkStarts;
+        for (auto linkIndex : staleLinks)
+        {
+            linkStarts.push_back(_links[linkIndex].From);
+            RemoveLink(linkIndex);
+        }
+
+        for (const auto& tile : changedTiles)
+        {
+            RemoveTileNodes(tile);
+            AddTileNodes(tile);
+        }
+        forEachNode(affectedTiles, UpdateSteps);
+        forEachNode(affectedTiles, UpdateEnteredFromSide);
+
+        for (auto nodeIndex : linkStarts)
+            AddLinks(nodeIndex);
+        forEachNode(affectedTiles, AddLinks);
+
+        ResetSearch();
+    }
+
+    static void Update()
+    {
+        if (_needsRebuild || _mapSize != getGameState().mapSize)
+        {
+            Rebuild();
+            return;
+        }
+
+        std::vector<TileCoordsXY> changedTiles;
+        const auto checkTile = [&changedTiles](const TileCoordsXY& tile) {
+            auto& hash = _tileHashes[GetTileIndex(tile)];
+            const auto newHash = GetTileHash(tile);
+            if (newHash != hash)
+            {
+                hash = newHash;
+                changedTiles.push_back(tile);
+            }
+        };
+
+        if (_checkAllTiles)
+        {
+            for (int32_t y = 0; y < _mapSize.y; y++)
+            {
+                for (int32_t x = 0; x < _mapSize.x; x++)
+                    checkTile({ x, y });
+            }
+        }
+        else
+        {
+            for (const auto& tile : _dirtyTiles)
+            {
+                if (IsOnMap(tile))
+                    checkTile(tile);
+            }
+        }
+        _dirtyTiles.clear();
+        _checkAllTiles = false;
+
+        if (changedTiles.empty())
+            return;
+
+        if (changedTiles.size() > _tileHashes.size() / kMaxUpdatedTilesFraction)
+            Rebuild();
+        else
+            UpdateTiles(changedTiles);
+    }
+
+    static GoalCache& GetGoalCache(const TileCoordsXYZ& goal, bool ignoreForeignQueues, RideId queueRideIndex)
+    {
+        const GoalKey key{ goal.x, goal.y, goal.z, queueRideIndex, ignoreForeignQueues };
+        auto it = _goals.find(key);
+        if (it != _goals.end())
+            return it->second;
+
+        if (_goals.size() >= kMaxCachedGoals)
+            _goals.clear();
+
+        auto& cache = _goals[key];
+        cache.Directions.assign(_nodes.size(), kUnknownDirection);
+        cache.GoalNode = FindNode({ goal.x, goal.y }, goal.z);
+        if (cache.GoalNode != kNone && !_nodes[cache.GoalNode].IsJunction)
+        {
+            const auto& goalNode = _nodes[cache.GoalNode];
+            for (size_t slot = 0; slot < goalNode.CorridorLinks.size(); slot++)
+            {
+                if (goalNode.CorridorLinks[slot] != kNone)
+                    cache.LinkHits.emplace_back(goalNode.CorridorLinks[slot], goalNode.CorridorSteps[slot]);
+            }
+        }
+
+        const auto range = std::equal_range(
+            _terminalLinks.begin(), _terminalLinks.end(), std::pair<uint64_t, uint32_t>{ GetLocationKey(goal), 0 },
+            [](const auto& a, const auto& b) { return a.first < b.first; });
+        for (auto terminalLink = range.first; terminalLink != range.second; terminalLink++)
+        {
+            cache.LinkHits.emplace_back(terminalLink->second, _links[terminalLink->second].Length);
+        }
+        return cache;
+    }
+
+    /**
+     * A* over the junctions, starting with a walk out of the start tile in every direction as the start is
+     * usually part of a link. Costs are compared together with the first direction taken, so that of all the
+     * shortest walks the one starting with the lowest direction is found.
+     */
+    static Direction Search(
+        uint32_t start, const TileCoordsXYZ& goal, const GoalCache& cache, bool ignoreForeignQueues, RideId queueRideIndex)
+    {
+        if (++_searchStamp == 0)
+        {
+            std::fill(_searchStamps.begin(), _searchStamps.end(), 0);
+            _searchStamp = 1;
+        }
+
+        std::priority_queue<SearchEntry, std::vector<SearchEntry>, std::greater<>> open;
+        const auto reachGoal = [&open](uint32_t cost, Direction firstDirection) {
+            open.emplace(cost, firstDirection, cost, kNone);
+        };
+        const auto reachJunction = [&open, &goal](uint32_t node, uint32_t cost, Direction firstDirection) {
+            if (_searchStamps[node] == _searchStamp
+                && (cost > _searchCosts[node] || (cost == _searchCosts[node] && firstDirection >= _searchDirections[node])))
+                return;
+
+            _searchStamps[node] = _searchStamp;
+            _searchCosts[node] = cost;
+            _searchDirections[node] = firstDirection;
+            const auto& loc = _nodes[node].Location;
+            const auto estimate = static_cast<uint32_t>(std::abs(loc.x - goal.x) + std::abs(loc.y - goal.y));
+            open.emplace(cost + estimate, firstDirection, cost, node);
+        };
+
+        _searchStamps[start] = _searchStamp;
+        _searchCosts[start] = 0;
+        _searchDirections[start] = 0;
+
+        const auto& startNode = _nodes[start];
+        for (Direction firstDirection = 0; firstDirection < kNumOrthogonalDirections; firstDirection++)
+        {
+            if (!(startNode.Edges & (1u << firstDirection)))
+                continue;
+
+            auto current = start;
+            auto direction = firstDirection;
+            for (uint32_t steps = 1; steps <= _nodes.size(); steps++)
+            {
+                const auto next = _nodes[current].Next[direction];
+                if (next == kNone || next == start)
+                    break;
+                if (next & kTerminalFlag)
+                {
+                    if (_terminals[next & ~kTerminalFlag] == goal)
+                        reachGoal(steps, firstDirection);
+                    break;
+                }
+                if (next == cache.GoalNode)
+                {
+                    reachGoal(steps, firstDirection);
+                    break;
+                }
+                if (_nodes[next].IsJunction)
+                {
+                    reachJunction(next, steps, firstDirection);
+                    break;
+                }
+                direction = Numerics::bitScanForward(_nodes[next].Edges & ~(1u << DirectionReverse(direction)));
+                current = next;
+            }
+        }
+
+        while (!open.empty())
+        {
+            const auto [estimate, firstDirection, cost, node] = open.top();
+            open.pop();
+
+            if (node == kNone)
+                return firstDirection;
+            if (_searchCosts[node] != cost || _searchDirections[node] != firstDirection)
+                continue;
+
+            const auto& junction = _nodes[node];
+            if (ignoreForeignQueues && !junction.QueueRide.IsNull() && junction.QueueRide != queueRideIndex)
+                continue;
+
+            for (auto linkIndex : junction.Links)
+            {
+                if (linkIndex == kNone)
+                    continue;
+
+                const auto& link = _links[linkIndex];
+                const auto hit = std::find_if(cache.LinkHits.begin(), cache.LinkHits.end(), [linkIndex](const auto& linkHit) {
+                    return linkHit.first == linkIndex;
+                });
+                if (hit != cache.LinkHits.end())
+                    reachGoal(cost + hit->second, firstDirection);
+                else if (link.To != kNone && link.To == cache.GoalNode)
+                    reachGoal(cost + link.Length, firstDirection);
+                else if (link.To != kNone && !(link.To & kTerminalFlag))
+                    reachJunction(link.To, cost + link.Length, firstDirection);
+            }
+        }
+        return kInvalidDirection;
+    }
+
+    void InvalidateAll()
+    {
+        _needsRebuild = true;
+    }
+
+    void InvalidateTile(const TileCoordsXY& coords)
+    {
+        if (_needsRebuild || _checkAllTiles)
+            return;
+
+        if (_dirtyTiles.size() >= kMaxDirtyTiles)
+        {
+            InvalidateUnknownTiles();
+            return;
+        }
+        _dirtyTiles.push_back(coords);
+    }
+
+    void InvalidateUnknownTiles()
+    {
+        _checkAllTiles = true;
+        _dirtyTiles.clear();
+    }
+
+    Direction ChooseDirection(
+        const TileCoordsXYZ& loc, const TileCoordsXYZ& goal, bool ignoreForeignQueues, RideId queueRideIndex)
+    {
+        PROFILED_FUNCTION();
+
+        Update();
+
+        const auto start = FindNode({ loc.x, loc.y }, loc.z);
+        if (start == kNone)
+            return kInvalidDirection;
+
+        auto& cache = GetGoalCache(goal, ignoreForeignQueues, queueRideIndex);
+        if (start == cache.GoalNode)
+            return kInvalidDirection;
+
+        auto& direction = cache.Directions[start];
+        if (direction == kUnknownDirection)
+            direction = Search(start, goal, cache, ignoreForeignQueues, queueRideIndex);
+        return direction;
+    }
+
+    std::string Dump()
+    {
+        Update();
+
+        const auto describeLocation = [](const TileCoordsXYZ& loc) {
+            return std::to_string(loc.x) + "," + std::to_string(loc.y) + "," + std::to_string(loc.z);
+        };
+        const auto describeTarget = [&describeLocation](uint32_t target) -> std::string {
+            if (target == kNone)
+                return "-";
+            if (target & kTerminalFlag)
+                return "terminal " + describeLocation(_terminals[target & ~kTerminalFlag]);
+            return describeLocation(_nodes[target].Location);
+        };
+
+        std::vector<std::string> lines;
+        for (const auto& node : _nodes)
+        {
+            if (!node.InUse)
+                continue;
+
+            auto line = describeLocation(node.Location) + ": edges " + std::to_string(node.Edges) + ", slope "
+                + std::to_string(node.SlopeDirection) + ", queue " + std::to_string(node.QueueRide.ToUnderlying())
+                + (node.IsJunction ? ", junction" : "");
+            for (Direction direction = 0; direction < kNumOrthogonalDirections; direction++)
+            {
+                line += "; " + std::to_string(direction) + " steps to " + describeTarget(node.Next[direction]);
+                if (node.Links[direction] != kNone)
+                {
+                    const auto& link = _links[node.Links[direction]];
+                    line += " linked to " + describeTarget(link.To) + " in " + std::to_string(link.Length);
+                }
+            }
+
+            std::vector<std::string> corridorLinks;
+            for (size_t slot = 0; slot < node.CorridorLinks.size(); slot++)
+            {
+                if (node.CorridorLinks[slot] == kNone)
+                    continue;
+                const auto& link = _links[node.CorridorLinks[slot]];
+                corridorLinks.push_back(
+                    "; on link from " + describeLocation(_nodes[link.From].Location) + " going "
+                    + std::to_string(link.FirstDirection) + " after " + std::to_string(node.CorridorSteps[slot]));
+            }
+            std::sort(corridorLinks.begin(), corridorLinks.end());
+            for (const auto& corridorLink : corridorLinks)
+                line += corridorLink;
+
+            lines.push_back(std::move(line));
+        }
+        std::sort(lines.begin(), lines.end());
+
+        std::string result;
+        for (const auto& line : lines)
+            result += line + "\n";
+        return result;
+    }
+} // namespace OpenRCT2::FootpathGraph
@@ -0,0 +1,45 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2025 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "../Identifiers.h"
+#include "Location.hpp"
+
+#include <string>
+
+/**
+ * Graph of the walkable footpath network used by the optional A* guest path finding. Runs of path tiles with
+ * exactly one way forward are collapsed into a single link between junctions, dead ends and ride queues.
+ * Changed tiles are found on the next query, from the tiles reported or by comparing every tile with what the graph
+ * was built from, and only the nodes and links around them are rebuilt. The first step of every answered query is
+ * cached per destination so guests heading to the same ride share the work.
+ */
+namespace OpenRCT2::FootpathGraph
+{
+    // Rebuilds the whole graph on the next query, for when the map itself is replaced.
+    void InvalidateAll();
+    void InvalidateTile(const TileCoordsXY& coords);
+    // Checks every tile for changes on the next query, for changes made without knowing the tile.
+    void InvalidateUnknownTiles();
+
+    /**
+     * Returns the direction of the first step of the shortest walk from loc to goal, or kInvalidDirection if
+     * loc is not on a path or the goal can not be reached. Equally short walks are resolved towards the lowest
+     * direction, so the answer does not depend on which queries happened before.
+     */
+    Direction ChooseDirection(
+        const TileCoordsXYZ& loc, const TileCoordsXYZ& goal, bool ignoreForeignQueues, RideId queueRideIndex);
+
+    /**
+     * Brings the graph up to date and describes it in a way that does not depend on the order it was built in, so
+     * an updated graph can be compared with a rebuilt one.
+     */
+    std::string Dump();
+} // namespace OpenRCT2::FootpathGraph
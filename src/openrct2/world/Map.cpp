@@ -37,6 +37,7 @@
 #include "../object/ObjectManager.h"
 #include "../object/SmallSceneryEntry.h"
 #include "../object/TerrainSurfaceObject.h"
+#include "../paint/PaintCache.h"
 #include "../profiling/Profiling.h"
 #include "../ride/RideConstruction.h"
 #include "../ride/RideData.h"
@@ -50,10 +51,14 @@
 #include "Climate.h"
 #include "Entrance.h"
 #include "Footpath.h"
+#include "FootpathGraph.h"
 #include "MapAnimation.h"
 #include "Park.h"
+#include "RideProximityIndex.h"
 #include "Scenery.h"
+#include "SurroundingsIndex.h"
 #include "TileElementsView.h"
+#include "TileHeightMap.h"
 #include "TileInspector.h"
 #include "tile_element/BannerElement.h"
 #include "tile_element/EntranceElement.h"
@@ -157,6 +162,11 @@ void SetTileElements(GameState_t& gameState, std::vector<TileElement>&& tileElem
     _tileIndex = TilePointerIndex<TileElement>(
         kMaximumMapSizeTechnical, gameState.tileElements.data(), gameState.tileElements.size());
     _tileElementsInUse = gameState.tileElements.size();
+    RideProximityIndex::InvalidateAll();
+    SurroundingsIndex::InvalidateAll();
+    FootpathGraph::InvalidateAll();
+    PaintCache::InvalidateAll();
+    TileHeightMap::InvalidateAll();
 }
 
 static TileElement GetDefaultSurfaceElement()
@@ -536,6 +546,10 @@ void MapStripGhostFlagFromElements()
     {
         element.SetGhost(false);
     }
+    RideProximityIndex::InvalidateAll();
+    SurroundingsIndex::InvalidateAll();
+    FootpathGraph::InvalidateAll();
+    PaintCache::InvalidateAll();
 }
 
 /**
@@ -1026,6 +1040,38 @@ bool MapIsLocationAtEdge(const CoordsXY& loc)
  */
 void TileElementRemove(TileElement* tileElement)
 {
+    // The tile of the element is not known here, so let the indices rebuild themselves on their next use
+    switch (tileElement->GetType())
+    {
+        case TileElementType::Track:
+            if (!tileElement->IsGhost())
+            {
+                RideProximityIndex::InvalidateRide(tileElement->AsTrack()->GetRideIndex());
+                FootpathGraph::InvalidateUnknownTiles();
+            }
+            break;
+        case TileElementType::Path:
+            if (!tileElement->IsGhost())
+            {
+                if (tileElement->AsPath()->HasAddition())
+                    SurroundingsIndex::InvalidateAll();
+                FootpathGraph::InvalidateUnknownTiles();
+            }
+            break;
+        case TileElementType::Entrance:
+        case TileElementType::Banner:
+            if (!tileElement->IsGhost())
+                FootpathGraph::InvalidateUnknownTiles();
+            break;
+        case TileElementType::SmallScenery:
+        case TileElementType::LargeScenery:
+            if (!tileElement->IsGhost())
+                SurroundingsIndex::InvalidateAll();
+            break;
+        default:
+            break;
+    }
+
     // Replace Nth element by (N+1)th element.
     // This loop will make tileElement point to the old last element position,
     // after copy it to it's new position
@@ -1235,6 +1281,29 @@ TileElement* TileElementInsert(const CoordsXYZ& loc, int32_t occupiedQuadrants,
     std::memset(&newTileElement->Pad08, 0, sizeof(newTileElement->Pad08));
     newTileElement++;
 
+    TileHeightMap::InvalidateTile(tileLoc);
+    switch (type)
+    {
+        case TileElementType::Track:
+            RideProximityIndex::InvalidateTile(tileLoc);
+            FootpathGraph::InvalidateTile(tileLoc);
+            break;
+        case TileElementType::Path:
+            SurroundingsIndex::InvalidateTile(tileLoc);
+            FootpathGraph::InvalidateTile(tileLoc);
+            break;
+        case TileElementType::Entrance:
+        case TileElementType::Banner:
+            FootpathGraph::InvalidateTile(tileLoc);
+            break;
+        case TileElementType::SmallScenery:
+        case TileElementType::LargeScenery:
+            SurroundingsIndex::InvalidateTile(tileLoc);
+            break;
+        default:
+            break;
+    }
+
     // Insert rest of map elements above insert height
     if (!isLastForTile)
     {
@@ -1399,6 +1468,7 @@ void MapExtendBoundarySurfaceY()
 
         Park::UpdateFences({ x << 5, y << 5 });
     }
+    TileHeightMap::InvalidateRange({ 0, y }, { kMaximumMapSizeTechnical - 1, y });
 }
 
 /**
@@ -1417,6 +1487,7 @@ void MapExtendBoundarySurfaceX()
         }
         Park::UpdateFences({ x << 5, y << 5 });
     }
+    TileHeightMap::InvalidateRange({ x, 0 }, { x, kMaximumMapSizeTechnical - 1 });
 }
 
 static void MapExtendBoundarySurfaceShiftX(const int32_t amount, const int32_t mapSizeY)
@@ -1769,6 +1840,9 @@ bool MapLargeScenerySignSetColour(const CoordsXYZD& signPos, int32_t sequence, u
 
 static void MapInvalidateTileUnderZoom(int32_t x, int32_t y, int32_t z0, int32_t z1, ZoomLevel maxZoom)
 {
+    // Whatever changed on the tile may have changed its height as well.
+    TileHeightMap::InvalidateTile(TileCoordsXY(CoordsXY{ x, y }));
+
     if (gOpenRCT2Headless)
         return;
 
@@ -1820,6 +1894,8 @@ void MapInvalidateRegion(const CoordsXY& mins, const CoordsXY& maxs)
 {
     int32_t x0, y0, x1, y1, left, right, top, bottom;
 
+    TileHeightMap::InvalidateRange(TileCoordsXY(mins), TileCoordsXY(maxs));
+
     x0 = mins.x + 16;
     y0 = mins.y + 16;
 
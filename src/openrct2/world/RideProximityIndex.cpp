@@ -0,0 +1,284 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2025 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "RideProximityIndex.h"
+
+#include "../GameState.h"
+#include "../Identifiers.h"
+#include "../profiling/Profiling.h"
+#include "Map.h"
+#include "TileElementsView.h"
+#include "tile_element/TrackElement.h"
+
+#include <algorithm>
+#include <vector>
+
+using namespace OpenRCT2;
+
+namespace OpenRCT2::RideProximityIndex
+{
+    constexpr int32_t kBlockShift = 2;
+    constexpr int32_t kBlockSize = 1 << kBlockShift;
+
+    struct BlockEntry
+    {
+        RideId Ride;
+        // One bit per tile in the block (row major) on which the ride has track, ghost track left out.
+        uint16_t TileMask;
+    };
+
+    struct Block
+    {
+        // Sorted by ride, one entry per ride.
+        std::vector<BlockEntry> Entries;
+        bool Dirty{};
+    };
+
+    static_assert(kBlockSize * kBlockSize <= 16);
+
+    static std::vector<Block> _blocks;
+    static std::vector<size_t> _dirtyBlocks;
+    // Tiles that had ghost track when their block was built. Construction previews place and remove ghost track every
+    // frame, so it is looked up on these few tiles instead, and tiles that no longer have any are dropped on update.
+    static std::vector<TileCoordsXY> _ghostTrackTiles;
+    static TileCoordsXY _mapSize;
+    static int32_t _blocksX;
+    static int32_t _blocksY;
+    static bool _needsRebuild = true;
+
+    static void RebuildBlock(int32_t blockX, int32_t blockY)
+    {
+        auto& block = _blocks[blockY * _blocksX + blockX];
+        block.Entries.clear();
+        block.Dirty = false;
+
+        const auto startX = blockX << kBlockShift;
+        const auto startY = blockY << kBlockShift;
+        const auto endX = std::min(startX + kBlockSize, static_cast<int32_t>(_mapSize.x));
+        const auto endY = std::min(startY + kBlockSize, static_cast<int32_t>(_mapSize.y));
+        for (auto y = startY; y < endY; y++)
+        {
+            for (auto x = startX; x < endX; x++)
+            {
+                const auto tileBit = static_cast<uint16_t>(1u << (((y - startY) << kBlockShift) + (x - startX)));
+                for (auto* trackElement : TileElementsView<TrackElement>(TileCoordsXY{ x, y }.ToCoordsXY()))
+                {
+                    auto rideIndex = trackElement->GetRideIndex();
+                    if (rideIndex.IsNull())
+                        continue;
+
+                    if (trackElement->IsGhost())
+                    {
+                        const TileCoordsXY coords{ x, y };
+                        if (std::find(_ghostTrackTiles.begin(), _ghostTrackTiles.end(), coords) == _ghostTrackTiles.end())
+                        {
+                            _ghostTrackTiles.push_back(coords);
+                        }
+                        continue;
+                    }
+
+                    auto it = std::lower_bound(
+                        block.Entries.begin(), block.Entries.end(), rideIndex,
+                        [](const BlockEntry& entry, RideId id) { return entry.Ride < id; });
+                    if (it == block.Entries.end() || it->Ride != rideIndex)
+                    {
+                        it = block.Entries.insert(it, BlockEntry{ rideIndex, 0 });
+                    }
+                    it->TileMask |= tileBit;
+                }
+            }
+        }
+    }
+
+    static void Rebuild()
+    {
+        PROFILED_FUNCTION();
+
+        _mapSize = getGameState().mapSize;
+        _blocksX = (_mapSize.x + kBlockSize - 1) >> kBlockShift;
+        _blocksY = (_mapSize.y + kBlockSize - 1) >> kBlockShift;
+        _blocks.clear();
+        _blocks.resize(static_cast<size_t>(_blocksX) * _blocksY);
+        _dirtyBlocks.clear();
+        _ghostTrackTiles.clear();
+        _needsRebuild = false;
+
+        for (auto blockY = 0; blockY < _blocksY; blockY++)
+        {
+            for (auto blockX = 0; blockX < _blocksX; blockX++)
+            {
+                RebuildBlock(blockX, blockY);
+            }
+        }
+    }
+
+    static bool HasGhostTrack(const TileCoordsXY& coords)
+    {
+        for (auto* trackElement : TileElementsView<TrackElement>(coords.ToCoordsXY()))
+        {
+            if (trackElement->IsGhost() && !trackElement->GetRideIndex().IsNull())
+                return true;
+        }
+        return false;
+    }
+
+    static void Update()
+    {
+        if (_needsRebuild || _mapSize != getGameState().mapSize)
+        {
+            Rebuild();
+            return;
+        }
+
+        for (auto blockIndex : _dirtyBlocks)
+        {
+            RebuildBlock(static_cast<int32_t>(blockIndex % _blocksX), static_cast<int32_t>(blockIndex / _blocksX));
+        }
+        _dirtyBlocks.clear();
+
+        std::erase_if(_ghostTrackTiles, [](const TileCoordsXY& coords) { return !HasGhostTrack(coords); });
+    }
+
+    static uint16_t GetQueryMask(int32_t minX, int32_t minY, int32_t maxX, int32_t maxY)
+    {
+        const auto rowMask = ((1u << (maxX + 1)) - 1) & ~((1u << minX) - 1);
+        uint32_t mask = 0;
+        for (auto y = minY; y <= maxY; y++)
+        {
+            mask |= rowMask << (y << kBlockShift);
+        }
+        return static_cast<uint16_t>(mask);
+    }
+
+    void InvalidateAll()
+    {
+        _needsRebuild = true;
+        _dirtyBlocks.clear();
+    }
+
+    static void InvalidateBlock(size_t blockIndex)
+    {
+        auto& block = _blocks[blockIndex];
+        if (!block.Dirty)
+        {
+            block.Dirty = true;
+            _dirtyBlocks.push_back(blockIndex);
+        }
+    }
+
+    void InvalidateTile(const TileCoordsXY& coords)
+    {
+        if (_needsRebuild)
+            return;
+
+        if (coords.x < 0 || coords.y < 0 || coords.x >= _mapSize.x || coords.y >= _mapSize.y)
+            return;
+
+        InvalidateBlock(static_cast<size_t>(coords.y >> kBlockShift) * _blocksX + (coords.x >> kBlockShift));
+    }
+
+    void InvalidateRide(RideId rideIndex)
+    {
+        if (_needsRebuild || rideIndex.IsNull())
+            return;
+
+        for (size_t blockIndex = 0; blockIndex < _blocks.size(); blockIndex++)
+        {
+            const auto& entries = _blocks[blockIndex].Entries;
+            if (std::binary_search(
+                    entries.begin(), entries.end(), BlockEntry{ rideIndex, 0 },
+                    [](const BlockEntry& a, const BlockEntry& b) { return a.Ride < b.Ride; }))
+            {
+                InvalidateBlock(blockIndex);
+            }
+        }
+    }
+
+    void QueryRides(
+        BitSet<Limits::kMaxRidesInPark>& rides, const TileCoordsXY& min, const TileCoordsXY& max, bool includeGhosts)
+    {
+        PROFILED_FUNCTION();
+
+        Update();
+
+        const auto minX = std::max(min.x, 0);
+        const auto minY = std::max(min.y, 0);
+        const auto maxX = std::min(max.x, kMaximumMapSizeTechnical - 1);
+        const auto maxY = std::min(max.y, kMaximumMapSizeTechnical - 1);
+        if (minX > maxX || minY > maxY)
+            return;
+
+        // Elements beyond the map size are removed when the map shrinks, but look at any such tiles directly
+        // rather than rely on it so the result can never differ from walking every tile in the range.
+        for (auto y = minY; y <= maxY; y++)
+        {
+            for (auto x = y >= _mapSize.y ? minX : std::max(minX, static_cast<int32_t>(_mapSize.x)); x <= maxX; x++)
+            {
+                for (auto* trackElement : TileElementsView<TrackElement>(TileCoordsXY{ x, y }.ToCoordsXY()))
+                {
+                    if (!includeGhosts && trackElement->IsGhost())
+                        continue;
+
+                    auto rideIndex = trackElement->GetRideIndex();
+                    if (!rideIndex.IsNull())
+                    {
+                        rides[rideIndex.ToUnderlying()] = true;
+                    }
+                }
+            }
+        }
+
+        const auto indexMaxX = std::min(maxX, _mapSize.x - 1);
+        const auto indexMaxY = std::min(maxY, _mapSize.y - 1);
+        if (minX > indexMaxX || minY > indexMaxY)
+            return;
+
+        for (auto blockY = minY >> kBlockShift; blockY <= indexMaxY >> kBlockShift; blockY++)
+        {
+            for (auto blockX = minX >> kBlockShift; blockX <= indexMaxX >> kBlockShift; blockX++)
+            {
+                const auto& block = _blocks[blockY * _blocksX + blockX];
+                if (block.Entries.empty())
+                    continue;
+
+                const auto startX = blockX << kBlockShift;
+                const auto startY = blockY << kBlockShift;
+                const auto queryMask = GetQueryMask(
+                    std::max(minX, startX) - startX, std::max(minY, startY) - startY,
+                    std::min(indexMaxX, startX + kBlockSize - 1) - startX,
+                    std::min(indexMaxY, startY + kBlockSize - 1) - startY);
+                for (const auto& entry : block.Entries)
+                {
+                    if (entry.TileMask & queryMask)
+                    {
+                        rides[entry.Ride.ToUnderlying()] = true;
+                    }
+                }
+            }
+        }
+
+        if (!includeGhosts)
+            return;
+
+        for (const auto& coords : _ghostTrackTiles)
+        {
+            if (coords.x < minX || coords.y < minY || coords.x > indexMaxX || coords.y > indexMaxY)
+                continue;
+
+            for (auto* trackElement : TileElementsView<TrackElement>(coords.ToCoordsXY()))
+            {
+                auto rideIndex = trackElement->GetRideIndex();
+                if (!rideIndex.IsNull())
+                {
+                    rides[rideIndex.ToUnderlying()] = true;
+                }
+            }
+        }
+    }
+} // namespace OpenRCT2::RideProximityIndex
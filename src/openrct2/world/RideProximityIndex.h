@@ -0,0 +1,36 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2025 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "../Identifiers.h"
+#include "../Limits.h"
+#include "../core/BitSet.hpp"
+#include "Location.hpp"
+
+/**
+ * Coarse spatial index of which rides have track on each block of tiles, used by guests to find nearby rides
+ * without walking every tile element in their search radius. The index is rebuilt lazily on the next query
+ * after the tile elements change, so results are always identical to scanning the tiles directly.
+ */
+namespace OpenRCT2::RideProximityIndex
+{
+    void InvalidateAll();
+    void InvalidateTile(const TileCoordsXY& coords);
+
+    // Invalidates the blocks holding track of the ride, for when a track element is removed from an unknown tile.
+    // Removing ghost track needs no invalidation.
+    void InvalidateRide(RideId rideIndex);
+
+    /**
+     * Sets the bit of every ride that has a track element on any tile in the inclusive range [min, max].
+     */
+    void QueryRides(
+        BitSet<Limits::kMaxRidesInPark>& rides, const TileCoordsXY& min, const TileCoordsXY& max, bool includeGhosts = true);
+} // namespace OpenRCT2::RideProximityIndex
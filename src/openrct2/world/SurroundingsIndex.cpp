@@ -0,0 +1,260 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2025 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "SurroundingsIndex.h"
+
+#include "../GameState.h"
+#include "../object/PathAdditionEntry.h"
+#include "../profiling/Profiling.h"
+#include "Map.h"
+#include "TileElementsView.h"
+#include "tile_element/PathElement.h"
+#include "tile_element/TileElement.h"
+
+#include <algorithm>
+#include <vector>
+
+using namespace OpenRCT2;
+
+namespace OpenRCT2::SurroundingsIndex
+{
+    constexpr int32_t kBlockShift = 4;
+    constexpr int32_t kBlockSize = 1 << kBlockShift;
+
+    struct Block
+    {
+        // Summed-area table over the block, row major. Empty when nothing in the block is counted.
+        std::vector<Counts> Table;
+        bool Dirty{};
+    };
+
+    static std::vector<Block> _blocks;
+    static std::vector<size_t> _dirtyBlocks;
+    static TileCoordsXY _mapSize;
+    static int32_t _blocksX;
+    static int32_t _blocksY;
+    static bool _needsRebuild = true;
+
+    static Counts& operator+=(Counts& lhs, const Counts& rhs)
+    {
+        lhs.scenery += rhs.scenery;
+        lhs.fountains += rhs.fountains;
+        lhs.brokenAdditions += rhs.brokenAdditions;
+        lhs.missingAdditions += rhs.missingAdditions;
+        return lhs;
+    }
+
+    static Counts& operator-=(Counts& lhs, const Counts& rhs)
+    {
+        lhs.scenery -= rhs.scenery;
+        lhs.fountains -= rhs.fountains;
+        lhs.brokenAdditions -= rhs.brokenAdditions;
+        lhs.missingAdditions -= rhs.missingAdditions;
+        return lhs;
+    }
+
+    static bool IsEmpty(const Counts& counts)
+    {
+        return counts.scenery == 0 && counts.fountains == 0 && counts.brokenAdditions == 0 && counts.missingAdditions == 0;
+    }
+
+    static void AddTileCounts(Counts& counts, const TileCoordsXY& coords)
+    {
+        for (auto* tileElement : TileElementsView(coords.ToCoordsXY()))
+        {
+            if (tileElement->IsGhost())
+                continue;
+
+            switch (tileElement->GetType())
+            {
+                case TileElementType::Path:
+                {
+                    auto* pathElement = tileElement->AsPath();
+                    if (!pathElement->HasAddition())
+                        break;
+
+                    auto* pathAddEntry = pathElement->GetAdditionEntry();
+                    if (pathAddEntry == nullptr)
+                    {
+                        counts.missingAdditions++;
+                        break;
+                    }
+                    if (pathElement->AdditionIsGhost())
+                        break;
+
+                    if (pathAddEntry->flags
+                        & (PATH_ADDITION_FLAG_JUMPING_FOUNTAIN_WATER | PATH_ADDITION_FLAG_JUMPING_FOUNTAIN_SNOW))
+                    {
+                        counts.fountains++;
+                    }
+                    else if (pathElement->IsBroken())
+                    {
+                        counts.brokenAdditions++;
+                    }
+                    break;
+                }
+                case TileElementType::LargeScenery:
+                case TileElementType::SmallScenery:
+                    counts.scenery++;
+                    break;
+                default:
+                    break;
+            }
+        }
+    }
+
+    static void RebuildBlock(int32_t blockX, int32_t blockY)
+    {
+        auto& block = _blocks[blockY * _blocksX + blockX];
+        block.Dirty = false;
+        block.Table.assign(kBlockSize * kBlockSize, Counts{});
+
+        const auto startX = blockX << kBlockShift;
+        const auto startY = blockY << kBlockShift;
+        for (auto y = 0; y < kBlockSize; y++)
+        {
+            Counts rowSum{};
+            for (auto x = 0; x < kBlockSize; x++)
+            {
+                if (startX + x < _mapSize.x && startY + y < _mapSize.y)
+                {
+                    AddTileCounts(rowSum, { startX + x, startY + y });
+                }
+
+                auto& entry = block.Table[(y << kBlockShift) + x];
+                entry = rowSum;
+                if (y > 0)
+                {
+                    entry += block.Table[((y - 1) << kBlockShift) + x];
+                }
+            }
+        }
+
+        if (IsEmpty(block.Table.back()))
+        {
+            block.Table.clear();
+            block.Table.shrink_to_fit();
+        }
+    }
+
+    static void Rebuild()
+    {
+        PROFILED_FUNCTION();
+
+        _mapSize = getGameState().mapSize;
+        _blocksX = (_mapSize.x + kBlockSize - 1) >> kBlockShift;
+        _blocksY = (_mapSize.y + kBlockSize - 1) >> kBlockShift;
+        _blocks.clear();
+        _blocks.resize(static_cast<size_t>(_blocksX) * _blocksY);
+        _dirtyBlocks.clear();
+        _needsRebuild = false;
+
+        for (auto blockY = 0; blockY < _blocksY; blockY++)
+        {
+            for (auto blockX = 0; blockX < _blocksX; blockX++)
+            {
+                RebuildBlock(blockX, blockY);
+            }
+        }
+    }
+
+    static void Update()
+    {
+        if (_needsRebuild || _mapSize != getGameState().mapSize)
+        {
+            Rebuild();
+            return;
+        }
+
+        for (auto blockIndex : _dirtyBlocks)
+        {
+            RebuildBlock(static_cast<int32_t>(blockIndex % _blocksX), static_cast<int32_t>(blockIndex / _blocksX));
+        }
+        _dirtyBlocks.clear();
+    }
+
+    void InvalidateAll()
+    {
+        _needsRebuild = true;
+        _dirtyBlocks.clear();
+    }
+
+    void InvalidateTile(const TileCoordsXY& coords)
+    {
+        if (_needsRebuild)
+            return;
+
+        if (coords.x < 0 || coords.y < 0 || coords.x >= _mapSize.x || coords.y >= _mapSize.y)
+            return;
+
+        const auto blockIndex = static_cast<size_t>(coords.y >> kBlockShift) * _blocksX + (coords.x >> kBlockShift);
+        auto& block = _blocks[blockIndex];
+        if (!block.Dirty)
+        {
+            block.Dirty = true;
+            _dirtyBlocks.push_back(blockIndex);
+        }
+    }
+
+    Counts Query(const TileCoordsXY& min, const TileCoordsXY& max)
+    {
+        Update();
+
+        Counts result{};
+
+        const auto minX = std::max(min.x, 0);
+        const auto minY = std::max(min.y, 0);
+        const auto maxX = std::min(max.x, kMaximumMapSizeTechnical - 1);
+        const auto maxY = std::min(max.y, kMaximumMapSizeTechnical - 1);
+        if (minX > maxX || minY > maxY)
+            return result;
+
+        // Elements beyond the map size are removed when the map shrinks, but count any such tiles directly
+        // rather than rely on it so the result can never differ from walking every tile in the range.
+        for (auto y = minY; y <= maxY; y++)
+        {
+            for (auto x = y >= _mapSize.y ? minX : std::max(minX, static_cast<int32_t>(_mapSize.x)); x <= maxX; x++)
+            {
+                AddTileCounts(result, { x, y });
+            }
+        }
+
+        const auto indexMaxX = std::min(maxX, _mapSize.x - 1);
+        const auto indexMaxY = std::min(maxY, _mapSize.y - 1);
+        if (minX > indexMaxX || minY > indexMaxY)
+            return result;
+
+        for (auto blockY = minY >> kBlockShift; blockY <= indexMaxY >> kBlockShift; blockY++)
+        {
+            for (auto blockX = minX >> kBlockShift; blockX <= indexMaxX >> kBlockShift; blockX++)
+            {
+                const auto& table = _blocks[blockY * _blocksX + blockX].Table;
+                if (table.empty())
+                    continue;
+
+                const auto startX = blockX << kBlockShift;
+                const auto startY = blockY << kBlockShift;
+                const auto left = std::max(minX, startX) - startX;
+                const auto top = std::max(minY, startY) - startY;
+                const auto right = std::min(indexMaxX, startX + kBlockSize - 1) - startX;
+                const auto bottom = std::min(indexMaxY, startY + kBlockSize - 1) - startY;
+
+                // Counts are unsigned, so the intermediate wrap around of the subtractions cancels out.
+                result += table[(bottom << kBlockShift) + right];
+                if (left > 0)
+                    result -= table[(bottom << kBlockShift) + left - 1];
+                if (top > 0)
+                    result -= table[((top - 1) << kBlockShift) + right];
+                if (left > 0 && top > 0)
+                    result += table[((top - 1) << kBlockShift) + left - 1];
+            }
+        }
+        return result;
+    }
+} // namespace OpenRCT2::SurroundingsIndex
@@ -0,0 +1,39 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2025 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "Location.hpp"
+
+#include <cstdint>
+
+/**
+ * Per-tile counts of the non-ghost tile elements guests take notice of when assessing their surroundings,
+ * kept as summed-area tables over blocks of tiles so the counts of any rectangle can be read in constant time.
+ * Changed tiles are recounted lazily on the next query.
+ */
+namespace OpenRCT2::SurroundingsIndex
+{
+    struct Counts
+    {
+        uint32_t scenery{};
+        uint32_t fountains{};
+        uint32_t brokenAdditions{};
+        // Path additions whose object is not loaded.
+        uint32_t missingAdditions{};
+    };
+
+    void InvalidateAll();
+    void InvalidateTile(const TileCoordsXY& coords);
+
+    /**
+     * Returns the counts summed over all tiles in the inclusive range [min, max].
+     */
+    Counts Query(const TileCoordsXY& min, const TileCoordsXY& max);
+} // namespace OpenRCT2::SurroundingsIndex
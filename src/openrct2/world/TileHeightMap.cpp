@@ -0,0 +1,140 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2025 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "TileHeightMap.h"
+
+#include "Map.h"
+#include "tile_element/SurfaceElement.h"
+#include "tile_element/TileElement.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <mutex>
+
+namespace OpenRCT2::TileHeightMap
+{
+    constexpr int32_t kBlockShift = 3;
+    constexpr int32_t kBlockSize = 1 << kBlockShift;
+    constexpr int32_t kBlocksPerSide = (kMaximumMapSizeTechnical + kBlockSize - 1) / kBlockSize;
+
+    struct Block
+    {
+        // The generation the heights were measured at, blocks measured at an older one are measured again.
+        std::atomic<uint32_t> Generation{};
+        uint16_t MaxZ{};
+        std::array<uint16_t, kBlockSize * kBlockSize> TileMaxZ{};
+    };
+
+    static std::array<Block, kBlocksPerSide * kBlocksPerSide> _blocks;
+    static std::mutex _mutex;
+    // Never 0, which marks a block that has to be measured again.
+    static std::atomic<uint32_t> _generation{ 1 };
+
+    static bool IsInRange(const TileCoordsXY& coords)
+    {
+        return coords.x >= 0 && coords.y >= 0 && coords.x < kMaximumMapSizeTechnical && coords.y < kMaximumMapSizeTechnical;
+    }
+
+    static Block& GetBlockAt(const TileCoordsXY& coords)
+    {
+        return _blocks[(coords.y >> kBlockShift) * kBlocksPerSide + (coords.x >> kBlockShift)];
+    }
+
+    static uint16_t MeasureTile(const TileCoordsXY& coords)
+    {
+        const auto* element = MapGetFirstElementAt(coords);
+        if (element == nullptr)
+            return 0;
+
+        int32_t maxZ = 0;
+        do
+        {
+            maxZ = std::max(maxZ, element->GetClearanceZ());
+            if (const auto* surface = element->AsSurface(); surface != nullptr)
+                maxZ = std::max(maxZ, surface->GetWaterHeight());
+        } while (!(element++)->IsLastForTile());
+        return static_cast<uint16_t>(maxZ);
+    }
+
+    static const Block& GetMeasuredBlock(const TileCoordsXY& coords)
+    {
+        auto& block = GetBlockAt(coords);
+        const auto generation = _generation.load(std::memory_order_relaxed);
+        if (block.Generation.load(std::memory_order_acquire) == generation)
+            return block;
+
+        std::lock_guard lock(_mutex);
+        if (block.Generation.load(std::memory_order_relaxed) == generation)
+            return block;
+
+        const auto startX = coords.x & ~(kBlockSize - 1);
+        const auto startY = coords.y & ~(kBlockSize - 1);
+        uint16_t blockMaxZ = 0;
+        for (auto y = 0; y < kBlockSize; y++)
+        {
+            for (auto x = 0; x < kBlockSize; x++)
+            {
+                const TileCoordsXY tileCoords{ startX + x, startY + y };
+                const uint16_t maxZ = IsInRange(tileCoords) ? MeasureTile(tileCoords) : 0;
+                block.TileMaxZ[(y << kBlockShift) + x] = maxZ;
+                blockMaxZ = std::max(blockMaxZ, maxZ);
+            }
+        }
+        block.MaxZ = blockMaxZ;
+        block.Generation.store(generation, std::memory_order_release);
+        return block;
+    }
+
+    void InvalidateAll()
+    {
+        auto generation = _generation.load(std::memory_order_relaxed) + 1;
+        if (generation == 0)
+            generation = 1;
+        _generation.store(generation, std::memory_order_relaxed);
+    }
+
+    void InvalidateTile(const TileCoordsXY& coords)
+    {
+        if (IsInRange(coords))
+            GetBlockAt(coords).Generation.store(0, std::memory_order_relaxed);
+    }
+
+    void InvalidateRange(const TileCoordsXY& min, const TileCoordsXY& max)
+    {
+        const auto minX = std::max(min.x, 0) >> kBlockShift;
+        const auto minY = std::max(min.y, 0) >> kBlockShift;
+        const auto maxX = std::min<int32_t>(max.x, kMaximumMapSizeTechnical - 1) >> kBlockShift;
+        const auto maxY = std::min<int32_t>(max.y, kMaximumMapSizeTechnical - 1) >> kBlockShift;
+        for (auto blockY = minY; blockY <= maxY; blockY++)
+        {
+            for (auto blockX = minX; blockX <= maxX; blockX++)
+            {
+                _blocks[blockY * kBlocksPerSide + blockX].Generation.store(0, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    int32_t GetTileMaxZ(const TileCoordsXY& coords)
+    {
+        if (!IsInRange(coords))
+            return 0;
+
+        const auto& block = GetMeasuredBlock(coords);
+        return block.TileMaxZ[((coords.y & (kBlockSize - 1)) << kBlockShift) + (coords.x & (kBlockSize - 1))];
+    }
+
+    int32_t GetBlockMaxZ(const TileCoordsXY& coords)
+    {
+        if (!IsInRange(coords))
+            return 0;
+
+        return GetMeasuredBlock(coords).MaxZ;
+    }
+} // namespace OpenRCT2::TileHeightMap
@@ -0,0 +1,32 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2025 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "Location.hpp"
+
+#include <cstdint>
+
+/**
+ * The highest clearance or water height of every tile and of every block of tiles, so painting can skip tiles that
+ * cannot reach the area being drawn without looking at their elements. Changed tiles are measured again lazily, when
+ * their block is next queried, which may happen from several paint threads at once.
+ */
+namespace OpenRCT2::TileHeightMap
+{
+    void InvalidateAll();
+    void InvalidateTile(const TileCoordsXY& coords);
+    void InvalidateRange(const TileCoordsXY& min, const TileCoordsXY& max);
+
+    // Returns the highest z of the elements on the tile, or 0 outside the map.
+    int32_t GetTileMaxZ(const TileCoordsXY& coords);
+
+    // Returns the highest z of the elements on all tiles of the block the tile belongs to.
+    int32_t GetBlockMaxZ(const TileCoordsXY& coords);
+} // namespace OpenRCT2::TileHeightMap
@@ -23,6 +23,7 @@
 #include "MapAnimation.h"
 #include "Park.h"
 #include "Scenery.h"
+#include "SurroundingsIndex.h"
 #include "tile_element/BannerElement.h"
 #include "tile_element/EntranceElement.h"
 #include "tile_element/LargeSceneryElement.h"
@@ -616,6 +617,7 @@ namespace OpenRCT2::TileInspector
         if (isExecuting)
         {
             pathElement->AsPath()->SetIsBroken(broken);
+            SurroundingsIndex::InvalidateTile(TileCoordsXY(loc));
         }
 
         return GameActions::Result();
@@ -13,6 +13,7 @@
 #include "../../GameState.h"
 #include "../../object/ObjectManager.h"
 #include "../../util/Util.h"
+#include "../TileHeightMap.h"
 #include "../tile_element/Slope.h"
 #include "../tile_element/SurfaceElement.h"
 #include "HeightMap.hpp"
@@ -54,6 +55,9 @@ namespace OpenRCT2::World::MapGenerator
         // Place trees?
         if (settings->trees)
             placeTrees(settings);
+
+        // The surfaces were shaped directly rather than through the map functions.
+        TileHeightMap::InvalidateAll();
     }
 
     void resetSurfaces(Settings* settings)
@@ -0,0 +1,246 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2025 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <gtest/gtest.h>
+#include <openrct2/config/Config.h>
+#include <openrct2/drawing/Drawing.h>
+#include <openrct2/drawing/SpriteMipCache.h>
+#include <openrct2/platform/Platform.h>
+#include <random>
+#include <vector>
+
+using RemapRunFunc = void (*)(const uint8_t*, uint8_t*, int32_t, const uint8_t*, bool);
+
+// Compares a vector remap function against RemapRunScalar for runs of all lengths, alignments and both remap modes.
+static void TestRemapRun(RemapRunFunc func)
+{
+    constexpr int32_t kMaxLength = 100;
+    constexpr int32_t kMaxOffset = 32;
+
+    std::mt19937 rng(1234);
+    std::uniform_int_distribution<int32_t> byteDist(0, 255);
+    auto randomByte = [&]() { return static_cast<uint8_t>(byteDist(rng)); };
+
+    for (int32_t iteration = 0; iteration < 20; iteration++)
+    {
+        // Make sure both transparent pixels and pixels mapping to 0 come up often.
+        std::array<uint8_t, 256> map;
+        for (auto& entry : map)
+            entry = (randomByte() % 8) == 0 ? 0 : randomByte();
+
+        std::vector<uint8_t> src(kMaxOffset + kMaxLength);
+        std::vector<uint8_t> dst(kMaxOffset + kMaxLength);
+        for (size_t i = 0; i < src.size(); i++)
+        {
+            src[i] = (randomByte() % 4) == 0 ? 0 : randomByte();
+            dst[i] = randomByte();
+        }
+
+        for (bool remapDst : { false, true })
+        {
+            for (int32_t offset = 0; offset < kMaxOffset; offset += 3)
+            {
+                for (int32_t length = 0; length <= kMaxLength; length++)
+                {
+                    auto expected = dst;
+                    auto actual = dst;
+                    RemapRunScalar(src.data() + offset, expected.data() + offset, length, map.data(), remapDst);
+                    func(src.data() + offset, actual.data() + offset, length, map.data(), remapDst);
+                    ASSERT_EQ(expected, actual) << "offset " << offset << ", length " << length << ", remapDst "
+                                                << remapDst;
+                }
+            }
+        }
+    }
+}
+
+TEST(DrawingTest, remap_run_avx2)
+{
+    if (!OpenRCT2::Platform::AVX2Available())
+        GTEST_SKIP() << "AVX2 is not available";
+
+    TestRemapRun(RemapRunAvx2);
+}
+
+using PaletteToRgbaFunc = void (*)(const uint8_t*, uint32_t*, int32_t, const uint32_t*);
+
+// Compares a vector palette expansion against PaletteToRgbaScalar for runs of all lengths and alignments.
+static void TestPaletteToRgba(PaletteToRgbaFunc func)
+{
+    constexpr int32_t kMaxLength = 100;
+    constexpr int32_t kMaxOffset = 32;
+
+    std::mt19937 rng(1234);
+
+    std::array<uint32_t, 256> palette;
+    for (auto& entry : palette)
+        entry = static_cast<uint32_t>(rng());
+
+    std::vector<uint8_t> src(kMaxOffset + kMaxLength);
+    for (auto& pixel : src)
+        pixel = static_cast<uint8_t>(rng());
+
+    for (int32_t offset = 0; offset < kMaxOffset; offset++)
+    {
+        for (int32_t length = 0; length <= kMaxLength; length++)
+        {
+            std::vector<uint32_t> expected(kMaxOffset + kMaxLength + 8, 0xDEADBEEF);
+            auto actual = expected;
+            PaletteToRgbaScalar(src.data() + offset, expected.data() + offset, length, palette.data());
+            func(src.data() + offset, actual.data() + offset, length, palette.data());
+            ASSERT_EQ(expected, actual) << "offset " << offset << ", length " << length;
+        }
+    }
+}
+
+TEST(DrawingTest, palette_to_rgba_sse4_1)
+{
+    if (!OpenRCT2::Platform::SSE41Available())
+        GTEST_SKIP() << "SSE 4.1 is not available";
+
+    TestPaletteToRgba(PaletteToRgbaSse4_1);
+}
+
+TEST(DrawingTest, palette_to_rgba_avx2)
+{
+    if (!OpenRCT2::Platform::AVX2Available())
+        GTEST_SKIP() << "AVX2 is not available";
+
+    TestPaletteToRgba(PaletteToRgbaAvx2);
+}
+
+// Encodes rows of pixels as an RLE sprite, pixels that are not drawn are given as -1.
+static std::vector<uint8_t> EncodeRLESprite(const std::vector<std::vector<int32_t>>& rows)
+{
+    std::vector<uint8_t> data(rows.size() * sizeof(uint16_t));
+    for (size_t y = 0; y < rows.size(); y++)
+    {
+        const auto& row = rows[y];
+        const auto offset = static_cast<uint16_t>(data.size());
+        std::memcpy(&data[y * sizeof(uint16_t)], &offset, sizeof(uint16_t));
+
+        size_t lastChunk = data.size();
+        data.push_back(0);
+        data.push_back(0);
+        for (size_t x = 0; x < row.size();)
+        {
+            if (row[x] < 0)
+            {
+                x++;
+                continue;
+            }
+
+            if (data[lastChunk] != 0)
+            {
+                lastChunk = data.size();
+                data.push_back(0);
+                data.push_back(0);
+            }
+            data[lastChunk + 1] = static_cast<uint8_t>(x);
+            for (; x < row.size() && row[x] >= 0 && data[lastChunk] < 0x7F; x++)
+            {
+                data[lastChunk]++;
+                data.push_back(static_cast<uint8_t>(row[x]));
+            }
+        }
+        data[lastChunk] |= 0x80;
+    }
+    return data;
+}
+
+// Draws zoomed out RLE sprites with and without the minified sprite cache, which must give the same pixels.
+TEST(DrawingTest, rle_sprite_mip_cache_matches_uncached)
+{
+    auto& general = OpenRCT2::Config::Get().general;
+    const auto cacheEnabled = general.MinifiedSpriteCache;
+
+    std::mt19937 rng(1234);
+    auto randomInt = [&](int32_t min, int32_t max) { return std::uniform_int_distribution<int32_t>(min, max)(rng); };
+
+    // Map to 0 now and then, which is not drawn by the transparent blend modes.
+    std::vector<uint8_t> blendMaps(255 * 256);
+    for (auto& entry : blendMaps)
+        entry = randomInt(0, 7) == 0 ? 0 : static_cast<uint8_t>(randomInt(0, 255));
+    const PaletteMap paletteMap(blendMaps.data(), 255, 256);
+
+    const std::array images = {
+        ImageId(1),
+        ImageId(1).WithPrimary(COLOUR_BRIGHT_RED),
+        ImageId(1).WithBlended(true),
+        ImageId(1).WithPrimary(COLOUR_BRIGHT_RED).WithBlended(true),
+    };
+
+    for (int32_t iteration = 0; iteration < 200; iteration++)
+    {
+        const auto width = randomInt(1, 160);
+        const auto height = randomInt(1, 40);
+
+        // Runs include pixels of index 0, which are part of the run even if most blend modes skip them.
+        std::vector<std::vector<int32_t>> rows(height, std::vector<int32_t>(width, -1));
+        for (auto& row : rows)
+        {
+            for (auto x = randomInt(0, 8); x < width; x += randomInt(1, 12))
+            {
+                for (auto end = std::min(width, x + randomInt(1, 150)); x < end; x++)
+                    row[x] = randomInt(0, 3) == 0 ? 0 : randomInt(1, 255);
+            }
+        }
+        const auto data = EncodeRLESprite(rows);
+
+        G1Element element{};
+        element.offset = const_cast<uint8_t*>(data.data());
+        element.width = width;
+        element.height = height;
+        element.flags = G1_FLAG_RLE_COMPRESSION;
+
+        // A new sprite may be allocated where the previous one was.
+        OpenRCT2::Drawing::SpriteMipCache::InvalidateAll();
+
+        for (int32_t zoom = 1; zoom <= 3; zoom++)
+        {
+            // The cache is only used when drawing from a column at a multiple of the zoom.
+            const auto srcX = randomInt(0, (width - 1) >> zoom) << zoom;
+            const auto srcY = randomInt(0, height - 1);
+            const auto drawWidth = randomInt(1, width - srcX);
+            const auto drawHeight = randomInt(1, height - srcY);
+
+            RenderTarget rt;
+            rt.width = ((drawWidth - 1) >> zoom) + 1;
+            rt.height = ((drawHeight - 1) >> zoom) + 1;
+            rt.pitch = 3;
+            rt.zoom_level = ZoomLevel{ static_cast<int8_t>(zoom) };
+
+            std::vector<uint8_t> background(rt.LineStride() * rt.height);
+            for (auto& pixel : background)
+                pixel = static_cast<uint8_t>(randomInt(0, 255));
+
+            for (const auto& image : images)
+            {
+                auto expected = background;
+                auto actual = background;
+
+                general.MinifiedSpriteCache = false;
+                GfxRleSpriteToBuffer(
+                    rt, DrawSpriteArgs(image, paletteMap, element, srcX, srcY, drawWidth, drawHeight, expected.data()));
+
+                general.MinifiedSpriteCache = true;
+                GfxRleSpriteToBuffer(
+                    rt, DrawSpriteArgs(image, paletteMap, element, srcX, srcY, drawWidth, drawHeight, actual.data()));
+
+                ASSERT_EQ(expected, actual) << "iteration " << iteration << ", zoom " << zoom << ", src " << srcX << ","
+                                            << srcY << ", size " << drawWidth << "x" << drawHeight;
+            }
+        }
+    }
+
+    general.MinifiedSpriteCache = cacheEnabled;
+}
@@ -0,0 +1,288 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2025 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#ifndef DISABLE_NETWORK
+
+    #include "TestData.h"
+
+    #include <gtest/gtest.h>
+    #include <memory>
+    #include <openrct2/Context.h>
+    #include <openrct2/Game.h>
+    #include <openrct2/GameState.h>
+    #include <openrct2/OpenRCT2.h>
+    #include <openrct2/core/DataSerialiser.h>
+    #include <openrct2/core/MemoryStream.h>
+    #include <openrct2/entity/EntityRegistry.h>
+    #include <openrct2/entity/Litter.h>
+    #include <openrct2/network/NetworkRegions.h>
+    #include <openrct2/scenario/Scenario.h>
+    #include <openrct2/world/Map.h>
+    #include <openrct2/world/tile_element/TileElement.h>
+    #include <openrct2/world/tile_element/TrackElement.h>
+
+using namespace OpenRCT2;
+
+class NetworkRegionsTest : public testing::Test
+{
+public:
+    static void SetUpTestCase()
+    {
+        gOpenRCT2Headless = true;
+        gOpenRCT2NoGraphics = true;
+        _context = CreateContext();
+        const bool initialised = _context->Initialise();
+        ASSERT_TRUE(initialised);
+
+        std::string parkPath = TestData::GetParkPath("small_park_with_ferris_wheel.sv6");
+        GetContext()->LoadParkFromFile(parkPath);
+        GameLoadInit();
+    }
+
+    static void TearDownTestCase()
+    {
+        _context = nullptr;
+    }
+
+protected:
+    static TrackElement* FindTrackElement(TileCoordsXY& coords)
+    {
+        const auto& mapSize = getGameState().mapSize;
+        for (int32_t y = 0; y < mapSize.y; y++)
+        {
+            for (int32_t x = 0; x < mapSize.x; x++)
+            {
+                auto* element = MapGetFirstElementAt(TileCoordsXY{ x, y });
+                if (element == nullptr)
+                    continue;
+
+                do
+                {
+                    if (auto* trackElement = element->AsTrack(); trackElement != nullptr && !element->IsGhost())
+                    {
+                        coords = { x, y };
+                        return trackElement;
+                    }
+                } while (!(element++)->IsLastForTile());
+            }
+        }
+        return nullptr;
+    }
+
+    static std::vector<EntityId> FindFreeEntityIds(size_t count)
+    {
+        std::vector<EntityId> ids;
+        for (EntityId::UnderlyingType i = 0; i < NetworkRegions::kEntityGroupSize && ids.size() < count; i++)
+        {
+            auto id = EntityId::FromUnderlying(i);
+            if (GetEntity(id)->Type == EntityType::Null)
+                ids.push_back(id);
+        }
+        return ids;
+    }
+
+private:
+    static std::shared_ptr<IContext> _context;
+};
+
+std::shared_ptr<IContext> NetworkRegionsTest::_context;
+
+TEST_F(NetworkRegionsTest, highlight_does_not_change_checksum)
+{
+    TileCoordsXY coords;
+    auto* trackElement = FindTrackElement(coords);
+    ASSERT_NE(trackElement, nullptr);
+
+    const auto region = NetworkRegions::GetTileRegion(coords);
+    const auto checksum = NetworkRegions::GetChecksum(region);
+
+    // Only the ride construction window of one player blinks the highlight.
+    const bool highlighted = trackElement->IsHighlighted();
+    trackElement->SetHighlight(!highlighted);
+    EXPECT_EQ(checksum, NetworkRegions::GetChecksum(region));
+    trackElement->SetHighlight(highlighted);
+
+    // A change every player makes does show up.
+    const auto baseHeight = trackElement->BaseHeight;
+    trackElement->BaseHeight++;
+    EXPECT_NE(checksum, NetworkRegions::GetChecksum(region));
+    trackElement->BaseHeight = baseHeight;
+    EXPECT_EQ(checksum, NetworkRegions::GetChecksum(region));
+}
+
+TEST_F(NetworkRegionsTest, changes_are_reported_in_their_region)
+{
+    // One sweep reports every region exactly once.
+    std::vector<int32_t> timesReported(NetworkRegions::GetNumRegions());
+    const auto firstTick = getGameState().currentTicks;
+    for (auto tick = firstTick; tick < firstTick + NetworkRegions::kSweepTicks; tick++)
+    {
+        for (const auto& regionChecksum : NetworkRegions::GetTickChecksums(tick))
+        {
+            timesReported[regionChecksum.Region]++;
+        }
+    }
+    for (uint32_t region = 0; region < timesReported.size(); region++)
+    {
+        EXPECT_EQ(timesReported[region], 1) << NetworkRegions::GetName(region);
+    }
+
+    TileCoordsXY coords;
+    auto* trackElement = FindTrackElement(coords);
+    ASSERT_NE(trackElement, nullptr);
+
+    const auto freeIds = FindFreeEntityIds(1);
+    ASSERT_EQ(freeIds.size(), 1u);
+    auto* litter = CreateEntityAt<Litter>(freeIds[0]);
+    ASSERT_NE(litter, nullptr);
+    litter->MoveTo({ coords.ToCoordsXY(), trackElement->GetBaseZ() });
+
+    std::vector<uint64_t> checksums;
+    for (uint32_t region = 0; region < NetworkRegions::GetNumRegions(); region++)
+    {
+        checksums.push_back(NetworkRegions::GetChecksum(region));
+    }
+
+    const auto baseHeight = trackElement->BaseHeight;
+    trackElement->BaseHeight++;
+    litter->MoveTo({ coords.ToCoordsXY() + CoordsXY{ 8, 8 }, trackElement->GetBaseZ() });
+
+    // Only the regions of the changed tile and entity change, and the sweep reports them on their tick.
+    const std::vector<uint32_t> expected{ NetworkRegions::GetTileRegion(coords),
+                                          NetworkRegions::GetEntityRegion(freeIds[0]) };
+    std::vector<uint32_t> changed;
+    for (uint32_t region = 0; region < NetworkRegions::GetNumRegions(); region++)
+    {
+        if (NetworkRegions::GetChecksum(region) != checksums[region])
+            changed.push_back(region);
+    }
+    EXPECT_EQ(changed, expected);
+
+    for (auto region : expected)
+    {
+        bool reported = false;
+        for (const auto& regionChecksum : NetworkRegions::GetTickChecksums(region))
+        {
+            if (regionChecksum.Region == region)
+            {
+                EXPECT_NE(regionChecksum.Checksum, checksums[region]) << NetworkRegions::GetName(region);
+                reported = true;
+            }
+        }
+        EXPECT_TRUE(reported) << NetworkRegions::GetName(region);
+    }
+
+    trackElement->BaseHeight = baseHeight;
+    EntityRemove(GetEntity(freeIds[0]));
+}
+
+TEST_F(NetworkRegionsTest, write_read_restores_regions)
+{
+    TileCoordsXY coords;
+    auto* trackElement = FindTrackElement(coords);
+    ASSERT_NE(trackElement, nullptr);
+
+    const auto freeIds = FindFreeEntityIds(2);
+    ASSERT_EQ(freeIds.size(), 2u);
+
+    auto* litter = CreateEntityAt<Litter>(freeIds[0]);
+    ASSERT_NE(litter, nullptr);
+    litter->MoveTo({ coords.ToCoordsXY(), trackElement->GetBaseZ() });
+
+    const std::vector<uint32_t> regions = { NetworkRegions::GetTileRegion(coords),
+                                            NetworkRegions::GetEntityRegion(freeIds[0]) };
+    std::vector<uint64_t> checksums;
+    for (auto region : regions)
+    {
+        checksums.push_back(NetworkRegions::GetChecksum(region));
+    }
+
+    MemoryStream data;
+    DataSerialiser writer(true, data);
+    NetworkRegions::WriteRegions(writer, regions);
+
+    // Diverge the park the way a desynced client would.
+    trackElement->BaseHeight++;
+    trackElement->SetHighlight(true);
+    litter->MoveTo({ coords.ToCoordsXY() + CoordsXY{ 8, 8 }, trackElement->GetBaseZ() });
+    auto* extraLitter = CreateEntityAt<Litter>(freeIds[1]);
+    ASSERT_NE(extraLitter, nullptr);
+    extraLitter->MoveTo({ coords.ToCoordsXY(), trackElement->GetBaseZ() });
+    for (size_t i = 0; i < regions.size(); i++)
+    {
+        ASSERT_NE(checksums[i], NetworkRegions::GetChecksum(regions[i]));
+    }
+
+    data.SetPosition(0);
+    DataSerialiser reader(false, data);
+    NetworkRegions::ReadRegions(reader);
+
+    for (size_t i = 0; i < regions.size(); i++)
+    {
+        EXPECT_EQ(checksums[i], NetworkRegions::GetChecksum(regions[i]));
+    }
+    EXPECT_EQ(GetEntity(freeIds[1])->Type, EntityType::Null);
+
+    EntityRemove(GetEntity(freeIds[0]));
+}
+
+TEST_F(NetworkRegionsTest, resync_reports_all_diverged_regions)
+{
+    TileCoordsXY coords;
+    auto* trackElement = FindTrackElement(coords);
+    ASSERT_NE(trackElement, nullptr);
+
+    const auto freeIds = FindFreeEntityIds(1);
+    ASSERT_EQ(freeIds.size(), 1u);
+    auto* litter = CreateEntityAt<Litter>(freeIds[0]);
+    ASSERT_NE(litter, nullptr);
+    litter->MoveTo({ coords.ToCoordsXY(), trackElement->GetBaseZ() });
+
+    const auto tileRegion = NetworkRegions::GetTileRegion(coords);
+    const auto entityRegion = NetworkRegions::GetEntityRegion(freeIds[0]);
+    std::vector<uint64_t> serverChecksums;
+    for (uint32_t region = 0; region < NetworkRegions::GetNumRegions(); region++)
+    {
+        serverChecksums.push_back(NetworkRegions::GetChecksum(region));
+    }
+    const auto serverRandState = ScenarioRandState();
+
+    // The replies the server sends to the first request, for the region the sweep found, and to the next one.
+    MemoryStream firstReply;
+    DataSerialiser firstWriter(true, firstReply);
+    NetworkRegions::WriteResync(firstWriter, { tileRegion });
+    MemoryStream secondReply;
+    DataSerialiser secondWriter(true, secondReply);
+    NetworkRegions::WriteResync(secondWriter, { entityRegion });
+
+    // Diverge a tile, an entity and the random state the way a desynced client would.
+    trackElement->BaseHeight++;
+    litter->MoveTo({ coords.ToCoordsXY() + CoordsXY{ 8, 8 }, trackElement->GetBaseZ() });
+    ScenarioRandSeed(serverRandState.s0 + 1, serverRandState.s1);
+    ASSERT_NE(serverChecksums[tileRegion], NetworkRegions::GetChecksum(tileRegion));
+    ASSERT_NE(serverChecksums[entityRegion], NetworkRegions::GetChecksum(entityRegion));
+
+    firstReply.SetPosition(0);
+    DataSerialiser firstReader(false, firstReply);
+    EXPECT_EQ(NetworkRegions::ReadResync(firstReader), std::vector<uint32_t>{ entityRegion });
+    EXPECT_EQ(serverChecksums[tileRegion], NetworkRegions::GetChecksum(tileRegion));
+    EXPECT_EQ(ScenarioRandState().s0, serverRandState.s0);
+
+    secondReply.SetPosition(0);
+    DataSerialiser secondReader(false, secondReply);
+    EXPECT_TRUE(NetworkRegions::ReadResync(secondReader).empty());
+    for (uint32_t region = 0; region < NetworkRegions::GetNumRegions(); region++)
+    {
+        EXPECT_EQ(serverChecksums[region], NetworkRegions::GetChecksum(region)) << NetworkRegions::GetName(region);
+    }
+
+    EntityRemove(GetEntity(freeIds[0]));
+}
+
+#endif // DISABLE_NETWORK
@@ -0,0 +1,186 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2025 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "TestData.h"
+
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <memory>
+#include <openrct2/Context.h>
+#include <openrct2/Game.h>
+#include <openrct2/GameState.h>
+#include <openrct2/OpenRCT2.h>
+#include <openrct2/actions/GameAction.h>
+#include <openrct2/actions/RideSetAppearanceAction.h>
+#include <openrct2/actions/SmallSceneryPlaceAction.h>
+#include <openrct2/config/Config.h>
+#include <openrct2/drawing/NewDrawing.h>
+#include <openrct2/drawing/X8DrawingEngine.h>
+#include <openrct2/interface/Viewport.h>
+#include <openrct2/object/ObjectEntryManager.h>
+#include <openrct2/object/ObjectLimits.h>
+#include <openrct2/object/SmallSceneryEntry.h>
+#include <openrct2/ride/Ride.h>
+#include <openrct2/ride/RideManager.hpp>
+#include <openrct2/world/Map.h>
+#include <openrct2/world/Park.h>
+#include <optional>
+#include <string>
+#include <vector>
+
+using namespace OpenRCT2;
+using namespace OpenRCT2::Drawing;
+
+class PaintCacheTest : public testing::Test
+{
+protected:
+    static constexpr int32_t kWidth = 1024;
+    static constexpr int32_t kHeight = 768;
+
+    void SetUp() override
+    {
+        // Painting needs the sprites of the base game.
+        gOpenRCT2Headless = true;
+        gOpenRCT2NoGraphics = false;
+        _context = CreateContext();
+        if (!_context->Initialise())
+        {
+            _context = nullptr;
+            GTEST_SKIP() << "The RCT2 graphics are not available";
+        }
+        DrawingEngineInit();
+
+        std::string parkPath = TestData::GetParkPath("bpb.sv6");
+        ASSERT_TRUE(_context->LoadParkFromFile(parkPath));
+        GameLoadInit();
+        gLegacyScene = LegacyScene::playing;
+    }
+
+    void TearDown() override
+    {
+        if (_context != nullptr)
+        {
+            DrawingEngineDispose();
+            _context = nullptr;
+        }
+        gOpenRCT2NoGraphics = true;
+    }
+
+    // Renders the whole map, either retaining paint like window viewports do or painting every tile anew.
+    std::vector<uint8_t> Render(bool retainPaint)
+    {
+        const auto& mapSize = getGameState().mapSize;
+        const CoordsXY centreXY = { (mapSize.x / 2) * kCoordsXYStep, (mapSize.y / 2) * kCoordsXYStep };
+        const CoordsXYZ centre = { centreXY, TileElementHeight(centreXY) };
+
+        Viewport viewport{};
+        viewport.width = kWidth;
+        viewport.height = kHeight;
+        viewport.zoom = ZoomLevel::max();
+        auto centre2d = Translate3DTo2DWithZ(viewport.rotation, centre);
+        viewport.viewPos = { centre2d.x - viewport.ViewWidth() / 2, centre2d.y - viewport.ViewHeight() / 2 };
+
+        std::vector<uint8_t> pixels(static_cast<size_t>(kWidth) * kHeight);
+        RenderTarget rt;
+        rt.bits = pixels.data();
+        rt.width = kWidth;
+        rt.height = kHeight;
+
+        X8DrawingEngine drawingEngine(_context->GetUiContext());
+        rt.DrawingEngine = &drawingEngine;
+
+        drawingEngine.BeginDraw();
+        ViewportRender(rt, &viewport, retainPaint);
+        drawingEngine.EndDraw();
+        return pixels;
+    }
+
+    // The first render after a change must not show stale retained paint, the second one replays what it retained.
+    void ExpectRetainedMatchesFresh(const char* situation)
+    {
+        const auto retained = Render(true);
+        const auto replayed = Render(true);
+        const auto fresh = Render(false);
+        EXPECT_EQ(fresh, retained) << situation;
+        EXPECT_EQ(fresh, replayed) << situation;
+    }
+
+    static std::optional<ObjectEntryIndex> FindAnimatedSmallScenery()
+    {
+        for (ObjectEntryIndex i = 0; i < kMaxSmallSceneryObjects; i++)
+        {
+            const auto* entry = ObjectManager::GetObjectEntry<SmallSceneryEntry>(i);
+            if (entry != nullptr && entry->HasFlag(SMALL_SCENERY_FLAG_ANIMATED))
+                return i;
+        }
+        return std::nullopt;
+    }
+
+    // Places the scenery on the first tile around the centre of the map it fits on.
+    static bool PlaceSmallScenery(ObjectEntryIndex entryIndex)
+    {
+        auto& gameState = getGameState();
+        gameState.cheats.sandboxMode = true;
+        gameState.park.Flags |= PARK_FLAGS_NO_MONEY;
+
+        const auto& mapSize = gameState.mapSize;
+        for (int32_t y = mapSize.y / 2; y < mapSize.y - 1; y++)
+        {
+            for (int32_t x = mapSize.x / 2; x < mapSize.x - 1; x++)
+            {
+                const auto coords = TileCoordsXY(x, y).ToCoordsXY();
+                const CoordsXYZD loc = { coords, TileElementHeight(coords), 0 };
+                SmallSceneryPlaceAction action(loc, 0, entryIndex, 0, 0, 0);
+                if (GameActions::QueryNested(&action).Error != GameActions::Status::Ok)
+                    continue;
+                return GameActions::ExecuteNested(&action).Error == GameActions::Status::Ok;
+            }
+        }
+        return false;
+    }
+
+    std::unique_ptr<IContext> _context;
+};
+
+TEST_F(PaintCacheTest, retained_paint_matches_fresh_paint)
+{
+    ExpectRetainedMatchesFresh("after loading the park");
+
+    // Animated tiles are painted anew every frame, while the ticks change nothing else.
+    const auto animatedEntry = FindAnimatedSmallScenery();
+    ASSERT_TRUE(animatedEntry.has_value());
+    ASSERT_TRUE(PlaceSmallScenery(*animatedEntry));
+    ExpectRetainedMatchesFresh("after placing animated scenery");
+    for (int32_t i = 0; i < 8; i++)
+    {
+        getGameState().currentTicks++;
+        ExpectRetainedMatchesFresh("after the ticks advanced");
+    }
+
+    // Ride colours are not part of the tile elements.
+    auto rideManager = GetRideManager();
+    ASSERT_NE(rideManager.begin(), rideManager.end());
+    auto& ride = *rideManager.begin();
+    const auto colour = static_cast<uint16_t>((ride.trackColours[0].main + 1) % COLOUR_COUNT);
+    RideSetAppearanceAction action(ride.id, RideSetAppearanceType::TrackColourMain, colour, 0);
+    ASSERT_EQ(GameActions::ExecuteNested(&action).Error, GameActions::Status::Ok);
+    ExpectRetainedMatchesFresh("after changing the colour of a ride");
+
+    // Loading new tile elements keeps them equal, only their addresses change.
+    auto tileElements = GetTileElements();
+    SetTileElements(getGameState(), std::move(tileElements));
+    ExpectRetainedMatchesFresh("after setting the tile elements");
+
+    auto& general = Config::Get().general;
+    const bool landscapeSmoothing = general.LandscapeSmoothing;
+    general.LandscapeSmoothing = !landscapeSmoothing;
+    ExpectRetainedMatchesFresh("after toggling landscape smoothing");
+    general.LandscapeSmoothing = landscapeSmoothing;
+    ExpectRetainedMatchesFresh("after restoring landscape smoothing");
+}
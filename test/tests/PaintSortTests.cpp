@@ -0,0 +1,115 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2025 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include <algorithm>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <memory>
+#include <openrct2/config/Config.h>
+#include <openrct2/paint/Paint.h>
+#include <random>
+#include <vector>
+
+using namespace OpenRCT2;
+
+class PaintSortTest : public testing::TestWithParam<bool>
+{
+protected:
+    void TearDown() override
+    {
+        Config::Get().general.BoundedPaintSort = false;
+        gPaintStableSort = false;
+    }
+
+    /**
+     * Creates paint structs spread over a few neighbouring quadrants, with enough structs per quadrant for the bounded
+     * sort to be used. Bounds are picked from a few values only, so many structs overlap or have equal bounds.
+     */
+    static std::vector<PaintStruct> CreatePaintStructs(std::mt19937& rng)
+    {
+        constexpr uint16_t kFirstQuadrant = 40;
+        constexpr uint16_t kNumQuadrants = 4;
+        constexpr size_t kNumPaintStructs = 1600;
+
+        std::uniform_int_distribution<uint16_t> quadrantDist(kFirstQuadrant, kFirstQuadrant + kNumQuadrants - 1);
+        std::uniform_int_distribution<int32_t> posDist(0, 7);
+        std::uniform_int_distribution<int32_t> sizeDist(0, 3);
+
+        std::vector<PaintStruct> paintStructs(kNumPaintStructs);
+        for (auto& ps : paintStructs)
+        {
+            ps.QuadrantIndex = quadrantDist(rng);
+            ps.Bounds.x = posDist(rng) * 8;
+            ps.Bounds.y = posDist(rng) * 8;
+            ps.Bounds.z = posDist(rng) * 8;
+            ps.Bounds.x_end = ps.Bounds.x + sizeDist(rng) * 8;
+            ps.Bounds.y_end = ps.Bounds.y + sizeDist(rng) * 8;
+            ps.Bounds.z_end = ps.Bounds.z + sizeDist(rng) * 8;
+        }
+
+        // Exact duplicates, sorting must keep them in the same relative order either way.
+        for (size_t i = 0; i < kNumPaintStructs / 10; i++)
+        {
+            const auto quadrantIndex = paintStructs[i * 2 + 1].QuadrantIndex;
+            paintStructs[i * 2 + 1] = paintStructs[i * 2];
+            paintStructs[i * 2 + 1].QuadrantIndex = quadrantIndex;
+        }
+        return paintStructs;
+    }
+
+    // Arranges a copy of the paint structs and returns their indices in the resulting order.
+    static std::vector<size_t> Arrange(const std::vector<PaintStruct>& templates, uint8_t rotation, bool boundedSort)
+    {
+        Config::Get().general.BoundedPaintSort = boundedSort;
+
+        auto paintStructs = templates;
+        auto session = std::make_unique<PaintSessionCore>();
+        session->QuadrantBackIndex = UINT32_MAX;
+        session->QuadrantFrontIndex = 0;
+        session->CurrentRotation = rotation;
+        for (auto& ps : paintStructs)
+        {
+            ps.NextQuadrantEntry = session->Quadrants[ps.QuadrantIndex];
+            session->Quadrants[ps.QuadrantIndex] = &ps;
+            session->QuadrantBackIndex = std::min<uint32_t>(session->QuadrantBackIndex, ps.QuadrantIndex);
+            session->QuadrantFrontIndex = std::max<uint32_t>(session->QuadrantFrontIndex, ps.QuadrantIndex);
+        }
+
+        PaintSessionArrange(*session);
+
+        std::vector<size_t> order;
+        for (auto* ps = session->PaintHead; ps != nullptr; ps = ps->NextQuadrantEntry)
+        {
+            order.push_back(ps - paintStructs.data());
+        }
+        return order;
+    }
+};
+
+TEST_P(PaintSortTest, bounded_sort_matches_unbounded)
+{
+    gPaintStableSort = GetParam();
+
+    std::mt19937 rng(1234);
+    for (int32_t iteration = 0; iteration < 8; iteration++)
+    {
+        const auto paintStructs = CreatePaintStructs(rng);
+        for (uint8_t rotation = 0; rotation < 4; rotation++)
+        {
+            const auto expected = Arrange(paintStructs, rotation, false);
+            ASSERT_EQ(expected.size(), paintStructs.size());
+            EXPECT_EQ(expected, Arrange(paintStructs, rotation, true))
+                << "iteration " << iteration << ", rotation " << static_cast<int32_t>(rotation);
+        }
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    PaintSort, PaintSortTest, testing::Bool(),
+    [](const testing::TestParamInfo<bool>& paramInfo) { return paramInfo.param ? "stable" : "legacy"; });
@@ -1,13 +1,19 @@
 #include "TestData.h"
 
+#include <bit>
 #include <gtest/gtest.h>
 #include <memory>
 #include <openrct2/Context.h>
 #include <openrct2/Game.h>
+#include <openrct2/GameState.h>
 #include <openrct2/OpenRCT2.h>
 #include <openrct2/ParkImporter.h>
+#include <openrct2/actions/FootpathPlaceAction.h>
+#include <openrct2/actions/FootpathRemoveAction.h>
+#include <openrct2/config/Config.h>
 #include <openrct2/core/String.hpp>
 #include <openrct2/core/StringReader.h>
+#include <openrct2/entity/EntityList.h>
 #include <openrct2/entity/Guest.h>
 #include <openrct2/peep/GuestPathfinding.h>
 #include <openrct2/platform/Platform.h>
@@ -15,10 +21,17 @@
 #include <openrct2/ride/Station.h>
 #include <openrct2/scenario/Scenario.h>
 #include <openrct2/world/Footpath.h>
+#include <openrct2/world/FootpathGraph.h>
 #include <openrct2/world/Map.h>
+#include <openrct2/world/Park.h>
+#include <openrct2/world/TileElementsView.h>
+#include <openrct2/world/tile_element/PathElement.h>
 #include <openrct2/world/tile_element/SurfaceElement.h>
+#include <optional>
 #include <ostream>
 #include <string>
+#include <utility>
+#include <vector>
 
 using namespace OpenRCT2;
 
@@ -253,3 +266,170 @@ INSTANTIATE_TEST_SUITE_P(
         SimplePathfindingScenario("PathWithFences", { 11, 6, 14 }, 10000),
         SimplePathfindingScenario("PathWithCliff", { 7, 17, 14 }, 10000)),
     SimplePathfindingScenario::ToName);
+
+class FootpathGraphTest : public PathfindingTestBase
+{
+protected:
+    // Compares the graph as updated for the last change with one built from scratch.
+    static void ExpectGraphMatchesRebuild(const char* change)
+    {
+        const auto updated = FootpathGraph::Dump();
+        FootpathGraph::InvalidateAll();
+        EXPECT_EQ(updated, FootpathGraph::Dump()) << "after " << change;
+    }
+};
+
+TEST_F(FootpathGraphTest, UpdatedGraphMatchesRebuild)
+{
+    auto& gameState = getGameState();
+    gameState.cheats.sandboxMode = true;
+    gameState.park.Flags |= PARK_FLAGS_NO_MONEY;
+
+    // A flat path in the middle of a run, so removing and placing it again also changes the edges of its neighbours.
+    std::optional<CoordsXYZ> pathLoc;
+    ObjectEntryIndex type{};
+    ObjectEntryIndex railingsType{};
+    PathConstructFlags constructFlags{};
+    for (int32_t y = 1; y < gameState.mapSize.y - 1 && !pathLoc.has_value(); y++)
+    {
+        for (int32_t x = 1; x < gameState.mapSize.x - 1 && !pathLoc.has_value(); x++)
+        {
+            for (auto* pathElement : TileElementsView<PathElement>(TileCoordsXY{ x, y }))
+            {
+                if (pathElement->IsGhost() || pathElement->IsSloped() || pathElement->IsQueue()
+                    || std::popcount(pathElement->GetEdges()) != 2)
+                    continue;
+
+                pathLoc = CoordsXYZ{ TileCoordsXY{ x, y }.ToCoordsXY(), pathElement->GetBaseZ() };
+                if (pathElement->HasLegacyPathEntry())
+                {
+                    type = pathElement->GetLegacyPathEntryIndex();
+                    constructFlags = PathConstructFlag::IsLegacyPathObject;
+                }
+                else
+                {
+                    type = pathElement->GetSurfaceEntryIndex();
+                    railingsType = pathElement->GetRailingsEntryIndex();
+                }
+                break;
+            }
+        }
+    }
+    ASSERT_TRUE(pathLoc.has_value());
+
+    // Build the graph first, so the changes below update it rather than build it.
+    ASSERT_FALSE(FootpathGraph::Dump().empty());
+
+    auto removeAction = FootpathRemoveAction(*pathLoc);
+    ASSERT_EQ(GameActions::ExecuteNested(&removeAction).Error, GameActions::Status::Ok);
+    ExpectGraphMatchesRebuild("removing a path");
+
+    auto placeAction = FootpathPlaceAction(*pathLoc, 0, type, railingsType, kInvalidDirection, constructFlags);
+    ASSERT_EQ(GameActions::ExecuteNested(&placeAction).Error, GameActions::Status::Ok);
+    ExpectGraphMatchesRebuild("placing the path again");
+
+    // A new path next to it connects to it by changing its edges in place.
+    bool placedNextToIt = false;
+    for (Direction direction = 0; direction < kNumOrthogonalDirections && !placedNextToIt; direction++)
+    {
+        const auto loc = CoordsXYZ{ CoordsXY{ *pathLoc } + CoordsDirectionDelta[direction], pathLoc->z };
+        if (MapGetFootpathElement(loc) != nullptr)
+            continue;
+
+        auto placeNextAction = FootpathPlaceAction(loc, 0, type, railingsType, kInvalidDirection, constructFlags);
+        if (GameActions::QueryNested(&placeNextAction).Error != GameActions::Status::Ok)
+            continue;
+
+        ASSERT_EQ(GameActions::ExecuteNested(&placeNextAction).Error, GameActions::Status::Ok);
+        ExpectGraphMatchesRebuild("placing a path next to it");
+        placedNextToIt = true;
+    }
+    EXPECT_TRUE(placedNextToIt);
+}
+
+struct GuestPathfindingState
+{
+    EntityId id;
+    CoordsXYZ position;
+    CoordsXY destination;
+    CoordsXYZ nextLoc;
+    uint8_t direction;
+    RideId headingToRideId;
+
+    bool operator==(const GuestPathfindingState&) const = default;
+};
+
+static std::ostream& operator<<(std::ostream& os, const GuestPathfindingState& state)
+{
+    return os << "guest " << state.id.ToUnderlying() << " at (" << state.position.x << ", " << state.position.y << ", "
+              << state.position.z << ") heading to (" << state.destination.x << ", " << state.destination.y << ")";
+}
+
+class SpeculativePathfindingTest : public testing::Test
+{
+protected:
+    static constexpr int32_t kTicksToRun = 1000;
+
+    void SetUp() override
+    {
+        _multiThreading = Config::Get().general.MultiThreading;
+    }
+
+    void TearDown() override
+    {
+        Config::Get().general.MultiThreading = _multiThreading;
+    }
+
+    // Runs the park for a while with or without the speculative searches and returns the guests and random state after.
+    static std::pair<std::vector<GuestPathfindingState>, random_engine_t::state_type> RunPark(
+        bool multiThreading, size_t& numSpeculativeSearchesUsed)
+    {
+        gOpenRCT2Headless = true;
+        gOpenRCT2NoGraphics = true;
+        Config::Get().general.MultiThreading = multiThreading;
+
+        auto context = CreateContext();
+        EXPECT_TRUE(context->Initialise());
+        context->LoadParkFromFile(TestData::GetParkPath("bpb.sv6"));
+        GameLoadInit();
+        ScenarioRandSeed(0x12345678, 0x87654321);
+
+        const auto searchesUsedBefore = PathFinding::GetNumSpeculativeSearchesUsed();
+        for (int32_t i = 0; i < kTicksToRun; i++)
+        {
+            gameStateUpdateLogic();
+        }
+        numSpeculativeSearchesUsed = PathFinding::GetNumSpeculativeSearchesUsed() - searchesUsedBefore;
+
+        std::vector<GuestPathfindingState> guests;
+        for (auto* guest : EntityList<Guest>())
+        {
+            guests.push_back({ guest->Id, guest->GetLocation(), guest->GetDestination(), guest->NextLoc,
+                               guest->PeepDirection, guest->GuestHeadingToRideId });
+        }
+        return { std::move(guests), ScenarioRandState() };
+    }
+
+private:
+    bool _multiThreading = false;
+};
+
+TEST_F(SpeculativePathfindingTest, SameOutcomeWithAndWithoutSpeculativeSearches)
+{
+    size_t searchesUsedWithout = 0;
+    const auto [guestsWithout, randStateWithout] = RunPark(false, searchesUsedWithout);
+    size_t searchesUsedWith = 0;
+    const auto [guestsWith, randStateWith] = RunPark(true, searchesUsedWith);
+
+    EXPECT_EQ(searchesUsedWithout, 0u);
+    // Otherwise the park no longer exercises the speculative searches and the comparison proves nothing.
+    ASSERT_GT(searchesUsedWith, 0u);
+
+    ASSERT_EQ(guestsWith.size(), guestsWithout.size());
+    for (size_t i = 0; i < guestsWith.size(); i++)
+    {
+        ASSERT_EQ(guestsWith[i], guestsWithout[i]);
+    }
+    EXPECT_EQ(randStateWith.s0, randStateWithout.s0);
+    EXPECT_EQ(randStateWith.s1, randStateWithout.s1);
+}
@@ -0,0 +1,89 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2025 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include <atomic>
+#include <gtest/gtest.h>
+#include <openrct2/core/TaskScheduler.h>
+#include <thread>
+#include <vector>
+
+using namespace OpenRCT2;
+
+TEST(TaskSchedulerTest, parallel_for_visits_every_index_once)
+{
+    TaskScheduler scheduler(3);
+
+    std::vector<std::atomic<int32_t>> visits(10000);
+    scheduler.ParallelFor(0, visits.size(), 7, [&visits](size_t i) { visits[i].fetch_add(1); });
+
+    for (size_t i = 0; i < visits.size(); i++)
+    {
+        ASSERT_EQ(visits[i].load(), 1) << "index " << i;
+    }
+}
+
+TEST(TaskSchedulerTest, nested_groups_complete)
+{
+    TaskScheduler scheduler(2);
+
+    std::atomic<int32_t> count{ 0 };
+    TaskGroup outer(scheduler);
+    for (int32_t i = 0; i < 16; i++)
+    {
+        outer.Run([&scheduler, &count]() {
+            TaskGroup inner(scheduler);
+            for (int32_t j = 0; j < 16; j++)
+            {
+                inner.Run([&count]() { count.fetch_add(1); });
+            }
+            inner.Wait();
+        });
+    }
+    outer.Wait();
+
+    EXPECT_EQ(count.load(), 16 * 16);
+}
+
+TEST(TaskSchedulerTest, wait_only_runs_tasks_of_own_group)
+{
+    TaskScheduler scheduler(1);
+    const auto waitingThread = std::this_thread::get_id();
+
+    // Keep the only worker busy, so queued tasks can only be run by the waiting thread.
+    std::atomic<bool> workerBusy{ false };
+    std::atomic<bool> releaseWorker{ false };
+    TaskGroup blocker(scheduler);
+    blocker.Run([&]() {
+        workerBusy = true;
+        while (!releaseWorker)
+            std::this_thread::yield();
+    });
+    while (!workerBusy)
+        std::this_thread::yield();
+
+    std::atomic<bool> otherRanOnWaitingThread{ false };
+    TaskGroup other(scheduler);
+    other.Run([&]() { otherRanOnWaitingThread = std::this_thread::get_id() == waitingThread; });
+
+    std::atomic<int32_t> ownCount{ 0 };
+    TaskGroup own(scheduler);
+    for (int32_t i = 0; i < 4; i++)
+    {
+        own.Run([&ownCount]() { ownCount.fetch_add(1); });
+    }
+    own.Wait();
+
+    EXPECT_EQ(ownCount.load(), 4);
+    EXPECT_TRUE(other.IsBusy());
+    EXPECT_FALSE(otherRanOnWaitingThread.load());
+
+    releaseWorker = true;
+    blocker.Wait();
+    other.Wait();
+}
@@ -0,0 +1,238 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2025 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "TestData.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <memory>
+#include <openrct2/Context.h>
+#include <openrct2/Game.h>
+#include <openrct2/GameState.h>
+#include <openrct2/OpenRCT2.h>
+#include <openrct2/actions/GameAction.h>
+#include <openrct2/actions/LandSetHeightAction.h>
+#include <openrct2/drawing/NewDrawing.h>
+#include <openrct2/interface/Viewport.h>
+#include <openrct2/paint/Paint.h>
+#include <openrct2/world/Map.h>
+#include <openrct2/world/Park.h>
+#include <openrct2/world/TileHeightMap.h>
+#include <openrct2/world/tile_element/SurfaceElement.h>
+#include <optional>
+#include <string>
+#include <vector>
+
+using namespace OpenRCT2;
+
+class TileHeightMapTest : public testing::Test
+{
+protected:
+    static void SetUpTestCase()
+    {
+        gOpenRCT2Headless = true;
+        gOpenRCT2NoGraphics = true;
+        _context = CreateContext();
+        const bool initialised = _context->Initialise();
+        ASSERT_TRUE(initialised);
+
+        std::string parkPath = TestData::GetParkPath("tile-element-tests.sv6");
+        GetContext()->LoadParkFromFile(parkPath);
+        GameLoadInit();
+
+        auto& gameState = getGameState();
+        gameState.cheats.sandboxMode = true;
+        gameState.park.Flags |= PARK_FLAGS_NO_MONEY;
+    }
+
+    static void TearDownTestCase()
+    {
+        _context = nullptr;
+    }
+
+    // Measures the tile the way the height map is documented to, from its elements.
+    static int32_t MeasureTile(const TileCoordsXY& coords)
+    {
+        int32_t maxZ = 0;
+        const auto* element = MapGetFirstElementAt(coords);
+        do
+        {
+            maxZ = std::max(maxZ, element->GetClearanceZ());
+            if (const auto* surface = element->AsSurface(); surface != nullptr)
+                maxZ = std::max(maxZ, surface->GetWaterHeight());
+        } while (!(element++)->IsLastForTile());
+        return maxZ;
+    }
+
+    // Finds a tile holding nothing but dry land, which can be raised on its own.
+    static std::optional<TileCoordsXY> FindBareTile(uint8_t raiseBy)
+    {
+        const auto& mapSize = getGameState().mapSize;
+        for (int32_t y = 1; y < mapSize.y - 1; y++)
+        {
+            for (int32_t x = 1; x < mapSize.x - 1; x++)
+            {
+                const TileCoordsXY coords{ x, y };
+                const auto* surface = MapGetSurfaceElementAt(coords);
+                if (surface == nullptr || !surface->IsLastForTile() || surface->GetWaterHeight() != 0)
+                    continue;
+
+                LandSetHeightAction action(coords.ToCoordsXY(), surface->BaseHeight + raiseBy, surface->GetSlope());
+                if (GameActions::QueryNested(&action).Error == GameActions::Status::Ok)
+                    return coords;
+            }
+        }
+        return std::nullopt;
+    }
+
+    static std::unique_ptr<IContext> _context;
+};
+
+std::unique_ptr<IContext> TileHeightMapTest::_context;
+
+TEST_F(TileHeightMapTest, heights_follow_game_actions)
+{
+    constexpr uint8_t kRaiseBy = 10;
+    const auto coords = FindBareTile(kRaiseBy);
+    ASSERT_TRUE(coords.has_value());
+
+    const auto* surface = MapGetSurfaceElementAt(*coords);
+    const auto baseHeight = surface->BaseHeight;
+    const auto slope = surface->GetSlope();
+
+    // Measure before changing anything, so the test fails if the block is not measured again.
+    const auto tileMaxZ = TileHeightMap::GetTileMaxZ(*coords);
+    const auto blockMaxZ = TileHeightMap::GetBlockMaxZ(*coords);
+    EXPECT_EQ(tileMaxZ, MeasureTile(*coords));
+    EXPECT_GE(blockMaxZ, tileMaxZ);
+
+    LandSetHeightAction raise(coords->ToCoordsXY(), baseHeight + kRaiseBy, slope);
+    ASSERT_EQ(GameActions::ExecuteNested(&raise).Error, GameActions::Status::Ok);
+    const auto raisedMaxZ = TileHeightMap::GetTileMaxZ(*coords);
+    EXPECT_EQ(raisedMaxZ, MeasureTile(*coords));
+    EXPECT_GT(raisedMaxZ, tileMaxZ);
+    EXPECT_EQ(TileHeightMap::GetBlockMaxZ(*coords), std::max(blockMaxZ, raisedMaxZ));
+
+    LandSetHeightAction lower(coords->ToCoordsXY(), baseHeight, slope);
+    ASSERT_EQ(GameActions::ExecuteNested(&lower).Error, GameActions::Status::Ok);
+    EXPECT_EQ(TileHeightMap::GetTileMaxZ(*coords), tileMaxZ);
+    EXPECT_EQ(TileHeightMap::GetBlockMaxZ(*coords), blockMaxZ);
+}
+
+class TileHeightCullingTest : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        // Painting needs the sprites of the base game.
+        gOpenRCT2Headless = true;
+        gOpenRCT2NoGraphics = false;
+        _context = CreateContext();
+        if (!_context->Initialise())
+        {
+            _context = nullptr;
+            GTEST_SKIP() << "The RCT2 graphics are not available";
+        }
+        DrawingEngineInit();
+
+        std::string parkPath = TestData::GetParkPath("bpb.sv6");
+        ASSERT_TRUE(_context->LoadParkFromFile(parkPath));
+        GameLoadInit();
+    }
+
+    void TearDown() override
+    {
+        if (_context != nullptr)
+        {
+            DrawingEngineDispose();
+            _context = nullptr;
+        }
+        gOpenRCT2NoGraphics = true;
+        gPaintCullByHeight = true;
+    }
+
+    struct PaintedStruct
+    {
+        ImageId image;
+        ScreenCoordsXY screenPos;
+        CoordsXY mapPos;
+        int32_t x;
+        int32_t y;
+        int32_t z;
+        int32_t xEnd;
+        int32_t yEnd;
+        int32_t zEnd;
+
+        bool operator==(const PaintedStruct& other) const = default;
+    };
+
+    // Generates and arranges a column of the view the way viewports do, and lists the paint structs in drawing order.
+    static std::vector<PaintedStruct> PaintColumn(const ScreenCoordsXY& position, uint8_t rotation, bool cullByHeight)
+    {
+        constexpr int32_t kColumnWidth = kCoordsXYStep;
+        constexpr int32_t kColumnHeight = 256;
+
+        gPaintCullByHeight = cullByHeight;
+
+        std::vector<uint8_t> pixels(kColumnWidth * kColumnHeight);
+        RenderTarget rt;
+        rt.bits = pixels.data();
+        rt.x = Numerics::floor2(position.x, kColumnWidth);
+        rt.y = position.y;
+        rt.width = kColumnWidth;
+        rt.height = kColumnHeight;
+        rt.cullingX = rt.x;
+        rt.cullingY = -(1 << 24);
+        rt.cullingWidth = kColumnWidth;
+        rt.cullingHeight = 1 << 25;
+
+        auto* session = PaintSessionAlloc(rt, 0, rotation);
+        PaintSessionGenerate(*session);
+        PaintSessionArrange(*session);
+
+        std::vector<PaintedStruct> painted;
+        for (const auto* ps = session->PaintHead; ps != nullptr; ps = ps->NextQuadrantEntry)
+        {
+            const auto& bounds = ps->Bounds;
+            painted.push_back({ ps->image_id, ps->ScreenPos, ps->MapPos, bounds.x, bounds.y, bounds.z,
+                                bounds.x_end, bounds.y_end, bounds.z_end });
+        }
+        PaintSessionFree(session);
+        return painted;
+    }
+
+    std::unique_ptr<IContext> _context;
+};
+
+TEST_F(TileHeightCullingTest, culled_column_matches_full_column)
+{
+    const auto& mapSize = getGameState().mapSize;
+    const CoordsXY centreXY = { (mapSize.x / 2) * kCoordsXYStep, (mapSize.y / 2) * kCoordsXYStep };
+    const CoordsXYZ centre = { centreXY, TileElementHeight(centreXY) };
+
+    size_t numPainted = 0;
+    for (uint8_t rotation = 0; rotation < kNumOrthogonalDirections; rotation++)
+    {
+        const auto centre2d = Translate3DTo2DWithZ(rotation, centre);
+        // Columns across the middle of the map, painting high above and down to well below the ground.
+        for (int32_t column = -8; column < 8; column++)
+        {
+            for (int32_t row = -4; row <= 4; row++)
+            {
+                const ScreenCoordsXY position = { centre2d.x + column * kCoordsXYStep, centre2d.y + row * 128 };
+                const auto expected = PaintColumn(position, rotation, false);
+                numPainted += expected.size();
+                EXPECT_EQ(expected, PaintColumn(position, rotation, true))
+                    << "rotation " << static_cast<int32_t>(rotation) << ", column " << column << ", row " << row;
+            }
+        }
+    }
+    EXPECT_GT(numPainted, 0u);
+}